@@ -1,3 +1,4 @@
 TEMPLATE = subdirs
 SUBDIRS =   search timelines statusupdate geosearch georeverse \
-            followers userstream pinauthstatusupdate
+            followers userstream pinauthstatusupdate \
+            footprint
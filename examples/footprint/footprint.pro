@@ -0,0 +1,23 @@
+QT       += core network
+QT       -= gui
+
+TARGET = footprint
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+win32:LIBS += ../../lib/QTweetLib.lib
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    main.cpp
+
+symbian: LIBS += -lqtweetlib
+else:unix|win32: LIBS += -L$$OUT_PWD/../../lib/ -lqtweetlib
+
+INCLUDEPATH += $$PWD/../../src
+
+# older libraries, which footprint is compared with, don't have the string table
+exists($$PWD/../../src/qtweetstringtable.h): DEFINES += HAVE_STRINGTABLE
+# data object counters need the library built with CONFIG += data_statistics
+exists($$PWD/../../src/qtweetdatastatistics.h): DEFINES += HAVE_DATA_STATISTICS
+DEPENDPATH += $$PWD/../../lib
@@ -0,0 +1,229 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+// Reports heap bytes kept, heap allocations made and time spent per converted
+// status and per converted user.
+// Run it against two builds of the library to compare memory layouts and converters:
+// it uses only converters of the library before the compact layout, so it can be
+// copied into the older tree and built there unchanged. String table statistics
+// are reported when the library has the string table, allocations, detaches
+// and copies of the data objects when it is built with data statistics.
+//
+// Usage: footprint [count]
+
+#include <QtCore/QCoreApplication>
+#include <QList>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include "qtweetstatus.h"
+#include "qtweetuser.h"
+#include "qtweetconvert.h"
+#ifdef HAVE_STRINGTABLE
+#include "qtweetstringtable.h"
+#endif
+#ifdef HAVE_DATA_STATISTICS
+#include "qtweetdatastatistics.h"
+#endif
+#include "json/qjsondocument.h"
+#include "json/qjsonarray.h"
+#include "json/qjsonobject.h"
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#define HAVE_MALLINFO
+#endif
+
+static const char statusJson[] =
+    "{\"created_at\":\"Wed Sep 01 11:27:25 +0000 2010\","
+    "\"id\":22819398300,"
+    "\"text\":\"Reading about #qt and #twitter with @minimoog77 http://t.co/abcdefg\","
+    "\"source\":\"<a href=\\\"http://example.com\\\" rel=\\\"nofollow\\\">Example client</a>\","
+    "\"in_reply_to_status_id\":null,\"in_reply_to_user_id\":null,\"in_reply_to_screen_name\":null,"
+    "\"favorited\":false,\"place\":null,"
+    "\"entities\":{"
+    "\"hashtags\":[{\"text\":\"qt\",\"indices\":[14,17]},{\"text\":\"twitter\",\"indices\":[22,30]}],"
+    "\"user_mentions\":[{\"screen_name\":\"minimoog77\",\"name\":\"Antonie Jovanoski\",\"id\":18933845,\"indices\":[36,47]}],"
+    "\"urls\":[{\"url\":\"http://t.co/abcdefg\",\"display_url\":\"example.com/article\","
+    "\"expanded_url\":\"http://example.com/article\",\"indices\":[48,67]}]},"
+    "\"user\":%1}";
+
+static const char userJson[] =
+    "{\"id\":18933845,\"name\":\"Antonie Jovanoski\",\"screen_name\":\"minimoog77\","
+    "\"location\":\"Skopje, Macedonia\",\"description\":\"Qt developer\","
+    "\"profile_image_url\":\"http://a0.twimg.com/profile_images/1/avatar_normal.png\","
+    "\"url\":\"http://example.com\",\"protected\":false,\"followers_count\":120,"
+    "\"friends_count\":80,\"created_at\":\"Tue Jan 13 10:00:00 +0000 2009\","
+    "\"favourites_count\":3,\"utc_offset\":3600,\"time_zone\":\"Skopje\","
+    "\"geo_enabled\":true,\"verified\":false,\"statuses_count\":2000,"
+    "\"lang\":\"en\",\"contributors_enabled\":false,\"listed_count\":7}";
+
+// converters allocate from pool threads too, static initializer because
+// malloc runs before constructors of statics
+static QBasicAtomicInt allocations = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+#ifdef HAVE_MALLINFO
+// counts every heap allocation of the process, library included
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+    allocations.ref();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    allocations.ref();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    allocations.ref();
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+static qint64 heapInUse()
+{
+#ifdef HAVE_MALLINFO
+    struct mallinfo info = mallinfo();
+    return static_cast<unsigned int>(info.uordblks);
+#else
+    return -1;
+#endif
+}
+
+static QJsonArray makeArray(const QJsonObject& templateObject, int count, bool isStatus)
+{
+    QJsonArray array;
+
+    for (int i = 0; i < count; ++i) {
+        QJsonObject object = templateObject;
+
+        if (isStatus) {
+            QJsonObject user = object.value("user").toObject();
+            user.insert("id", static_cast<double>(1000 + i));
+            object.insert("user", user);
+            object.insert("id", static_cast<double>(22819398300LL + i));
+        } else {
+            object.insert("id", static_cast<double>(1000 + i));
+        }
+
+        array.append(object);
+    }
+
+    return array;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    int count = 10000;
+
+    if (argc > 1)
+        count = QString(argv[1]).toInt();
+
+    if (count <= 0 || heapInUse() < 0) {
+        out << "usage: footprint [count] (needs glibc mallinfo)" << endl;
+        return 1;
+    }
+
+    QJsonObject userObject = QJsonDocument::fromJson(userJson).object();
+    QJsonObject statusObject = QJsonDocument::fromJson(QString(statusJson).arg(userJson).toUtf8()).object();
+
+    QJsonArray statusArray = makeArray(statusObject, count, true);
+    QJsonArray userArray = makeArray(userObject, count, false);
+
+    QList<QTweetStatus> statuses;
+    statuses.reserve(count);
+
+    QElapsedTimer timer;
+    qint64 before = heapInUse();
+    int allocationsBefore = allocations;
+#ifdef HAVE_DATA_STATISTICS
+    QTweetDataStatistics::reset();
+#endif
+    timer.start();
+
+    for (int i = 0; i < count; ++i)
+        statuses.append(QTweetConvert::jsonObjectToStatus(statusArray.at(i).toObject()));
+
+    qint64 statusNsecs = timer.nsecsElapsed();
+    int statusAllocations = allocations - allocationsBefore;
+    qint64 statusBytes = heapInUse() - before;
+#ifdef HAVE_DATA_STATISTICS
+    int statusDataAllocations = QTweetDataStatistics::allocations();
+    int statusDetaches = QTweetDataStatistics::detaches();
+    int statusRefs = QTweetDataStatistics::refs();
+#endif
+
+    QList<QTweetUser> users;
+    users.reserve(count);
+
+    before = heapInUse();
+    allocationsBefore = allocations;
+#ifdef HAVE_DATA_STATISTICS
+    QTweetDataStatistics::reset();
+#endif
+    timer.restart();
+
+    for (int i = 0; i < count; ++i)
+        users.append(QTweetConvert::jsonObjectToUser(userArray.at(i).toObject()));
+
+    qint64 userNsecs = timer.nsecsElapsed();
+    int userAllocations = allocations - allocationsBefore;
+    qint64 userBytes = heapInUse() - before;
+#ifdef HAVE_DATA_STATISTICS
+    int userDataAllocations = QTweetDataStatistics::allocations();
+    int userDetaches = QTweetDataStatistics::detaches();
+    int userRefs = QTweetDataStatistics::refs();
+#endif
+
+    out << "objects:             " << count << endl;
+    out << "bytes per status:    " << statusBytes / count << " (with embedded user and 4 entities)" << endl;
+    out << "bytes per user:      " << userBytes / count << endl;
+    out << "allocs per status:   " << double(statusAllocations) / count << endl;
+    out << "allocs per user:     " << double(userAllocations) / count << endl;
+    out << "usecs per status:    " << statusNsecs / 1000.0 / count << endl;
+    out << "usecs per user:      " << userNsecs / 1000.0 / count << endl;
+
+#ifdef HAVE_DATA_STATISTICS
+    if (QTweetDataStatistics::isEnabled()) {
+        out << "data per status:     " << double(statusDataAllocations) / count << " allocs, "
+            << double(statusDetaches) / count << " detaches, "
+            << double(statusRefs) / count << " copies" << endl;
+        out << "data per user:       " << double(userDataAllocations) / count << " allocs, "
+            << double(userDetaches) / count << " detaches, "
+            << double(userRefs) / count << " copies" << endl;
+    }
+#endif
+
+#ifdef HAVE_STRINGTABLE
+    QTweetStringTable *strings = QTweetStringTable::instance();
+    out << "interned strings:    " << strings->count() << endl;
+    out << "intern hit rate:     " << (strings->lookups() ? 100.0 * strings->hits() / strings->lookups() : 0.0) << "%" << endl;
+    out << "intern bytes saved:  " << strings->bytesSaved() << endl;
+#endif
+
+    return 0;
+}
@@ -21,12 +21,6 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "oauthtwitter.h"
-#include "qtweethometimeline.h"
-#include "qtweetmentions.h"
-#include "qtweetusertimeline.h"
-#include "qtweetdirectmessages.h"
-#include "qtweetstatus.h"
-#include "qtweetdmstatus.h"
 #include "qtweetuser.h"
 
 MainWindow::MainWindow(QWidget *parent) :
@@ -45,6 +39,8 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(m_oauthTwitter, SIGNAL(authorizeXAuthFinished()), this, SLOT(xauthFinished()));
     connect(m_oauthTwitter, SIGNAL(authorizeXAuthError()), this, SLOT(xauthError()));
 
+    m_client = new QTweetClient(m_oauthTwitter, this);
+
     m_timer = new QTimer(this);
     m_timer->setInterval(60000);
     connect(m_timer, SIGNAL(timeout()), this, SLOT(timerTimeOut()));
@@ -89,133 +85,104 @@ void MainWindow::xauthError()
 
 void MainWindow::timerTimeOut()
 {
-    QTweetHomeTimeline *homeTimeline = new QTweetHomeTimeline(m_oauthTwitter, this);
-    homeTimeline->fetch(m_sinceidHomeTimeline);
-    connect(homeTimeline, SIGNAL(parsedStatuses(QList<QTweetStatus>)),
-            this, SLOT(homeTimelineStatuses(QList<QTweetStatus>)));
-
-    QTweetMentions *mentions = new QTweetMentions(m_oauthTwitter, this);
-    mentions->fetch(m_sinceidMentions);
-    connect(mentions, SIGNAL(parsedStatuses(QList<QTweetStatus>)),
-            this, SLOT(mentionsStatuses(QList<QTweetStatus>)));
-
-    QTweetUserTimeline *userTimeline = new QTweetUserTimeline(m_oauthTwitter, this);
-    userTimeline->fetch(0, QString(), m_sinceidUserTimeline);
-    connect(userTimeline, SIGNAL(parsedStatuses(QList<QTweetStatus>)),
-            this, SLOT(userTimelineStatuses(QList<QTweetStatus>)));
-
-    QTweetDirectMessages *dmTimeline = new QTweetDirectMessages(m_oauthTwitter, this);
-    dmTimeline->fetch(m_sinceidDirectMessages);
-    connect(dmTimeline, SIGNAL(parsedDirectMessages(QList<QTweetDMStatus>)),
-            this, SLOT(directMessages(QList<QTweetDMStatus>)));
+    // client is child of this window, so calls can't outlive continuations
+    m_client->homeTimeline(m_sinceidHomeTimeline).then(this, &MainWindow::homeTimelineStatuses);
+    m_client->mentions(m_sinceidMentions).then(this, &MainWindow::mentionsStatuses);
+    m_client->userTimeline(0, QString(), m_sinceidUserTimeline).then(this, &MainWindow::userTimelineStatuses);
+    m_client->directMessages(m_sinceidDirectMessages).then(this, &MainWindow::directMessages);
 }
 
-void MainWindow::homeTimelineStatuses(const QList<QTweetStatus> &statuses)
+void MainWindow::homeTimelineStatuses(const QTweetFuture<QList<QTweetStatus> > &future)
 {
-    QTweetHomeTimeline *homeTimeline = qobject_cast<QTweetHomeTimeline*>(sender());
-
-    if (homeTimeline) {
-        if (statuses.count()) {
-            //order is messed up, but this is just example
-            foreach (const QTweetStatus& status, statuses) {
-                ui->homeTimelineTextEdit->append("id: " + QString::number(status.id()));
-                ui->homeTimelineTextEdit->append("text: " + status.text());
-                ui->homeTimelineTextEdit->append("created: " + status.createdAt().toString());
+    QList<QTweetStatus> statuses = future.result();
 
-                QTweetUser userinfo = status.user();
+    if (statuses.count()) {
+        //order is messed up, but this is just example
+        foreach (const QTweetStatus& status, statuses) {
+            ui->homeTimelineTextEdit->append("id: " + QString::number(status.id()));
+            ui->homeTimelineTextEdit->append("text: " + status.text());
+            ui->homeTimelineTextEdit->append("created: " + status.createdAt().toString());
 
-                ui->homeTimelineTextEdit->append("screen name: " + userinfo.screenName());
-                ui->homeTimelineTextEdit->append("user id: " + QString::number(userinfo.id()));
+            QTweetUser userinfo = status.user();
 
-                //is it retweet?
-                QTweetStatus rtStatus = status.retweetedStatus();
+            ui->homeTimelineTextEdit->append("screen name: " + userinfo.screenName());
+            ui->homeTimelineTextEdit->append("user id: " + QString::number(userinfo.id()));
 
-                if (rtStatus.id()) {
-                    ui->homeTimelineTextEdit->append("retweet text: " + rtStatus.text());
-                }
-
-                ui->homeTimelineTextEdit->append("----------------------------------------");
+            //is it retweet?
+            QTweetStatus rtStatus = status.retweetedStatus();
 
+            if (rtStatus.id()) {
+                ui->homeTimelineTextEdit->append("retweet text: " + rtStatus.text());
             }
 
-            m_sinceidHomeTimeline = statuses.at(0).id();
+            ui->homeTimelineTextEdit->append("----------------------------------------");
+
         }
 
-        homeTimeline->deleteLater();
+        m_sinceidHomeTimeline = statuses.at(0).id();
     }
 }
 
-void MainWindow::mentionsStatuses(const QList<QTweetStatus> &statuses)
+void MainWindow::mentionsStatuses(const QTweetFuture<QList<QTweetStatus> > &future)
 {
-    QTweetMentions *mentions = qobject_cast<QTweetMentions*>(sender());
+    QList<QTweetStatus> statuses = future.result();
 
-    if (mentions) {
-        if (statuses.count()) {
-            foreach (const QTweetStatus& status, statuses) {
-                ui->mentionsTextEdit->append("id: " + QString::number(status.id()));
-                ui->mentionsTextEdit->append("text: " + status.text());
-                ui->mentionsTextEdit->append("created: " + status.createdAt().toString());
+    if (statuses.count()) {
+        foreach (const QTweetStatus& status, statuses) {
+            ui->mentionsTextEdit->append("id: " + QString::number(status.id()));
+            ui->mentionsTextEdit->append("text: " + status.text());
+            ui->mentionsTextEdit->append("created: " + status.createdAt().toString());
 
-                QTweetUser userinfo = status.user();
+            QTweetUser userinfo = status.user();
 
-                ui->mentionsTextEdit->append("screen name: " + userinfo.screenName());
-                ui->mentionsTextEdit->append("user id: " + QString::number(userinfo.id()));
+            ui->mentionsTextEdit->append("screen name: " + userinfo.screenName());
+            ui->mentionsTextEdit->append("user id: " + QString::number(userinfo.id()));
 
-                ui->mentionsTextEdit->append("----------------------------------------");
-            }
-
-            m_sinceidMentions = statuses.at(0).id();
+            ui->mentionsTextEdit->append("----------------------------------------");
         }
-        mentions->deleteLater();
+
+        m_sinceidMentions = statuses.at(0).id();
     }
 }
 
-void MainWindow::userTimelineStatuses(const QList<QTweetStatus> &statuses)
+void MainWindow::userTimelineStatuses(const QTweetFuture<QList<QTweetStatus> > &future)
 {
-    QTweetUserTimeline *userTimeline = qobject_cast<QTweetUserTimeline*>(sender());
+    QList<QTweetStatus> statuses = future.result();
 
-    if (userTimeline) {
-        if (statuses.count()) {
-            //order is messed up, but this is just example
-            foreach (const QTweetStatus& status, statuses) {
-                ui->userTimelineTextEdit->append("id: " + QString::number(status.id()));
-                ui->userTimelineTextEdit->append("text: " + status.text());
-                ui->userTimelineTextEdit->append("created: " + status.createdAt().toString());
+    if (statuses.count()) {
+        //order is messed up, but this is just example
+        foreach (const QTweetStatus& status, statuses) {
+            ui->userTimelineTextEdit->append("id: " + QString::number(status.id()));
+            ui->userTimelineTextEdit->append("text: " + status.text());
+            ui->userTimelineTextEdit->append("created: " + status.createdAt().toString());
 
-                QTweetUser userinfo = status.user();
+            QTweetUser userinfo = status.user();
 
-                ui->userTimelineTextEdit->append("screen name: " + userinfo.screenName());
-                ui->userTimelineTextEdit->append("user id: " + QString::number(userinfo.id()));
+            ui->userTimelineTextEdit->append("screen name: " + userinfo.screenName());
+            ui->userTimelineTextEdit->append("user id: " + QString::number(userinfo.id()));
 
-                ui->userTimelineTextEdit->append("----------------------------------------");
-            }
-
-            m_sinceidUserTimeline = statuses.at(0).id();
+            ui->userTimelineTextEdit->append("----------------------------------------");
         }
 
-        userTimeline->deleteLater();
+        m_sinceidUserTimeline = statuses.at(0).id();
     }
 }
 
-void MainWindow::directMessages(const QList<QTweetDMStatus> &directMessages)
+void MainWindow::directMessages(const QTweetFuture<QList<QTweetDMStatus> > &future)
 {
-    QTweetDirectMessages *dmTimeline = qobject_cast<QTweetDirectMessages*>(sender());
-
-    if (dmTimeline) {
-        if (directMessages.count()) {
-            foreach (const QTweetDMStatus& message, directMessages) {
-                ui->directMessagesTextEdit->append("id: " + QString::number(message.id()));
-                ui->directMessagesTextEdit->append("text: " + message.text());
-                ui->directMessagesTextEdit->append("created: " + message.createdAt().toString());
-                ui->directMessagesTextEdit->append("sender: " + message.senderScreenName());
-                ui->directMessagesTextEdit->append("sender id: " + QString::number(message.senderId()));
-
-                ui->directMessagesTextEdit->append("----------------------------------------");
-            }
+    QList<QTweetDMStatus> directMessages = future.result();
 
-            m_sinceidDirectMessages = directMessages.at(0).id();
+    if (directMessages.count()) {
+        foreach (const QTweetDMStatus& message, directMessages) {
+            ui->directMessagesTextEdit->append("id: " + QString::number(message.id()));
+            ui->directMessagesTextEdit->append("text: " + message.text());
+            ui->directMessagesTextEdit->append("created: " + message.createdAt().toString());
+            ui->directMessagesTextEdit->append("sender: " + message.senderScreenName());
+            ui->directMessagesTextEdit->append("sender id: " + QString::number(message.senderId()));
+
+            ui->directMessagesTextEdit->append("----------------------------------------");
         }
-    }
 
-    dmTimeline->deleteLater();
+        m_sinceidDirectMessages = directMessages.at(0).id();
+    }
 }
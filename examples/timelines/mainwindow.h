@@ -19,6 +19,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include "qtweetclient.h"
 
 namespace Ui {
     class MainWindow;
@@ -26,8 +27,6 @@ namespace Ui {
 
 class OAuthTwitter;
 class QTimer;
-class QTweetStatus;
-class QTweetDMStatus;
 
 class MainWindow : public QMainWindow
 {
@@ -45,14 +44,16 @@ private slots:
     void xauthFinished();
     void xauthError();
     void timerTimeOut();
-    void homeTimelineStatuses(const QList<QTweetStatus>& statuses);
-    void mentionsStatuses(const QList<QTweetStatus>& statuses);
-    void userTimelineStatuses(const QList<QTweetStatus>& statuses);
-    void directMessages(const QList<QTweetDMStatus>& directMessages);
 
 private:
+    void homeTimelineStatuses(const QTweetFuture<QList<QTweetStatus> >& future);
+    void mentionsStatuses(const QTweetFuture<QList<QTweetStatus> >& future);
+    void userTimelineStatuses(const QTweetFuture<QList<QTweetStatus> >& future);
+    void directMessages(const QTweetFuture<QList<QTweetDMStatus> >& future);
+
     Ui::MainWindow *ui;
     OAuthTwitter *m_oauthTwitter;
+    QTweetClient *m_client;
     QTimer *m_timer;
     qint64 m_sinceidHomeTimeline;
     qint64 m_sinceidMentions;
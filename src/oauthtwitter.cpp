@@ -23,26 +23,36 @@
 #include <QNetworkAccessManager>
 #include <QEventLoop>
 #include <QDesktopServices>
+#include "qtweetrequestcoalescer.h"
+#include "qtweetrequestscheduler.h"
 
-#define TWITTER_REQUEST_TOKEN_URL "https://twitter.com/oauth/request_token"
-#define TWITTER_ACCESS_TOKEN_URL "https://twitter.com/oauth/access_token"
 #define TWITTER_AUTHORIZE_URL "https://twitter.com/oauth/authorize"
-#define TWITTER_ACCESS_TOKEN_XAUTH_URL "https://api.twitter.com/oauth/access_token"
+
+// All families on https, so REST and OAuth requests share connections to api.twitter.com
+static const char * const defaultBaseUrls[] = {
+    "https://api.twitter.com/1/",
+    "https://api.twitter.com/1.1/",
+    "https://search.twitter.com/",
+    "https://userstream.twitter.com/2/",
+    "https://api.twitter.com/oauth/"
+};
 
 /**
  *   Constructor
  */
 OAuthTwitter::OAuthTwitter(QObject *parent)
-    :	OAuth(parent), m_netManager(0)
+    :	OAuth(parent), m_netManager(0), m_requestCoalescer(0), m_responseCache(0)
 {
+    resetBaseUrls();
 }
 
 /**
  *  Constructor
  */
 OAuthTwitter::OAuthTwitter(QNetworkAccessManager *netManager, QObject *parent) :
-    OAuth(parent), m_netManager(netManager)
+    OAuth(parent), m_netManager(netManager), m_requestCoalescer(0), m_responseCache(0)
 {
+    resetBaseUrls();
 }
 
 /**
@@ -52,8 +62,9 @@ OAuthTwitter::OAuthTwitter(QNetworkAccessManager *netManager, QObject *parent) :
  *  @param parent parent object
  */
 OAuthTwitter::OAuthTwitter(const QByteArray &consumerKey, const QByteArray &consumerSecret, QObject *parent) :
-    OAuth(consumerKey, consumerSecret, parent), m_netManager(0)
+    OAuth(consumerKey, consumerSecret, parent), m_netManager(0), m_requestCoalescer(0), m_responseCache(0)
 {
+    resetBaseUrls();
 }
 
 /**
@@ -73,6 +84,127 @@ QNetworkAccessManager* OAuthTwitter::networkAccessManager() const
 	return m_netManager;
 }
 
+/**
+ *   Sets base url of the endpoint family, e.g. to point the client at a local test server
+ *   @param api endpoint family
+ *   @param url base url, normalized with normalizedBaseUrl()
+ */
+void OAuthTwitter::setBaseUrl(Api api, const QUrl &url)
+{
+    m_baseUrls[api] = normalizedBaseUrl(url);
+}
+
+/**
+ *   Gets base url of the endpoint family
+ */
+QUrl OAuthTwitter::baseUrl(Api api) const
+{
+    return m_baseUrls[api];
+}
+
+/**
+ *   Sets base urls of all endpoint families to twitter defaults
+ */
+void OAuthTwitter::resetBaseUrls()
+{
+    for (int i = RestApi1; i <= OAuthApi; ++i)
+        m_baseUrls[i] = QUrl(defaultBaseUrls[i]);
+}
+
+/**
+ *   Gets url of the endpoint
+ *   @param api endpoint family
+ *   @param path path of the endpoint relative to the family base url, e.g. "statuses/show.json"
+ */
+QUrl OAuthTwitter::apiUrl(Api api, const QString &path) const
+{
+    return m_baseUrls[api].resolved(QUrl(path));
+}
+
+/**
+ *   Normalizes url so equal hosts map to one connection: lower case scheme and host,
+ *   default port removed, path ends with '/'
+ */
+QUrl OAuthTwitter::normalizedBaseUrl(const QUrl &url)
+{
+    QUrl normalized(url);
+
+    normalized.setScheme(url.scheme().toLower());
+    normalized.setHost(url.host().toLower());
+
+    if ((normalized.scheme() == "https" && url.port() == 443) ||
+        (normalized.scheme() == "http" && url.port() == 80))
+        normalized.setPort(-1);
+
+    if (!normalized.path().endsWith('/'))
+        normalized.setPath(normalized.path() + '/');
+
+    return normalized;
+}
+
+/**
+ *   Enables sharing one network request between identical GETs in flight
+ *   @remarks Disabled by default. Applies to endpoints using this object.
+ */
+void OAuthTwitter::setRequestCoalescingEnabled(bool enable)
+{
+    if (enable && !m_requestCoalescer) {
+        m_requestCoalescer = new QTweetRequestCoalescer(this);
+    } else if (!enable && m_requestCoalescer) {
+        // requests in flight are still handed to their endpoints
+        m_requestCoalescer->deleteWhenIdle();
+        m_requestCoalescer = 0;
+    }
+}
+
+bool OAuthTwitter::isRequestCoalescingEnabled() const
+{
+    return m_requestCoalescer != 0;
+}
+
+/**
+ *   Gets request coalescer, 0 if request coalescing is disabled
+ */
+QTweetRequestCoalescer* OAuthTwitter::requestCoalescer() const
+{
+    return m_requestCoalescer;
+}
+
+/**
+ *   Sets cache of GET responses used with conditional requests
+ *   @param cache response cache, not owned. 0 (default) disables caching
+ */
+void OAuthTwitter::setResponseCache(QTweetResponseCache *cache)
+{
+    m_responseCache = cache;
+}
+
+/**
+ *   Gets cache of GET responses
+ */
+QTweetResponseCache* OAuthTwitter::responseCache() const
+{
+    return m_responseCache;
+}
+
+/**
+ *   Sets scheduler deciding when requests of endpoints using this object are sent
+ *   @param scheduler request scheduler, not owned, can be shared with other OAuthTwitter
+ *                    objects. 0 (default) sends requests right away
+ */
+void OAuthTwitter::setRequestScheduler(QTweetRequestScheduler *scheduler)
+{
+    m_requestScheduler = scheduler;
+}
+
+/**
+ *   Gets request scheduler, 0 if there is none
+ */
+QTweetRequestScheduler* OAuthTwitter::requestScheduler() const
+{
+    return m_requestScheduler;
+}
+
 /**
  *   Gets oauth tokens using XAuth method (starts authorization process)
  *   @param username username
@@ -83,7 +215,7 @@ void OAuthTwitter::authorizeXAuth(const QString &username, const QString &passwo
 {
     Q_ASSERT(m_netManager != 0);
 
-    QUrl url(TWITTER_ACCESS_TOKEN_XAUTH_URL);
+    QUrl url = apiUrl(OAuthApi, "access_token");
     url.addEncodedQueryItem("x_auth_username", username.toUtf8().toPercentEncoding());
     url.addEncodedQueryItem("x_auth_password", password.toUtf8().toPercentEncoding());
     url.addQueryItem("x_auth_mode", "client_auth");
@@ -127,7 +259,7 @@ void OAuthTwitter::authorizePin()
 {
     Q_ASSERT(m_netManager != 0);
 
-    QUrl url(TWITTER_REQUEST_TOKEN_URL);
+    QUrl url = apiUrl(OAuthApi, "request_token");
 
     QByteArray oauthHeader = generateAuthorizationHeader(url, OAuth::POST);
 
@@ -187,7 +319,7 @@ void OAuthTwitter::requestAccessToken(const QString& pin)
 {
     Q_ASSERT(m_netManager != 0);
 
-    QUrl url(TWITTER_ACCESS_TOKEN_URL);
+    QUrl url = apiUrl(OAuthApi, "access_token");
     url.addEncodedQueryItem("oauth_verifier", pin.toAscii()); 
 
     QByteArray oauthHeader = generateAuthorizationHeader(url, OAuth::POST);
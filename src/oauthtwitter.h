@@ -18,9 +18,14 @@
 #ifndef OAUTHTWITTER_H
 #define OAUTHTWITTER_H
 
+#include <QUrl>
+#include <QPointer>
 #include "oauth.h"
 
 class QNetworkAccessManager;
+class QTweetRequestCoalescer;
+class QTweetResponseCache;
+class QTweetRequestScheduler;
 
 /**
  *   OAuth Twitter authorization class
@@ -32,12 +37,37 @@ class QTWEETLIBSHARED_EXPORT OAuthTwitter : public OAuth
                READ networkAccessManager
                WRITE setNetworkAccessManager)
 public:
+    /** Endpoint families, each resolved against its own base url */
+    enum Api {
+        RestApi1,       /** https://api.twitter.com/1/ */
+        RestApi11,      /** https://api.twitter.com/1.1/ */
+        SearchApi,      /** https://search.twitter.com/ */
+        UserStreamApi,  /** https://userstream.twitter.com/2/ */
+        OAuthApi        /** https://api.twitter.com/oauth/ */
+    };
+
     OAuthTwitter(QObject *parent = 0);
     OAuthTwitter(QNetworkAccessManager* netManager, QObject *parent = 0);
     OAuthTwitter(const QByteArray& consumerKey, const QByteArray& consumerSecret, QObject *parent = 0);
     void setNetworkAccessManager(QNetworkAccessManager* netManager);
     QNetworkAccessManager* networkAccessManager() const;
 
+    void setBaseUrl(Api api, const QUrl& url);
+    QUrl baseUrl(Api api) const;
+    void resetBaseUrls();
+    QUrl apiUrl(Api api, const QString& path) const;
+    static QUrl normalizedBaseUrl(const QUrl& url);
+
+    void setRequestCoalescingEnabled(bool enable);
+    bool isRequestCoalescingEnabled() const;
+    QTweetRequestCoalescer* requestCoalescer() const;
+
+    void setResponseCache(QTweetResponseCache *cache);
+    QTweetResponseCache* responseCache() const;
+
+    void setRequestScheduler(QTweetRequestScheduler *scheduler);
+    QTweetRequestScheduler* requestScheduler() const;
+
 signals:
     /** Emited when XAuth authorization is finished */
     void authorizeXAuthFinished();
@@ -62,6 +92,10 @@ private slots:
 
 private:
     QNetworkAccessManager *m_netManager;
+    QUrl m_baseUrls[OAuthApi + 1];
+    QTweetRequestCoalescer *m_requestCoalescer;
+    QTweetResponseCache *m_responseCache;
+    QPointer<QTweetRequestScheduler> m_requestScheduler;
 };	
 
 #endif //OAUTHTWITTER_H
@@ -46,7 +46,7 @@ QTweetAccountRateLimitStatus::QTweetAccountRateLimitStatus(OAuthTwitter *oauthTw
  */
 void QTweetAccountRateLimitStatus::check()
 {
-    QUrl url("http://api.twitter.com/1/account/rate_limit_status.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "account/rate_limit_status.json");
 
     QNetworkRequest req(url);
 
@@ -55,8 +55,7 @@ void QTweetAccountRateLimitStatus::check()
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetAccountRateLimitStatus::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -53,7 +53,7 @@ void QTweetAccountVerifyCredentials::verify(bool includeEntities)
         return;
     }
 
-    QUrl url("https://api.twitter.com/1/account/verify_credentials.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "account/verify_credentials.json");
 
     if (includeEntities)
         url.addQueryItem("include_entities", "true");
@@ -63,14 +63,13 @@ void QTweetAccountVerifyCredentials::verify(bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetAccountVerifyCredentials::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedUser(user);
     }
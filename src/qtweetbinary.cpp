@@ -0,0 +1,1126 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QDataStream>
+#include <QSize>
+#include <QtEndian>
+#include <string.h>
+#include "qtweetbinary.h"
+#include "qtweetstatus.h"
+#include "qtweetuser.h"
+#include "qtweetdmstatus.h"
+#include "qtweetplace.h"
+#include "qtweetlist.h"
+#include "qtweetgeoboundingbox.h"
+#include "qtweetentityurl.h"
+#include "qtweetentityhashtag.h"
+#include "qtweetentityusermentions.h"
+#include "qtweetentitymedia.h"
+
+// record types, first byte of the record
+enum {
+    StatusRecord = 1,
+    UserRecord,
+    DirectMessageRecord,
+    PlaceRecord,
+    ListRecord,
+    UrlEntityRecord,
+    HashtagEntityRecord,
+    UserMentionsEntityRecord,
+    MediaEntityRecord
+};
+
+// status flags
+enum {
+    StatusFavorited = 0x1,
+    StatusHasPlace = 0x2,
+    StatusHasRetweet = 0x4
+};
+
+// user flags
+enum {
+    UserContributorsEnabled = 0x1,
+    UserProtected = 0x2,
+    UserGeoEnabled = 0x4,
+    UserVerified = 0x8,
+    UserStatusFavorited = 0x10
+};
+
+// nesting limit for retweets and places when reading
+static const int MaxDepth = 32;
+
+// limits of a record and of back-referenced strings, same for writer and reader
+static const int MaxRecordSize = 64 * 1024 * 1024;
+static const int MaxStrings = 16384;
+
+// record is read in pieces, so bad length fails at the end of the stream
+// before allocating its size
+static const int ReadChunkSize = 64 * 1024;
+
+// Checks if place has any data, place without id is still written
+static bool isEmptyPlace(const QTweetPlace& place)
+{
+    return place.id().isEmpty() && place.name().isEmpty() && place.fullName().isEmpty()
+            && place.country().isEmpty() && place.countryCode().isEmpty()
+            && !place.boundingBox().isValid() && place.containedWithin().isEmpty();
+}
+
+QTweetBinaryWriter::QTweetBinaryWriter(QDataStream &stream) :
+    m_stream(stream)
+{
+    char version = Version;
+    m_stream.writeRawData(&version, 1);
+}
+
+void QTweetBinaryWriter::write(const QTweetStatus &status)
+{
+    beginRecord(StatusRecord);
+    writeStatus(status);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetUser &user)
+{
+    beginRecord(UserRecord);
+    writeUser(user);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetDMStatus &directMessage)
+{
+    beginRecord(DirectMessageRecord);
+    writeDirectMessage(directMessage);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetPlace &place)
+{
+    beginRecord(PlaceRecord);
+    writePlace(place);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetList &list)
+{
+    beginRecord(ListRecord);
+    writeList(list);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetEntityUrl &entity)
+{
+    beginRecord(UrlEntityRecord);
+    writeUrlEntity(entity);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetEntityHashtag &entity)
+{
+    beginRecord(HashtagEntityRecord);
+    writeHashtagEntity(entity);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetEntityUserMentions &entity)
+{
+    beginRecord(UserMentionsEntityRecord);
+    writeUserMentionsEntity(entity);
+    endRecord();
+}
+
+void QTweetBinaryWriter::write(const QTweetEntityMedia &entity)
+{
+    beginRecord(MediaEntityRecord);
+    writeMediaEntity(entity);
+    endRecord();
+}
+
+void QTweetBinaryWriter::beginRecord(int type)
+{
+    m_record.resize(0);
+    m_record.append(static_cast<char>(type));
+}
+
+void QTweetBinaryWriter::endRecord()
+{
+    char length[10];
+    quint64 size = m_record.size();
+    int n = 0;
+
+    do {
+        length[n++] = static_cast<char>((size & 0x7f) | (size > 0x7f ? 0x80 : 0));
+        size >>= 7;
+    } while (size);
+
+    m_stream.writeRawData(length, n);
+    m_stream.writeRawData(m_record.constData(), m_record.size());
+}
+
+void QTweetBinaryWriter::writeUInt(quint64 value)
+{
+    while (value > 0x7f) {
+        m_record.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    m_record.append(static_cast<char>(value));
+}
+
+void QTweetBinaryWriter::writeInt(qint64 value)
+{
+    // zigzag, small negative numbers stay small
+    writeUInt((static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+void QTweetBinaryWriter::writeDouble(double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uchar bytes[8];
+    qToLittleEndian(bits, bytes);
+    m_record.append(reinterpret_cast<const char *>(bytes), 8);
+}
+
+/**
+ *  Writes repeating string, length * 2 and UTF-8 bytes first time, index * 2 + 1 after that
+ */
+void QTweetBinaryWriter::writeString(const QString &string)
+{
+    if (string.isEmpty()) {
+        writeUInt(0);
+        return;
+    }
+
+    QHash<QString, int>::const_iterator it = m_strings.constFind(string);
+
+    if (it != m_strings.constEnd()) {
+        writeUInt(static_cast<quint64>(it.value()) * 2 + 1);
+        return;
+    }
+
+    QByteArray utf8 = string.toUtf8();
+    writeUInt(static_cast<quint64>(utf8.size()) * 2);
+    m_record.append(utf8);
+
+    if (m_strings.size() < MaxStrings)
+        m_strings.insert(string, m_strings.size());
+}
+
+/**
+ *  Writes string which (almost) never repeats, length * 2 and UTF-8 bytes,
+ *  it isn't added to back-referenced strings
+ */
+void QTweetBinaryWriter::writeText(const QString &text)
+{
+    QByteArray utf8 = text.toUtf8();
+    writeUInt(static_cast<quint64>(utf8.size()) * 2);
+    m_record.append(utf8);
+}
+
+void QTweetBinaryWriter::writeStatus(const QTweetStatus &status)
+{
+    QTweetPlace place = status.place();
+    bool hasPlace = !isEmptyPlace(place);
+
+    uint flags = 0;
+
+    if (status.favorited())
+        flags |= StatusFavorited;
+    if (hasPlace)
+        flags |= StatusHasPlace;
+    if (status.isRetweet())
+        flags |= StatusHasRetweet;
+
+    writeInt(status.id());
+    writeUInt(flags);
+    writeInt(status.createdAtEpoch());
+    writeText(status.text());
+    writeInt(status.inReplyToUserId());
+    writeString(status.inReplyToScreenName());
+    writeInt(status.inReplyToStatusId());
+    writeString(status.source());
+    writeUser(status.user());
+
+    if (hasPlace)
+        writePlace(place);
+
+    QList<QTweetEntityUrl> urlEntities = status.urlEntities();
+    writeUInt(urlEntities.size());
+    foreach (const QTweetEntityUrl& entity, urlEntities)
+        writeUrlEntity(entity);
+
+    QList<QTweetEntityHashtag> hashtagEntities = status.hashtagEntities();
+    writeUInt(hashtagEntities.size());
+    foreach (const QTweetEntityHashtag& entity, hashtagEntities)
+        writeHashtagEntity(entity);
+
+    QList<QTweetEntityUserMentions> userMentionsEntities = status.userMentionsEntities();
+    writeUInt(userMentionsEntities.size());
+    foreach (const QTweetEntityUserMentions& entity, userMentionsEntities)
+        writeUserMentionsEntity(entity);
+
+    QList<QTweetEntityMedia> mediaEntities = status.mediaEntities();
+    writeUInt(mediaEntities.size());
+    foreach (const QTweetEntityMedia& entity, mediaEntities)
+        writeMediaEntity(entity);
+
+    if (status.isRetweet())
+        writeStatus(status.retweetedStatus());
+}
+
+void QTweetBinaryWriter::writeUser(const QTweetUser &user)
+{
+    QTweetStatus lastStatus = user.status();
+
+    uint flags = 0;
+
+    if (user.isContributorsEnabled())
+        flags |= UserContributorsEnabled;
+    if (user.isProtected())
+        flags |= UserProtected;
+    if (user.isGeoEnabled())
+        flags |= UserGeoEnabled;
+    if (user.isVerified())
+        flags |= UserVerified;
+    if (lastStatus.favorited())
+        flags |= UserStatusFavorited;
+
+    writeInt(user.id());
+    writeUInt(flags);
+    writeString(user.name());
+    writeString(user.screenName());
+    writeString(user.location());
+    writeText(user.description());
+    writeString(user.profileImageUrl());
+    writeString(user.url());
+    writeString(user.timezone());
+    writeString(user.lang());
+    writeInt(user.createdAtEpoch());
+    writeInt(user.followersCount());
+    writeInt(user.friendsCount());
+    writeInt(user.favouritesCount());
+    writeInt(user.statusesCount());
+    writeInt(user.listedCount());
+    writeInt(user.utcOffset());
+
+    writeInt(lastStatus.id());
+    writeInt(lastStatus.createdAtEpoch());
+    writeText(lastStatus.text());
+    writeInt(lastStatus.inReplyToUserId());
+    writeString(lastStatus.inReplyToScreenName());
+    writeInt(lastStatus.inReplyToStatusId());
+    writeString(lastStatus.source());
+}
+
+void QTweetBinaryWriter::writeDirectMessage(const QTweetDMStatus &directMessage)
+{
+    writeInt(directMessage.id());
+    writeInt(directMessage.createdAtEpoch());
+    writeText(directMessage.text());
+    writeInt(directMessage.senderId());
+    writeString(directMessage.senderScreenName());
+    writeUser(directMessage.sender());
+    writeInt(directMessage.recipientId());
+    writeString(directMessage.recipientScreenName());
+    writeUser(directMessage.recipient());
+}
+
+void QTweetBinaryWriter::writePlace(const QTweetPlace &place)
+{
+    QTweetGeoBoundingBox box = place.boundingBox();
+    bool validBox = box.isValid();
+
+    writeString(place.id());
+    writeUInt((place.type() << 1) | (validBox ? 1 : 0));
+    writeString(place.name());
+    writeString(place.fullName());
+    writeString(place.country());
+    writeString(place.countryCode());
+
+    if (validBox) {
+        QTweetGeoCoord corners[] = { box.topLeft(), box.topRight(), box.bottomRight(), box.bottomLeft() };
+
+        for (int i = 0; i < 4; ++i) {
+            writeDouble(corners[i].latitude());
+            writeDouble(corners[i].longitude());
+        }
+    }
+
+    QList<QTweetPlace> containedWithin = place.containedWithin();
+    writeUInt(containedWithin.size());
+    foreach (const QTweetPlace& parent, containedWithin)
+        writePlace(parent);
+}
+
+void QTweetBinaryWriter::writeList(const QTweetList &list)
+{
+    writeInt(list.id());
+    writeUInt(list.following() ? 1 : 0);
+    writeString(list.name());
+    writeString(list.fullName());
+    writeString(list.slug());
+    writeString(list.mode());
+    writeString(list.description());
+    writeString(list.uri());
+    writeInt(list.memberCount());
+    writeInt(list.subscriberCount());
+    writeUser(list.user());
+}
+
+void QTweetBinaryWriter::writeUrlEntity(const QTweetEntityUrl &entity)
+{
+    writeInt(entity.lowerIndex());
+    writeInt(entity.higherIndex());
+    writeText(entity.url());
+    writeText(entity.displayUrl());
+    writeText(entity.expandedUrl());
+}
+
+void QTweetBinaryWriter::writeHashtagEntity(const QTweetEntityHashtag &entity)
+{
+    writeInt(entity.lowerIndex());
+    writeInt(entity.higherIndex());
+    writeString(entity.text());
+}
+
+void QTweetBinaryWriter::writeUserMentionsEntity(const QTweetEntityUserMentions &entity)
+{
+    writeInt(entity.lowerIndex());
+    writeInt(entity.higherIndex());
+    writeInt(entity.userid());
+    writeString(entity.screenName());
+    writeString(entity.name());
+}
+
+void QTweetBinaryWriter::writeMediaEntity(const QTweetEntityMedia &entity)
+{
+    writeInt(entity.lowerIndex());
+    writeInt(entity.higherIndex());
+    writeText(entity.id());
+    writeText(entity.mediaUrl());
+    writeText(entity.mediaUrlHttps());
+    writeText(entity.url());
+    writeText(entity.displayUrl());
+    writeText(entity.expandedUrl());
+
+    for (int i = QTweetEntityMedia::LARGE; i <= QTweetEntityMedia::THUMB; ++i) {
+        QSize size = entity.size(static_cast<QTweetEntityMedia::MediaSize>(i));
+        writeInt(size.width());
+        writeInt(size.height());
+    }
+}
+
+/**
+ *  Constructor, reads format version from the stream
+ */
+QTweetBinaryReader::QTweetBinaryReader(QDataStream &stream) :
+    m_stream(stream),
+    m_pos(0),
+    m_depth(0),
+    m_error(false),
+    m_version(0)
+{
+    char version = 0;
+
+    if (m_stream.readRawData(&version, 1) != 1) {
+        m_stream.setStatus(QDataStream::ReadPastEnd);
+        return;
+    }
+
+    m_version = static_cast<uchar>(version);
+
+    if (m_version != QTweetBinaryWriter::Version)
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+}
+
+/**
+ *  Gets format version of the stream, 0 if it couldn't be read
+ */
+int QTweetBinaryReader::version() const
+{
+    return m_version;
+}
+
+bool QTweetBinaryReader::read(QTweetStatus *status)
+{
+    if (!beginRecord(StatusRecord))
+        return false;
+
+    QTweetStatus result = readStatus();
+
+    if (!endRecord())
+        return false;
+
+    *status = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetUser *user)
+{
+    if (!beginRecord(UserRecord))
+        return false;
+
+    QTweetUser result = readUser();
+
+    if (!endRecord())
+        return false;
+
+    *user = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetDMStatus *directMessage)
+{
+    if (!beginRecord(DirectMessageRecord))
+        return false;
+
+    QTweetDMStatus result = readDirectMessage();
+
+    if (!endRecord())
+        return false;
+
+    *directMessage = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetPlace *place)
+{
+    if (!beginRecord(PlaceRecord))
+        return false;
+
+    QTweetPlace result = readPlace();
+
+    if (!endRecord())
+        return false;
+
+    *place = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetList *list)
+{
+    if (!beginRecord(ListRecord))
+        return false;
+
+    QTweetList result = readList();
+
+    if (!endRecord())
+        return false;
+
+    *list = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetEntityUrl *entity)
+{
+    if (!beginRecord(UrlEntityRecord))
+        return false;
+
+    QTweetEntityUrl result = readUrlEntity();
+
+    if (!endRecord())
+        return false;
+
+    *entity = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetEntityHashtag *entity)
+{
+    if (!beginRecord(HashtagEntityRecord))
+        return false;
+
+    QTweetEntityHashtag result = readHashtagEntity();
+
+    if (!endRecord())
+        return false;
+
+    *entity = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetEntityUserMentions *entity)
+{
+    if (!beginRecord(UserMentionsEntityRecord))
+        return false;
+
+    QTweetEntityUserMentions result = readUserMentionsEntity();
+
+    if (!endRecord())
+        return false;
+
+    *entity = result;
+    return true;
+}
+
+bool QTweetBinaryReader::read(QTweetEntityMedia *entity)
+{
+    if (!beginRecord(MediaEntityRecord))
+        return false;
+
+    QTweetEntityMedia result = readMediaEntity();
+
+    if (!endRecord())
+        return false;
+
+    *entity = result;
+    return true;
+}
+
+/**
+ *  Reads whole record from the stream and checks its type
+ */
+bool QTweetBinaryReader::beginRecord(int type)
+{
+    if (m_stream.status() != QDataStream::Ok)
+        return false;
+
+    quint64 size = 0;
+
+    for (int shift = 0; ; shift += 7) {
+        char byte;
+
+        if (m_stream.readRawData(&byte, 1) != 1) {
+            m_stream.setStatus(QDataStream::ReadPastEnd);
+            return false;
+        }
+
+        if (shift > 28) {
+            m_stream.setStatus(QDataStream::ReadCorruptData);
+            return false;
+        }
+
+        size |= static_cast<quint64>(byte & 0x7f) << shift;
+
+        if (!(byte & 0x80))
+            break;
+    }
+
+    if (size == 0 || size > static_cast<quint64>(MaxRecordSize)) {
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    m_record.resize(0);
+
+    while (m_record.size() < static_cast<int>(size)) {
+        int offset = m_record.size();
+        int chunk = qMin(static_cast<int>(size) - offset, ReadChunkSize);
+
+        m_record.resize(offset + chunk);
+
+        if (m_stream.readRawData(m_record.data() + offset, chunk) != chunk) {
+            m_stream.setStatus(QDataStream::ReadPastEnd);
+            return false;
+        }
+    }
+
+    if (m_record.at(0) != type) {
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    m_pos = 1;
+    m_depth = 0;
+    m_error = false;
+    return true;
+}
+
+/**
+ *  Checks that the record was read completely and without errors
+ */
+bool QTweetBinaryReader::endRecord()
+{
+    if (m_error || m_pos != m_record.size()) {
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Reads count of elements, every element takes at least one byte
+ */
+int QTweetBinaryReader::readCount()
+{
+    quint64 count = readUInt();
+
+    if (count > static_cast<quint64>(m_record.size() - m_pos)) {
+        m_error = true;
+        return 0;
+    }
+
+    return static_cast<int>(count);
+}
+
+quint64 QTweetBinaryReader::readUInt()
+{
+    quint64 value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (m_pos >= m_record.size())
+            break;
+
+        uchar byte = static_cast<uchar>(m_record.at(m_pos++));
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    m_error = true;
+    return 0;
+}
+
+qint64 QTweetBinaryReader::readInt()
+{
+    quint64 value = readUInt();
+
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+double QTweetBinaryReader::readDouble()
+{
+    if (m_record.size() - m_pos < 8) {
+        m_error = true;
+        return 0;
+    }
+
+    quint64 bits = qFromLittleEndian<quint64>(reinterpret_cast<const uchar *>(m_record.constData() + m_pos));
+    m_pos += 8;
+
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QString QTweetBinaryReader::readString()
+{
+    quint64 value = readUInt();
+
+    if (value & 1) {
+        quint64 index = value >> 1;
+
+        if (index >= static_cast<quint64>(m_strings.size())) {
+            m_error = true;
+            return QString();
+        }
+
+        return m_strings.at(static_cast<int>(index));
+    }
+
+    QString string = readUtf8(value >> 1);
+
+    if (!string.isEmpty() && m_strings.size() < MaxStrings)
+        m_strings.append(string);
+
+    return string;
+}
+
+/**
+ *  Reads string written with QTweetBinaryWriter::writeText()
+ */
+QString QTweetBinaryReader::readText()
+{
+    quint64 value = readUInt();
+
+    if (value & 1) {
+        m_error = true;
+        return QString();
+    }
+
+    return readUtf8(value >> 1);
+}
+
+QString QTweetBinaryReader::readUtf8(quint64 length)
+{
+    if (length == 0)
+        return QString();
+
+    if (length > static_cast<quint64>(m_record.size() - m_pos)) {
+        m_error = true;
+        return QString();
+    }
+
+    QString string = QString::fromUtf8(m_record.constData() + m_pos, static_cast<int>(length));
+    m_pos += static_cast<int>(length);
+
+    return string;
+}
+
+QTweetStatus QTweetBinaryReader::readStatus()
+{
+    QTweetStatus status;
+
+    if (++m_depth > MaxDepth) {
+        m_error = true;
+        return status;
+    }
+
+    status.setId(readInt());
+    uint flags = static_cast<uint>(readUInt());
+    status.setFavorited(flags & StatusFavorited);
+    status.setCreatedAtEpoch(readInt());
+    status.setText(readText());
+    status.setInReplyToUserId(readInt());
+    status.setInReplyToScreenName(readString());
+    status.setInReplyToStatusId(readInt());
+    status.setSource(readString());
+    status.setUser(readUser());
+
+    if (flags & StatusHasPlace)
+        status.setPlace(readPlace());
+
+    // text is set, so entity strings which are in the text are kept as its ranges
+    int count = readCount();
+    for (int i = 0; i < count; ++i)
+        status.addUrlEntity(readUrlEntity());
+
+    count = readCount();
+    for (int i = 0; i < count; ++i)
+        status.addHashtagEntity(readHashtagEntity());
+
+    count = readCount();
+    for (int i = 0; i < count; ++i)
+        status.addUserMentionsEntity(readUserMentionsEntity());
+
+    count = readCount();
+    for (int i = 0; i < count; ++i)
+        status.addMediaEntity(readMediaEntity());
+
+    if (flags & StatusHasRetweet)
+        status.setRetweetedStatus(readStatus());
+
+    --m_depth;
+    return status;
+}
+
+QTweetUser QTweetBinaryReader::readUser()
+{
+    QTweetUser user;
+
+    user.setId(readInt());
+    uint flags = static_cast<uint>(readUInt());
+    user.setContributorsEnabled(flags & UserContributorsEnabled);
+    user.setProtected(flags & UserProtected);
+    user.setGeoEnabled(flags & UserGeoEnabled);
+    user.setVerified(flags & UserVerified);
+    user.setName(readString());
+    user.setScreenName(readString());
+    user.setLocation(readString());
+    user.setDescription(readText());
+    user.setprofileImageUrl(readString());
+    user.setUrl(readString());
+    user.setTimezone(readString());
+    user.setLang(readString());
+    user.setCreatedAtEpoch(readInt());
+    user.setFollowersCount(static_cast<int>(readInt()));
+    user.setFriendsCount(static_cast<int>(readInt()));
+    user.setFavouritesCount(static_cast<int>(readInt()));
+    user.setStatusesCount(static_cast<int>(readInt()));
+    user.setListedCount(static_cast<int>(readInt()));
+    user.setUtcOffset(static_cast<int>(readInt()));
+
+    QTweetStatus lastStatus;
+    lastStatus.setFavorited(flags & UserStatusFavorited);
+    lastStatus.setId(readInt());
+    lastStatus.setCreatedAtEpoch(readInt());
+    lastStatus.setText(readText());
+    lastStatus.setInReplyToUserId(readInt());
+    lastStatus.setInReplyToScreenName(readString());
+    lastStatus.setInReplyToStatusId(readInt());
+    lastStatus.setSource(readString());
+    user.setStatus(lastStatus);
+
+    return user;
+}
+
+QTweetDMStatus QTweetBinaryReader::readDirectMessage()
+{
+    QTweetDMStatus directMessage;
+
+    directMessage.setId(readInt());
+    directMessage.setCreatedAtEpoch(readInt());
+    directMessage.setText(readText());
+    directMessage.setSenderId(readInt());
+    directMessage.setSenderScreenName(readString());
+    directMessage.setSender(readUser());
+    directMessage.setRecipientId(readInt());
+    directMessage.setRecipientScreenName(readString());
+    directMessage.setRecipient(readUser());
+
+    return directMessage;
+}
+
+QTweetPlace QTweetBinaryReader::readPlace()
+{
+    QTweetPlace place;
+
+    if (++m_depth > MaxDepth) {
+        m_error = true;
+        return place;
+    }
+
+    place.setID(readString());
+    quint64 typeAndBox = readUInt();
+
+    if ((typeAndBox >> 1) > QTweetPlace::Country)
+        m_error = true;
+    else
+        place.setType(static_cast<QTweetPlace::Type>(typeAndBox >> 1));
+
+    place.setName(readString());
+    place.setFullName(readString());
+    place.setCountry(readString());
+    place.setCountryCode(readString());
+
+    if (typeAndBox & 1) {
+        QTweetGeoCoord corners[4];
+
+        for (int i = 0; i < 4; ++i) {
+            double latitude = readDouble();
+            double longitude = readDouble();
+            corners[i] = QTweetGeoCoord(latitude, longitude);
+        }
+
+        place.setBoundingBox(QTweetGeoBoundingBox(corners[0], corners[1], corners[2], corners[3]));
+    }
+
+    int count = readCount();
+
+    if (count) {
+        QList<QTweetPlace> containedWithin;
+
+        for (int i = 0; i < count && !m_error; ++i)
+            containedWithin.append(readPlace());
+
+        place.setContainedWithin(containedWithin);
+    }
+
+    --m_depth;
+    return place;
+}
+
+QTweetList QTweetBinaryReader::readList()
+{
+    QTweetList list;
+
+    list.setId(readInt());
+    list.setFollowing(readUInt() & 1);
+    list.setName(readString());
+    list.setFullName(readString());
+    list.setSlug(readString());
+    list.setMode(readString());
+    list.setDescription(readString());
+    list.setUri(readString());
+    list.setMemberCount(static_cast<int>(readInt()));
+    list.setSubscriberCount(static_cast<int>(readInt()));
+    list.setUser(readUser());
+
+    return list;
+}
+
+QTweetEntityUrl QTweetBinaryReader::readUrlEntity()
+{
+    QTweetEntityUrl entity;
+
+    entity.setLowerIndex(static_cast<int>(readInt()));
+    entity.setHigherIndex(static_cast<int>(readInt()));
+    entity.setUrl(readText());
+    entity.setDisplayUrl(readText());
+    entity.setExpandedUrl(readText());
+
+    return entity;
+}
+
+QTweetEntityHashtag QTweetBinaryReader::readHashtagEntity()
+{
+    QTweetEntityHashtag entity;
+
+    entity.setLowerIndex(static_cast<int>(readInt()));
+    entity.setHigherIndex(static_cast<int>(readInt()));
+    entity.setText(readString());
+
+    return entity;
+}
+
+QTweetEntityUserMentions QTweetBinaryReader::readUserMentionsEntity()
+{
+    QTweetEntityUserMentions entity;
+
+    entity.setLowerIndex(static_cast<int>(readInt()));
+    entity.setHigherIndex(static_cast<int>(readInt()));
+    entity.setUserid(readInt());
+    entity.setScreenName(readString());
+    entity.setName(readString());
+
+    return entity;
+}
+
+QTweetEntityMedia QTweetBinaryReader::readMediaEntity()
+{
+    QTweetEntityMedia entity;
+
+    entity.setLowerIndex(static_cast<int>(readInt()));
+    entity.setHigherIndex(static_cast<int>(readInt()));
+    entity.setID(readText());
+    entity.setMediaUrl(readText());
+    entity.setMediaUrlHttps(readText());
+    entity.setUrl(readText());
+    entity.setDisplayUrl(readText());
+    entity.setExpandedUrl(readText());
+
+    for (int i = QTweetEntityMedia::LARGE; i <= QTweetEntityMedia::THUMB; ++i) {
+        int width = static_cast<int>(readInt());
+        int height = static_cast<int>(readInt());
+        entity.setSize(QSize(width, height), static_cast<QTweetEntityMedia::MediaSize>(i));
+    }
+
+    return entity;
+}
+
+/**
+ *  Writes single object to the stream, with own version byte and strings.
+ *  Use QTweetBinaryWriter/QTweetBinaryReader to share strings between many objects.
+ */
+QDataStream& operator<<(QDataStream& stream, const QTweetStatus& status)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(status);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetStatus& status)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&status);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetUser& user)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(user);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetUser& user)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&user);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetDMStatus& directMessage)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(directMessage);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetDMStatus& directMessage)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&directMessage);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetPlace& place)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(place);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetPlace& place)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&place);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetList& list)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(list);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetList& list)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&list);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetEntityUrl& entity)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(entity);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetEntityUrl& entity)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&entity);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetEntityHashtag& entity)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(entity);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetEntityHashtag& entity)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&entity);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetEntityUserMentions& entity)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(entity);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetEntityUserMentions& entity)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&entity);
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const QTweetEntityMedia& entity)
+{
+    QTweetBinaryWriter writer(stream);
+    writer.write(entity);
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, QTweetEntityMedia& entity)
+{
+    QTweetBinaryReader reader(stream);
+    reader.read(&entity);
+    return stream;
+}
@@ -0,0 +1,145 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETBINARY_H
+#define QTWEETBINARY_H
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include "qtweetlib_global.h"
+
+class QDataStream;
+class QTweetStatus;
+class QTweetUser;
+class QTweetDMStatus;
+class QTweetPlace;
+class QTweetList;
+class QTweetEntityUrl;
+class QTweetEntityHashtag;
+class QTweetEntityUserMentions;
+class QTweetEntityMedia;
+
+/**
+ *  Writes model objects to data stream in compact binary format
+ *
+ *  Format starts with version byte, followed by one length prefixed record
+ *  per written object. Ids and numbers are varints, dates are epoch seconds,
+ *  strings are UTF-8. Repeating strings (names, sources, languages...) are
+ *  written once per writer and back-referenced after that, so write many
+ *  objects with one writer. Texts and urls are always written inline, and
+ *  table of back-referenced strings stops growing at 16384 strings.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetBinaryWriter
+{
+public:
+    enum { Version = 2 };
+
+    explicit QTweetBinaryWriter(QDataStream& stream);
+
+    void write(const QTweetStatus& status);
+    void write(const QTweetUser& user);
+    void write(const QTweetDMStatus& directMessage);
+    void write(const QTweetPlace& place);
+    void write(const QTweetList& list);
+    void write(const QTweetEntityUrl& entity);
+    void write(const QTweetEntityHashtag& entity);
+    void write(const QTweetEntityUserMentions& entity);
+    void write(const QTweetEntityMedia& entity);
+
+private:
+    Q_DISABLE_COPY(QTweetBinaryWriter)
+
+    void beginRecord(int type);
+    void endRecord();
+    void writeUInt(quint64 value);
+    void writeInt(qint64 value);
+    void writeDouble(double value);
+    void writeString(const QString& string);
+    void writeText(const QString& text);
+    void writeStatus(const QTweetStatus& status);
+    void writeUser(const QTweetUser& user);
+    void writeDirectMessage(const QTweetDMStatus& directMessage);
+    void writePlace(const QTweetPlace& place);
+    void writeList(const QTweetList& list);
+    void writeUrlEntity(const QTweetEntityUrl& entity);
+    void writeHashtagEntity(const QTweetEntityHashtag& entity);
+    void writeUserMentionsEntity(const QTweetEntityUserMentions& entity);
+    void writeMediaEntity(const QTweetEntityMedia& entity);
+
+    QDataStream& m_stream;
+    QByteArray m_record;
+    QHash<QString, int> m_strings;
+};
+
+/**
+ *  Reads model objects written by QTweetBinaryWriter
+ *
+ *  Objects must be read in the order and with the types they were written.
+ *  On unsupported version or bad data status of the stream is set to
+ *  QDataStream::ReadCorruptData and reading fails.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetBinaryReader
+{
+public:
+    explicit QTweetBinaryReader(QDataStream& stream);
+
+    int version() const;
+
+    bool read(QTweetStatus *status);
+    bool read(QTweetUser *user);
+    bool read(QTweetDMStatus *directMessage);
+    bool read(QTweetPlace *place);
+    bool read(QTweetList *list);
+    bool read(QTweetEntityUrl *entity);
+    bool read(QTweetEntityHashtag *entity);
+    bool read(QTweetEntityUserMentions *entity);
+    bool read(QTweetEntityMedia *entity);
+
+private:
+    Q_DISABLE_COPY(QTweetBinaryReader)
+
+    bool beginRecord(int type);
+    bool endRecord();
+    int readCount();
+    quint64 readUInt();
+    qint64 readInt();
+    double readDouble();
+    QString readString();
+    QString readText();
+    QString readUtf8(quint64 length);
+    QTweetStatus readStatus();
+    QTweetUser readUser();
+    QTweetDMStatus readDirectMessage();
+    QTweetPlace readPlace();
+    QTweetList readList();
+    QTweetEntityUrl readUrlEntity();
+    QTweetEntityHashtag readHashtagEntity();
+    QTweetEntityUserMentions readUserMentionsEntity();
+    QTweetEntityMedia readMediaEntity();
+
+    QDataStream& m_stream;
+    QByteArray m_record;
+    int m_pos;
+    int m_depth;
+    bool m_error;
+    int m_version;
+    QVector<QString> m_strings;
+};
+
+#endif // QTWEETBINARY_H
@@ -54,7 +54,7 @@ void QTweetBlocksBlocking::getBlocks(int page, bool includeEntities)
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/blocking.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/blocking.json");
 
     if (page)
         url.addQueryItem("page", QString::number(page));
@@ -67,14 +67,13 @@ void QTweetBlocksBlocking::getBlocks(int page, bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetBlocksBlocking::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetUser> userlist = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array());
+        QList<QTweetUser> userlist = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array(), userPool(), convertOptions());
 
         emit finishedGettingBlocks(userlist);
     }
@@ -50,15 +50,14 @@ void QTweetBlocksBlockingIDs::getIDs()
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/blocking/ids.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/blocking/ids.json");
 
     QNetworkRequest req(url);
 
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetBlocksBlockingIDs::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -54,7 +54,7 @@ void QTweetBlocksCreate::create(qint64 userid, bool includeEntities)
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/create.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/create.json");
 
     QUrl urlQuery(url);
 
@@ -72,8 +72,7 @@ void QTweetBlocksCreate::create(qint64 userid, bool includeEntities)
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 /**
@@ -88,7 +87,7 @@ void QTweetBlocksCreate::create(const QString& screenName, bool includeEntities)
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/create.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/create.json");
 
     QUrl urlQuery(url);
 
@@ -106,14 +105,13 @@ void QTweetBlocksCreate::create(const QString& screenName, bool includeEntities)
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetBlocksCreate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit finishedCreatingBlock(user);
     }
@@ -54,7 +54,7 @@ void QTweetBlocksDestroy::unblock(qint64 userid, bool includeEntities)
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/destroy.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/destroy.json");
 
     url.addQueryItem("user_id", QString::number(userid));
 
@@ -66,8 +66,7 @@ void QTweetBlocksDestroy::unblock(qint64 userid, bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::DELETE);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->deleteResource(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startDelete(req);
 }
 
 /**
@@ -82,7 +81,7 @@ void QTweetBlocksDestroy::unblock(const QString &screenName, bool includeEntitie
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/destroy.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/destroy.json");
 
     url.addQueryItem("screen_name", screenName);
 
@@ -94,14 +93,13 @@ void QTweetBlocksDestroy::unblock(const QString &screenName, bool includeEntitie
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::DELETE);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->deleteResource(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startDelete(req);
 }
 
 void QTweetBlocksDestroy::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit finishedUnblocking(user);
     }
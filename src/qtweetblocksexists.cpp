@@ -54,7 +54,7 @@ void QTweetBlocksExists::isBlocked(qint64 userid, bool includeEntities)
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/exists.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/exists.json");
 
     url.addQueryItem("user_id", QString::number(userid));
 
@@ -66,8 +66,7 @@ void QTweetBlocksExists::isBlocked(qint64 userid, bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 /**
@@ -82,7 +81,7 @@ void QTweetBlocksExists::isBlocked(const QString &screenName, bool includeEntiti
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/blocks/exists.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "blocks/exists.json");
 
     url.addQueryItem("screen_name", screenName);
 
@@ -94,14 +93,13 @@ void QTweetBlocksExists::isBlocked(const QString &screenName, bool includeEntiti
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetBlocksExists::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit finishedIsBlocked(user);
     }
@@ -0,0 +1,269 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+
+#include "qtweetclient.h"
+#include "qtweethometimeline.h"
+#include "qtweetmentions.h"
+#include "qtweetusertimeline.h"
+#include "qtweetdirectmessages.h"
+
+/**
+ *  Constructor
+ *  @param oauthTwitter OAuthTwitter object used by all calls
+ *  @param parent parent QObject
+ */
+QTweetClient::QTweetClient(OAuthTwitter *oauthTwitter, QObject *parent) :
+    QObject(parent),
+    m_oauthTwitter(oauthTwitter),
+    m_userPool(0),
+    m_convertOptions(QTweetConvert::NoOptions),
+    m_threadedParsing(false),
+    m_endpointCount(0)
+{
+}
+
+/**
+ *  Sets user pool used when converting responses
+ *  @param userPool user pool, not owned. 0 (default) disables pooling
+ */
+void QTweetClient::setUserPool(QTweetUserPool *userPool)
+{
+    m_userPool = userPool;
+}
+
+/**
+ *  Gets user pool used when converting responses
+ */
+QTweetUserPool* QTweetClient::userPool() const
+{
+    return m_userPool;
+}
+
+/**
+ *  Sets parts of the response skipped when converting
+ */
+void QTweetClient::setConvertOptions(QTweetConvert::Options options)
+{
+    m_convertOptions = options;
+}
+
+/**
+ *  Gets parts of the response skipped when converting
+ */
+QTweetConvert::Options QTweetClient::convertOptions() const
+{
+    return m_convertOptions;
+}
+
+/**
+ *  Enables parsing responses on parser threads
+ *  @see QTweetNetBase::setThreadedParsingEnabled
+ */
+void QTweetClient::setThreadedParsingEnabled(bool enable)
+{
+    m_threadedParsing = enable;
+}
+
+/**
+ *  Checks if responses are parsed on parser threads
+ */
+bool QTweetClient::isThreadedParsingEnabled() const
+{
+    return m_threadedParsing;
+}
+
+/**
+ *  Fetches home timeline
+ *  @see QTweetHomeTimeline::fetch
+ */
+QTweetFuture<QList<QTweetStatus> > QTweetClient::homeTimeline(qint64 sinceid, qint64 maxid, int count)
+{
+    QTweetHomeTimeline *endpoint = acquire<QTweetHomeTimeline>(SIGNAL(parsedStatuses(QList<QTweetStatus>)),
+                                                               SLOT(statusesParsed(QList<QTweetStatus>)));
+
+    QTweetPromise<QList<QTweetStatus> > promise;
+    m_statusCalls.insert(endpoint, promise);
+
+    endpoint->fetch(sinceid, maxid, count);
+
+    return promise.future();
+}
+
+/**
+ *  Fetches mentions
+ *  @see QTweetMentions::fetch
+ */
+QTweetFuture<QList<QTweetStatus> > QTweetClient::mentions(qint64 sinceid, qint64 maxid, int count)
+{
+    QTweetMentions *endpoint = acquire<QTweetMentions>(SIGNAL(parsedStatuses(QList<QTweetStatus>)),
+                                                       SLOT(statusesParsed(QList<QTweetStatus>)));
+
+    QTweetPromise<QList<QTweetStatus> > promise;
+    m_statusCalls.insert(endpoint, promise);
+
+    endpoint->fetch(sinceid, maxid, count);
+
+    return promise.future();
+}
+
+/**
+ *  Fetches user timeline
+ *  @see QTweetUserTimeline::fetch
+ */
+QTweetFuture<QList<QTweetStatus> > QTweetClient::userTimeline(qint64 userid,
+                                                              const QString &screenName,
+                                                              qint64 sinceid,
+                                                              qint64 maxid,
+                                                              int count)
+{
+    QTweetUserTimeline *endpoint = acquire<QTweetUserTimeline>(SIGNAL(parsedStatuses(QList<QTweetStatus>)),
+                                                               SLOT(statusesParsed(QList<QTweetStatus>)));
+
+    QTweetPromise<QList<QTweetStatus> > promise;
+    m_statusCalls.insert(endpoint, promise);
+
+    endpoint->fetch(userid, screenName, sinceid, maxid, count);
+
+    return promise.future();
+}
+
+/**
+ *  Fetches received direct messages
+ *  @see QTweetDirectMessages::fetch
+ */
+QTweetFuture<QList<QTweetDMStatus> > QTweetClient::directMessages(qint64 sinceid, qint64 maxid, int count)
+{
+    QTweetDirectMessages *endpoint = acquire<QTweetDirectMessages>(SIGNAL(parsedDirectMessages(QList<QTweetDMStatus>)),
+                                                                   SLOT(directMessagesParsed(QList<QTweetDMStatus>)));
+
+    QTweetPromise<QList<QTweetDMStatus> > promise;
+    m_directMessageCalls.insert(endpoint, promise);
+
+    endpoint->fetch(sinceid, maxid, count);
+
+    return promise.future();
+}
+
+/**
+ *  Gets number of calls in flight
+ */
+int QTweetClient::inFlightCount() const
+{
+    return m_statusCalls.count() + m_directMessageCalls.count();
+}
+
+/**
+ *  Gets number of endpoint objects created, idle and in flight
+ */
+int QTweetClient::endpointCount() const
+{
+    return m_endpointCount;
+}
+
+/**
+ *  Takes idle endpoint of the type or creates and connects new one
+ */
+template <typename Endpoint>
+Endpoint* QTweetClient::acquire(const char *parsedSignal, const char *parsedSlot)
+{
+    QList<QTweetNetBase*>& idle = m_idleEndpoints[&Endpoint::staticMetaObject];
+    Endpoint *endpoint;
+
+    if (!idle.isEmpty()) {
+        endpoint = static_cast<Endpoint*>(idle.takeLast());
+    } else {
+        endpoint = new Endpoint(m_oauthTwitter, this);
+        connect(endpoint, SIGNAL(finished(QByteArray)), this, SLOT(endpointFinished(QByteArray)));
+        connect(endpoint, SIGNAL(error(QTweetNetBase::ErrorCode,QString)),
+                this, SLOT(endpointError(QTweetNetBase::ErrorCode,QString)));
+        connect(endpoint, SIGNAL(parseFinished()), this, SLOT(endpointParseFinished()));
+        connect(endpoint, parsedSignal, this, parsedSlot);
+        ++m_endpointCount;
+    }
+
+    endpoint->setUserPool(m_userPool);
+    endpoint->setConvertOptions(m_convertOptions);
+    endpoint->setThreadedParsingEnabled(m_threadedParsing);
+
+    return endpoint;
+}
+
+void QTweetClient::release(QTweetNetBase *endpoint)
+{
+    m_idleEndpoints[endpoint->metaObject()].append(endpoint);
+}
+
+void QTweetClient::endpointFinished(const QByteArray &response)
+{
+    QObject *endpoint = sender();
+
+    if (m_statusCalls.contains(endpoint))
+        m_statusCalls[endpoint].setResponse(response);
+    else if (m_directMessageCalls.contains(endpoint))
+        m_directMessageCalls[endpoint].setResponse(response);
+}
+
+void QTweetClient::statusesParsed(const QList<QTweetStatus> &statuses)
+{
+    QHash<QObject*, QTweetPromise<QList<QTweetStatus> > >::iterator it = m_statusCalls.find(sender());
+
+    // copy shares the result, continuation may start calls and change the hash
+    if (it != m_statusCalls.end()) {
+        QTweetPromise<QList<QTweetStatus> > promise = it.value();
+        promise.finish(statuses);
+    }
+}
+
+void QTweetClient::directMessagesParsed(const QList<QTweetDMStatus> &messages)
+{
+    QHash<QObject*, QTweetPromise<QList<QTweetDMStatus> > >::iterator it = m_directMessageCalls.find(sender());
+
+    if (it != m_directMessageCalls.end()) {
+        QTweetPromise<QList<QTweetDMStatus> > promise = it.value();
+        promise.finish(messages);
+    }
+}
+
+void QTweetClient::endpointError(QTweetNetBase::ErrorCode code, const QString &errorMsg)
+{
+    QObject *endpoint = sender();
+
+    if (m_statusCalls.contains(endpoint))
+        m_statusCalls.take(endpoint).finishWithError(code, errorMsg);
+    else if (m_directMessageCalls.contains(endpoint))
+        m_directMessageCalls.take(endpoint).finishWithError(code, errorMsg);
+    else
+        return;
+
+    release(qobject_cast<QTweetNetBase*>(endpoint));
+}
+
+// after parsed signal, or instead of it when response isn't expected json
+void QTweetClient::endpointParseFinished()
+{
+    QObject *endpoint = sender();
+
+    if (m_statusCalls.contains(endpoint))
+        m_statusCalls.take(endpoint).finish();
+    else if (m_directMessageCalls.contains(endpoint))
+        m_directMessageCalls.take(endpoint).finish();
+    else
+        return;
+
+    release(qobject_cast<QTweetNetBase*>(endpoint));
+}
@@ -0,0 +1,85 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+
+#ifndef QTWEETCLIENT_H
+#define QTWEETCLIENT_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include "qtweetfuture.h"
+#include "qtweetstatus.h"
+#include "qtweetdmstatus.h"
+
+/**
+ *  Issues API calls which return QTweetFuture instead of signals
+ *
+ *  Endpoint objects are pooled and reused between calls: a call takes an idle
+ *  endpoint and gives it back when finished, so many calls don't construct,
+ *  connect and delete a QObject each. Pool grows to the peak number of calls
+ *  in flight.
+ *  @remarks Calls in flight when client is destroyed never finish
+ */
+class QTWEETLIBSHARED_EXPORT QTweetClient : public QObject
+{
+    Q_OBJECT
+public:
+    QTweetClient(OAuthTwitter *oauthTwitter, QObject *parent = 0);
+
+    void setUserPool(QTweetUserPool *userPool);
+    QTweetUserPool* userPool() const;
+    void setConvertOptions(QTweetConvert::Options options);
+    QTweetConvert::Options convertOptions() const;
+    void setThreadedParsingEnabled(bool enable);
+    bool isThreadedParsingEnabled() const;
+
+    QTweetFuture<QList<QTweetStatus> > homeTimeline(qint64 sinceid = 0, qint64 maxid = 0, int count = 0);
+    QTweetFuture<QList<QTweetStatus> > mentions(qint64 sinceid = 0, qint64 maxid = 0, int count = 0);
+    QTweetFuture<QList<QTweetStatus> > userTimeline(qint64 userid = 0,
+                                                    const QString& screenName = QString(),
+                                                    qint64 sinceid = 0,
+                                                    qint64 maxid = 0,
+                                                    int count = 0);
+    QTweetFuture<QList<QTweetDMStatus> > directMessages(qint64 sinceid = 0, qint64 maxid = 0, int count = 0);
+
+    int inFlightCount() const;
+    int endpointCount() const;
+
+private slots:
+    void endpointFinished(const QByteArray& response);
+    void endpointError(QTweetNetBase::ErrorCode code, const QString& errorMsg);
+    void statusesParsed(const QList<QTweetStatus>& statuses);
+    void directMessagesParsed(const QList<QTweetDMStatus>& messages);
+    void endpointParseFinished();
+
+private:
+    template <typename Endpoint>
+    Endpoint* acquire(const char *parsedSignal, const char *parsedSlot);
+    void release(QTweetNetBase *endpoint);
+
+    OAuthTwitter *m_oauthTwitter;
+    QTweetUserPool *m_userPool;
+    QTweetConvert::Options m_convertOptions;
+    bool m_threadedParsing;
+    int m_endpointCount;
+    QHash<const QMetaObject*, QList<QTweetNetBase*> > m_idleEndpoints;
+    QHash<QObject*, QTweetPromise<QList<QTweetStatus> > > m_statusCalls;
+    QHash<QObject*, QTweetPromise<QList<QTweetDMStatus> > > m_directMessageCalls;
+};
+
+#endif // QTWEETCLIENT_H
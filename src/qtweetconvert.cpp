@@ -17,9 +17,16 @@
 
 #include "qtweetconvert.h"
 #include <QSize>
-#include "qtweetstatus.h"
-#include "qtweetdmstatus.h"
-#include "qtweetuser.h"
+#include <QDateTime>
+#include <QVector>
+#include <QHash>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include "qtweetstatus_p.h"
+#include "qtweetdmstatus_p.h"
+#include "qtweetuser_p.h"
+#include "qtweetstatusbatch_p.h"
 #include "qtweetlist.h"
 #include "qtweetplace.h"
 #include "qtweetsearchresult.h"
@@ -28,176 +35,442 @@
 #include "qtweetentityhashtag.h"
 #include "qtweetentityusermentions.h"
 #include "qtweetentitymedia.h"
+#include "qtweetuserpool.h"
+#include "qtweetstringtable.h"
+#include "qtweetplacegraph.h"
+#include "qtweettextrenderer.h"
 #include "json/qjsonarray.h"
 #include "json/qjsonobject.h"
 
-QList<QTweetStatus> QTweetConvert::jsonArrayToStatusList(const QJsonArray &jsonArray)
+const qint64 QTweetConvert::InvalidEpoch;
+
+static QAtomicInt parallelConversionThreshold(50);
+
+// Part of the array converted by one thread
+template <typename T>
+struct ConvertChunk
+{
+    typedef T (*Converter)(const QJsonObject&, QTweetUserPool*, QTweetConvert::Options);
+
+    const QJsonArray *jsonArray;
+    int begin;
+    int end;
+    Converter convert;
+    QTweetUserPool *userPool;
+    QTweetConvert::Options options;
+    QList<T> result;
+};
+
+template <typename T>
+static void convertChunk(ConvertChunk<T>& chunk)
+{
+    chunk.result.reserve(chunk.end - chunk.begin);
+
+    for (int i = chunk.begin; i < chunk.end; ++i)
+        chunk.result.append(chunk.convert(chunk.jsonArray->at(i).toObject(), chunk.userPool, chunk.options));
+}
+
+// Converts elements of the array, in parallel on the global thread pool
+// when array is big enough. Order of elements is preserved.
+// share replaces users of the element with pooled ones after parallel conversion.
+template <typename T>
+static QList<T> convertArray(const QJsonArray& jsonArray,
+                             T (*convert)(const QJsonObject&, QTweetUserPool*, QTweetConvert::Options),
+                             QTweetUserPool *userPool,
+                             QTweetConvert::Options options,
+                             void (*share)(T&, QTweetUserPool*) = 0)
 {
-    QList<QTweetStatus> statuses;
+    int size = jsonArray.size();
+    int threshold = parallelConversionThreshold.fetchAndAddRelaxed(0);
+    int threadCount = qMin(QThreadPool::globalInstance()->maxThreadCount(), size);
 
-    for (int i = 0; i < jsonArray.size(); ++ i) {
-        QTweetStatus tweetStatus = jsonObjectToStatus(jsonArray[i].toObject());
+    ConvertChunk<T> chunk = { &jsonArray, 0, size, convert, userPool, options, QList<T>() };
 
-        statuses.append(tweetStatus);
+    if (threshold <= 0 || size < threshold || threadCount < 2) {
+        convertChunk(chunk);
+        return chunk.result;
     }
 
-    return statuses;
+    QVector<ConvertChunk<T> > chunks(threadCount, chunk);
+
+    for (int i = 0; i < threadCount; ++i) {
+        chunks[i].begin = size * i / threadCount;
+        chunks[i].end = size * (i + 1) / threadCount;
+    }
+
+    // calling thread converts a chunk too, so it's safe to call from the pool
+    QtConcurrent::blockingMap(chunks, convertChunk<T>);
+
+    QList<T> result;
+    result.reserve(size);
+
+    for (int i = 0; i < threadCount; ++i)
+        result.append(chunks.at(i).result);
+
+    // threads can insert different versions of the same user, newer one stays
+    // in the pool, so elements get it like they would in sequential conversion
+    if (userPool && share && !(options & (QTweetConvert::UserIdOnly | QTweetConvert::SkipNestedStatus)))
+        for (int i = 0; i < result.size(); ++i)
+            share(result[i], userPool);
+
+    return result;
 }
 
-QTweetStatus QTweetConvert::jsonObjectToStatus(const QJsonObject& json)
+/**
+ *  Sets minimum number of elements for which the array converters
+ *  (statuses, users, direct messages) split the work across the global thread pool.
+ *  Default is 50. Zero or less disables parallel conversion.
+ *  @remarks Converted objects are the same as with sequential conversion,
+ *           user pool is shared between the threads
+ */
+void QTweetConvert::setParallelThreshold(int count)
 {
-    QTweetStatus status;
+    parallelConversionThreshold.fetchAndStoreRelaxed(count);
+}
 
-    status.setCreatedAt(json["created_at"].toString());
-    status.setText(json["text"].toString());
-    status.setId(static_cast<qint64>(json["id"].toDouble()));
-    status.setInReplyToUserId(static_cast<qint64>(json["in_reply_to_user_id"].toDouble()));
-    status.setInReplyToScreenName(json["in_reply_to_screen_name"].toString());
-    status.setFavorited(json["favorited"].toBool());
+/**
+ *  Gets minimum number of elements for parallel array conversion
+ */
+int QTweetConvert::parallelThreshold()
+{
+    return parallelConversionThreshold.fetchAndAddRelaxed(0);
+}
 
-    QJsonObject userObject = json["user"].toObject();
-    QTweetUser user = jsonObjectToUser(userObject);
-    status.setUser(user);
+static inline int monthFromName(const QChar *s)
+{
+    // case sensitive, twitter always sends english abbreviations
+    ushort c0 = s[0].unicode();
+    ushort c1 = s[1].unicode();
+    ushort c2 = s[2].unicode();
+
+    switch (c0) {
+    case 'J':
+        if (c1 == 'a' && c2 == 'n') return 1;
+        if (c1 == 'u' && c2 == 'n') return 6;
+        if (c1 == 'u' && c2 == 'l') return 7;
+        break;
+    case 'F':
+        if (c1 == 'e' && c2 == 'b') return 2;
+        break;
+    case 'M':
+        if (c1 == 'a' && c2 == 'r') return 3;
+        if (c1 == 'a' && c2 == 'y') return 5;
+        break;
+    case 'A':
+        if (c1 == 'p' && c2 == 'r') return 4;
+        if (c1 == 'u' && c2 == 'g') return 8;
+        break;
+    case 'S':
+        if (c1 == 'e' && c2 == 'p') return 9;
+        break;
+    case 'O':
+        if (c1 == 'c' && c2 == 't') return 10;
+        break;
+    case 'N':
+        if (c1 == 'o' && c2 == 'v') return 11;
+        break;
+    case 'D':
+        if (c1 == 'e' && c2 == 'c') return 12;
+        break;
+    }
 
-    status.setSource(json["source"].toString());
-    status.setInReplyToStatusId(static_cast<qint64>(json["in_reply_to_status_id"].toDouble()));
+    return 0;
+}
 
-    //check if contains native retweet
-    if (json.contains("retweeted_status")) {
-        QJsonObject retweetObject = json["retweeted_status"].toObject();
+static inline int digits(const QChar *s, int count)
+{
+    int value = 0;
 
-        QTweetStatus rtStatus = jsonObjectToStatus(retweetObject);
+    for (int i = 0; i < count; ++i) {
+        ushort c = s[i].unicode();
 
-        status.setRetweetedStatus(rtStatus);
-    }
+        if (c < '0' || c > '9')
+            return -1;
 
-    //parse place id if it's not null
-    QJsonValue placeValue = json["place"];
-    if (!placeValue.isNull()) {
-        QTweetPlace place = jsonObjectToPlace(placeValue.toObject());
-        status.setPlace(place);
+        value = value * 10 + (c - '0');
     }
 
-    //check if contains entities
-    if (json.contains("entities")) {
-        QJsonObject entitiesObject = json["entities"].toObject();
+    return value;
+}
 
-        //url entities
-        QJsonArray urlEntitiesList = entitiesObject["urls"].toArray();
+static qint64 civilToEpoch(int year, int month, int day, int hour, int minute, int second, const QChar *offset)
+{
+    static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
-        for (int i = 0; i < urlEntitiesList.size(); ++i) {
-            QTweetEntityUrl urlEntity = jsonObjectToEntityUrl(urlEntitiesList[i].toObject());
+    if (year < 0 || month < 1 || day < 1 || hour < 0 || hour > 23 ||
+            minute < 0 || minute > 59 || second < 0 || second > 60)
+        return QTweetConvert::InvalidEpoch;
 
-            status.addUrlEntity(urlEntity);
-        }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
 
-        //hashtag entities
-        QJsonArray hashtagEntitiesList = entitiesObject["hashtags"].toArray();
+    if (day > daysInMonth[month - 1] + (month == 2 && leap ? 1 : 0))
+        return QTweetConvert::InvalidEpoch;
 
-        for (int i = 0; i < hashtagEntitiesList.size(); ++i) {
-            QTweetEntityHashtag hashtagEntity = jsonObjectToEntityHashtag(hashtagEntitiesList[i].toObject());
+    ushort sign = offset[0].unicode();
+    int offsetHours = digits(offset + 1, 2);
+    int offsetMinutes = digits(offset + 3, 2);
 
-            status.addHashtagEntity(hashtagEntity);
-        }
+    if ((sign != '+' && sign != '-') || offsetHours < 0 || offsetMinutes < 0)
+        return QTweetConvert::InvalidEpoch;
 
-        //user mentions
-        QJsonArray userMentionsEntitiesList = entitiesObject["user_mentions"].toArray();
+    // days from civil, shifts year to start at march
+    int y = year - (month <= 2 ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    qint64 days = static_cast<qint64>(era) * 146097 + doe - 719468;
 
-        for (int i = 0; i < userMentionsEntitiesList.count(); ++i) {
-            QTweetEntityUserMentions userMentionsEntity = jsonObjectToEntityUserMentions(userMentionsEntitiesList[i].toObject());
+    qint64 offsetSeconds = offsetHours * 3600 + offsetMinutes * 60;
 
-            status.addUserMentionsEntity(userMentionsEntity);
-        }
+    if (sign == '-')
+        offsetSeconds = -offsetSeconds;
 
-        //media
-        QJsonArray mediaEntitiesList = entitiesObject["media"].toArray();
+    return days * 86400 + hour * 3600 + minute * 60 + second - offsetSeconds;
+}
 
-        for (int i = 0; i < mediaEntitiesList.count(); ++i) {
-            QTweetEntityMedia mediaEntity = jsonObjectToEntityMedia(mediaEntitiesList[i].toObject());
+static qint64 twitterDateToEpoch(const QChar *s, int size)
+{
+    //Wed Sep 01 11:27:25 +0000 2010
+    if (size != 30)
+        return QTweetConvert::InvalidEpoch;
 
-            status.addMediaEntity(mediaEntity);
-        }
+    return civilToEpoch(digits(s + 26, 4), monthFromName(s + 4), digits(s + 8, 2),
+                   digits(s + 11, 2), digits(s + 14, 2), digits(s + 17, 2), s + 20);
+}
+
+static qint64 searchDateToEpoch(const QChar *s, int size)
+{
+    //Mon, 04 Oct 2010 12:51:42 +0000
+    if (size != 31)
+        return QTweetConvert::InvalidEpoch;
+
+    return civilToEpoch(digits(s + 12, 4), monthFromName(s + 8), digits(s + 5, 2),
+                   digits(s + 17, 2), digits(s + 20, 2), digits(s + 23, 2), s + 26);
+}
+
+static inline int entityIndex(const QJsonObject& json, int i)
+{
+    return static_cast<int>(json["indices"].toArray().at(i).toDouble());
+}
+
+// Entities are appended to the status data as records, no entity objects in between
+
+static void appendUrlEntity(QTweetStatusData *d, const QJsonObject& json)
+{
+    QTweetEntityRecord record = QTweetStatusData::newEntity(QTweetStatus::UrlEntity,
+                                                            entityIndex(json, 0), entityIndex(json, 1));
+    QString strings[] = { json["url"].toString(), json["display_url"].toString(), json["expanded_url"].toString() };
+
+    d->appendEntity(record, strings, 3);
+}
+
+static void appendHashtagEntity(QTweetStatusData *d, const QJsonObject& json)
+{
+    QTweetEntityRecord record = QTweetStatusData::newEntity(QTweetStatus::HashtagEntity,
+                                                            entityIndex(json, 0), entityIndex(json, 1));
+    QString strings[] = { json["text"].toString() };
+
+    d->appendEntity(record, strings, 1);
+}
+
+static void appendUserMentionsEntity(QTweetStatusData *d, const QJsonObject& json)
+{
+    QTweetEntityRecord record = QTweetStatusData::newEntity(QTweetStatus::UserMentionsEntity,
+                                                            entityIndex(json, 0), entityIndex(json, 1));
+    record.userid = static_cast<qint64>(json["id"].toDouble());
+    QString strings[] = { json["screen_name"].toString(), json["name"].toString() };
+
+    d->appendEntity(record, strings, 2);
+}
+
+static void appendMediaEntity(QTweetStatusData *d, const QJsonObject& json)
+{
+    // in QTweetEntityMedia::MediaSize order
+    static const char * const sizeNames[] = { "large", "medium", "small", "thumb" };
+
+    QTweetEntityRecord record = QTweetStatusData::newEntity(QTweetStatus::MediaEntity,
+                                                            entityIndex(json, 0), entityIndex(json, 1));
+    QJsonObject sizesObject = json["sizes"].toObject();
+
+    for (int i = QTweetEntityMedia::LARGE; i <= QTweetEntityMedia::THUMB; ++i) {
+        QJsonObject sizeObject = sizesObject.value(QLatin1String(sizeNames[i])).toObject();
+        record.mediaSizes[i][0] = qBound(0, static_cast<int>(sizeObject["w"].toDouble()), 0xffff);
+        record.mediaSizes[i][1] = qBound(0, static_cast<int>(sizeObject["h"].toDouble()), 0xffff);
     }
 
+    QString strings[] = { json["id_str"].toString(), json["media_url"].toString(), json["media_url_https"].toString(),
+                          json["url"].toString(), json["display_url"].toString(), json["expanded_url"].toString() };
+
+    d->appendEntity(record, strings, 6);
+}
+
+static void appendEntities(QTweetStatusData *d, const QJsonObject& entitiesObject)
+{
+    QJsonArray urlEntitiesList = entitiesObject["urls"].toArray();
+    QJsonArray hashtagEntitiesList = entitiesObject["hashtags"].toArray();
+    QJsonArray userMentionsEntitiesList = entitiesObject["user_mentions"].toArray();
+    QJsonArray mediaEntitiesList = entitiesObject["media"].toArray();
+
+    d->entities.reserve(urlEntitiesList.size() + hashtagEntitiesList.size() +
+                        userMentionsEntitiesList.size() + mediaEntitiesList.size());
+
+    for (int i = 0; i < urlEntitiesList.size(); ++i)
+        appendUrlEntity(d, urlEntitiesList[i].toObject());
+
+    for (int i = 0; i < hashtagEntitiesList.size(); ++i)
+        appendHashtagEntity(d, hashtagEntitiesList[i].toObject());
+
+    for (int i = 0; i < userMentionsEntitiesList.size(); ++i)
+        appendUserMentionsEntity(d, userMentionsEntitiesList[i].toObject());
+
+    for (int i = 0; i < mediaEntitiesList.size(); ++i)
+        appendMediaEntity(d, mediaEntitiesList[i].toObject());
+}
+
+QList<QTweetStatus> QTweetConvert::jsonArrayToStatusList(const QJsonArray &jsonArray, QTweetUserPool *userPool, Options options)
+{
+    QList<QTweetStatus> statuses = convertArray(jsonArray, jsonObjectToStatus, userPool, options, sharePooledUsers);
+
+    shareRetweetedStatuses(statuses);
+
+    return statuses;
+}
+
+/**
+ *  Converts status
+ *  @param userPool when set, status user is shared with other statuses and direct messages
+ *                  converted with the same pool
+ */
+QTweetStatus QTweetConvert::jsonObjectToStatus(const QJsonObject& json, QTweetUserPool *userPool, Options options)
+{
+    QTweetStatus status;
+    // one detach check, the rest is written straight to the data
+    QTweetStatusData *d = status.d.data();
+    QTweetStringTable *strings = QTweetStringTable::instance();
+
+    d->createdAt = twitterDateToEpoch(json["created_at"].toString());
+    d->text = json["text"].toString();
+    d->id = static_cast<qint64>(json["id"].toDouble());
+    d->inReplyToUserId = static_cast<qint64>(json["in_reply_to_user_id"].toDouble());
+    d->inReplyToScreenName = json["in_reply_to_screen_name"].toString();
+    d->favorited = json["favorited"].toBool();
+    d->user = jsonObjectToPooledUser(json["user"].toObject(), userPool, d->id, options);
+    d->source = strings->intern(QTweetStringTable::Source, json["source"].toString());
+    d->inReplyToStatusId = static_cast<qint64>(json["in_reply_to_status_id"].toDouble());
+
+    //check if contains native retweet
+    if (!(options & SkipRetweetedStatus) && json.contains("retweeted_status"))
+        d->retweetedStatus = jsonObjectToStatus(json["retweeted_status"].toObject(), userPool, options).d;
+
+    //parse place id if it's not null
+    QJsonValue placeValue = json["place"];
+    if (!(options & SkipPlace) && !placeValue.isNull())
+        d->place = jsonObjectToPlace(placeValue.toObject());
+
+    //check if contains entities, appended as records after the text is set
+    if (!(options & SkipEntities) && json.contains("entities"))
+        appendEntities(d, json["entities"].toObject());
+
+    if (options & RenderRichText)
+        d->richText = QTweetTextRenderer::toHtml(status);
+
     return status;
 }
 
-QTweetUser QTweetConvert::jsonObjectToUser(const QJsonObject &jsonObject)
+/**
+ *  Converts user
+ *  @param userPool when set, converted user replaces pooled user: top level user
+ *                  payload is always up to date, even without status
+ */
+QTweetUser QTweetConvert::jsonObjectToUser(const QJsonObject &jsonObject, QTweetUserPool *userPool, Options options)
 {
+    if (userPool) {
+        qint64 version = static_cast<qint64>(jsonObject.value("status").toObject().value("id").toDouble());
+
+        // top level user is never trimmed, user without status isn't pooled,
+        // other conversions would get it without status
+        QTweetUser user = jsonObjectToUser(jsonObject, 0, options & ~UserIdOnly);
+
+        if (options & SkipNestedStatus)
+            return user;
+
+        return userPool->replace(user, version);
+    }
+
     QTweetUser userInfo;
+    QTweetUserData *d = userInfo.d.data();
+    QTweetStringTable *strings = QTweetStringTable::instance();
 
-    userInfo.setId(static_cast<qint64>(jsonObject.value("id").toDouble()));
+    d->id = static_cast<qint64>(jsonObject.value("id").toDouble());
 
     if (jsonObject.contains("name")) {
-        userInfo.setName(jsonObject.value("name").toString());
-        userInfo.setLocation(jsonObject.value("location").toString());
-        userInfo.setprofileImageUrl(jsonObject.value("profile_image_url").toString());
-        userInfo.setCreatedAt(jsonObject.value("created_at").toString());
-        userInfo.setFavouritesCount(static_cast<int>(jsonObject.value("favourites_count").toDouble()));
-        userInfo.setUrl(jsonObject.value("url").toString());
-        userInfo.setUtcOffset(static_cast<int>(jsonObject.value("utc_offset").toDouble()));
-        userInfo.setProtected(jsonObject.value("protected").toBool());
-        userInfo.setFollowersCount(static_cast<int>(jsonObject.value("followers_count").toDouble()));
-        userInfo.setVerified(jsonObject.value("verified").toBool());
-        userInfo.setGeoEnabled(jsonObject.value("geo_enabled").toBool());
-        userInfo.setDescription(jsonObject.value("description").toString());
-        userInfo.setTimezone(jsonObject.value("time_zone").toString());
-        userInfo.setStatusesCount(static_cast<int>(jsonObject.value("statuses_count").toDouble()));
-        userInfo.setScreenName(jsonObject.value("screen_name").toString());
-        userInfo.setContributorsEnabled(jsonObject.value("contributors_enabled").toBool());
-        userInfo.setListedCount(static_cast<int>(jsonObject.value("listed_count").toDouble()));
-        userInfo.setLang(jsonObject.value("lang").toString());
-
-        if (jsonObject.contains("status")) {
+        d->name = jsonObject.value("name").toString();
+        d->location = strings->intern(QTweetStringTable::Location, jsonObject.value("location").toString());
+        d->profileImageUrl = strings->intern(QTweetStringTable::ProfileImageUrl, jsonObject.value("profile_image_url").toString());
+        d->createdAt = twitterDateToEpoch(jsonObject.value("created_at").toString());
+        d->favoritesCount = static_cast<int>(jsonObject.value("favourites_count").toDouble());
+        d->url = jsonObject.value("url").toString();
+        d->utcOffset = static_cast<int>(jsonObject.value("utc_offset").toDouble());
+        d->accountProtected = jsonObject.value("protected").toBool();
+        d->followersCount = static_cast<int>(jsonObject.value("followers_count").toDouble());
+        d->verified = jsonObject.value("verified").toBool();
+        d->geoEnabled = jsonObject.value("geo_enabled").toBool();
+        d->description = jsonObject.value("description").toString();
+        d->timeZone = strings->intern(QTweetStringTable::TimeZone, jsonObject.value("time_zone").toString());
+        d->statusesCount = static_cast<int>(jsonObject.value("statuses_count").toDouble());
+        d->screenName = jsonObject.value("screen_name").toString();
+        d->contributorsEnabled = jsonObject.value("contributors_enabled").toBool();
+        d->listedCount = static_cast<int>(jsonObject.value("listed_count").toDouble());
+        d->lang = strings->intern(QTweetStringTable::Lang, jsonObject.value("lang").toString());
+
+        // only the fields kept by the user, no need to convert whole status
+        if (!(options & SkipNestedStatus) && jsonObject.contains("status")) {
             QJsonObject jsonStatusObject = jsonObject.value("status").toObject();
 
-            QTweetStatus status = jsonObjectToStatus(jsonStatusObject);
-            userInfo.setStatus(status);
+            d->statusId = static_cast<qint64>(jsonStatusObject.value("id").toDouble());
+            d->statusText = jsonStatusObject.value("text").toString();
+            d->statusCreatedAt = twitterDateToEpoch(jsonStatusObject.value("created_at").toString());
+            d->statusInReplyToScreenName = jsonStatusObject.value("in_reply_to_screen_name").toString();
+            d->statusInReplyToStatusId = static_cast<qint64>(jsonStatusObject.value("in_reply_to_status_id").toDouble());
+            d->statusInReplyToUserId = static_cast<qint64>(jsonStatusObject.value("in_reply_to_user_id").toDouble());
+            d->statusFavorited = jsonStatusObject.value("favorited").toBool();
+            d->statusSource = strings->intern(QTweetStringTable::Source, jsonStatusObject.value("source").toString());
         }
     }
 
     return userInfo;
 }
 
-QList<QTweetDMStatus> QTweetConvert::jsonArrayToDirectMessagesList(const QJsonArray &jsonArray)
+QList<QTweetDMStatus> QTweetConvert::jsonArrayToDirectMessagesList(const QJsonArray &jsonArray, QTweetUserPool *userPool, Options options)
 {
-    QList<QTweetDMStatus> directMessages;
-
-    for (int i = 0; i < jsonArray.size(); ++i) {
-        QJsonObject dmObject = jsonArray[i].toObject();
-        QTweetDMStatus dmStatus = jsonObjectToDirectMessage(dmObject);
-        directMessages.append(dmStatus);
-    }
-
-    return directMessages;
+    return convertArray(jsonArray, jsonObjectToDirectMessage, userPool, options, sharePooledUsers);
 }
 
-QTweetDMStatus QTweetConvert::jsonObjectToDirectMessage(const QJsonObject &jsonObject)
+/**
+ *  Converts direct message
+ *  @param userPool when set, sender and recipient are shared with other statuses and
+ *                  direct messages converted with the same pool
+ */
+QTweetDMStatus QTweetConvert::jsonObjectToDirectMessage(const QJsonObject &jsonObject, QTweetUserPool *userPool, Options options)
 {
     QTweetDMStatus directMessage;
-
-    directMessage.setCreatedAt(jsonObject.value("created_at").toString());
-    directMessage.setSenderScreenName(jsonObject.value("sender_screen_name").toString());
-
-    QJsonObject jsonObjectUser = jsonObject.value("sender").toObject();
-    QTweetUser sender = jsonObjectToUser(jsonObjectUser);
-    directMessage.setSender(sender);
-
-    directMessage.setText(jsonObject.value("text").toString());
-    directMessage.setRecipientScreenName(jsonObject["recipient_screen_name"].toString());
-    directMessage.setId(static_cast<qint64>(jsonObject["id"].toDouble()));
-
-    QJsonObject jsonObjectRecipient = jsonObject["recipient"].toObject();
-    QTweetUser recipient = jsonObjectToUser(jsonObjectRecipient);
-    directMessage.setRecipient(recipient);
-
-    directMessage.setRecipientId(static_cast<qint64>(jsonObject["recipient_id"].toDouble()));
-    directMessage.setSenderId(static_cast<qint64>(jsonObject["sender_id"].toDouble()));
+    QTweetDMStatusData *d = directMessage.d.data();
+
+    d->id = static_cast<qint64>(jsonObject["id"].toDouble());
+    d->createdAt = twitterDateToEpoch(jsonObject.value("created_at").toString());
+    d->senderScreenName = jsonObject.value("sender_screen_name").toString();
+    d->sender = jsonObjectToPooledUser(jsonObject.value("sender").toObject(), userPool, d->id, options);
+    d->text = jsonObject.value("text").toString();
+    d->recipientScreenName = jsonObject["recipient_screen_name"].toString();
+    d->recipient = jsonObjectToPooledUser(jsonObject["recipient"].toObject(), userPool, d->id, options);
+    d->recipientId = static_cast<qint64>(jsonObject["recipient_id"].toDouble());
+    d->senderId = static_cast<qint64>(jsonObject["sender_id"].toDouble());
 
     return directMessage;
 }
 
-QTweetList QTweetConvert::jsonObjectToTweetList(const QJsonObject& jsonObject)
+QTweetList QTweetConvert::jsonObjectToTweetList(const QJsonObject& jsonObject, QTweetUserPool *userPool, Options options)
 {
     QTweetList list;
 
@@ -215,7 +488,8 @@ QTweetList QTweetConvert::jsonObjectToTweetList(const QJsonObject& jsonObject)
     if (jsonObject.contains("user")) {
         QJsonObject userMap = jsonObject["user"].toObject();
 
-        QTweetUser user = jsonObjectToUser(userMap);
+        qint64 version = static_cast<qint64>(userMap.value("status").toObject().value("id").toDouble());
+        QTweetUser user = jsonObjectToPooledUser(userMap, userPool, version, options);
 
         list.setUser(user);
     }
@@ -223,30 +497,180 @@ QTweetList QTweetConvert::jsonObjectToTweetList(const QJsonObject& jsonObject)
     return list;
 }
 
-QList<QTweetUser> QTweetConvert::jsonArrayToUserInfoList(const QJsonArray& jsonArray)
+QList<QTweetUser> QTweetConvert::jsonArrayToUserInfoList(const QJsonArray& jsonArray, QTweetUserPool *userPool, Options options)
 {
-    QList<QTweetUser> users;
+    return convertArray(jsonArray, jsonObjectToUser, userPool, options, sharePooledUsers);
+}
+
+QList<QTweetList> QTweetConvert::jsonArrayToTweetLists(const QJsonArray& jsonArray, QTweetUserPool *userPool, Options options)
+{
+    QList<QTweetList> lists;
+    lists.reserve(jsonArray.size());
 
     for (int i = 0; i < jsonArray.size(); ++i) {
-        QTweetUser userInfo = jsonObjectToUser(jsonArray[i].toObject());
+        QTweetList tweetlist = jsonObjectToTweetList(jsonArray[i].toObject(), userPool, options);
 
-        users.append(userInfo);
+        lists.append(tweetlist);
     }
 
-    return users;
+    return lists;
 }
 
-QList<QTweetList> QTweetConvert::jsonArrayToTweetLists(const QJsonArray& jsonArray)
+/**
+ *  Converts statuses straight into columns of the batch, without status objects
+ *  @remarks Entities and places are skipped, batch doesn't keep them
+ */
+QTweetStatusBatch QTweetConvert::jsonArrayToStatusBatch(const QJsonArray &jsonArray, QTweetUserPool *userPool, Options options)
 {
-    QList<QTweetList> lists;
+    QTweetStatusBatch batch;
+    QTweetStatusBatchData *d = batch.d.data();
+
+    d->reserve(jsonArray.size());
 
     for (int i = 0; i < jsonArray.size(); ++i) {
-        QTweetList tweetlist = jsonObjectToTweetList(jsonArray[i].toObject());
+        QJsonObject json = jsonArray.at(i).toObject();
 
-        lists.append(tweetlist);
+        qint64 id = static_cast<qint64>(json["id"].toDouble());
+        qint64 inReplyToStatusId = static_cast<qint64>(json["in_reply_to_status_id"].toDouble());
+        qint64 retweetedStatusId = 0;
+        quint8 flags = 0;
+
+        if (json.contains("retweeted_status")) {
+            retweetedStatusId = static_cast<qint64>(json["retweeted_status"].toObject().value("id").toDouble());
+            flags |= QTweetStatusBatch::Retweet;
+        }
+
+        if (json["favorited"].toBool())
+            flags |= QTweetStatusBatch::Favorited;
+        if (inReplyToStatusId)
+            flags |= QTweetStatusBatch::Reply;
+
+        QTweetUser user = jsonObjectToPooledUser(json["user"].toObject(), userPool, id, options);
+
+        d->ids.append(id);
+        d->createdAt.append(twitterDateToEpoch(json["created_at"].toString()));
+        d->userIds.append(user.id());
+        d->inReplyToStatusIds.append(inReplyToStatusId);
+        d->inReplyToUserIds.append(static_cast<qint64>(json["in_reply_to_user_id"].toDouble()));
+        d->retweetedStatusIds.append(retweetedStatusId);
+        d->flags.append(flags);
+        d->userIndexes.append(d->userIndex(user));
+        d->texts.append(d->appendString(json["text"].toString()));
+        d->sources.append(d->appendString(json["source"].toString()));
+        d->inReplyToScreenNames.append(d->appendString(json["in_reply_to_screen_name"].toString()));
     }
 
-    return lists;
+    return batch;
+}
+
+/**
+ *  Retweets of the same status share one retweeted status, which is the status
+ *  itself when it's in the list too (and isn't a retweet, which would create a cycle)
+ */
+void QTweetConvert::shareRetweetedStatuses(QList<QTweetStatus> &statuses)
+{
+    // take data pointers first, before any data gets shared
+    QVector<QTweetStatusData *> data(statuses.size());
+    QHash<qint64, QTweetStatusData *> statusById;
+
+    for (int i = 0; i < statuses.size(); ++i) {
+        data[i] = statuses[i].d.data();
+        statusById.insert(data.at(i)->id, data.at(i));
+    }
+
+    QHash<qint64, QSharedDataPointer<QTweetStatusData> > retweetedById;
+
+    for (int i = 0; i < data.size(); ++i) {
+        QSharedDataPointer<QTweetStatusData> &retweeted = data[i]->retweetedStatus;
+
+        if (!retweeted)
+            continue;
+
+        qint64 id = retweeted.constData()->id;
+
+        if (!retweetedById.contains(id)) {
+            QTweetStatusData *status = statusById.value(id);
+
+            // status pointing to itself, or to a retweet pointing back,
+            // would hold its own data and never be freed
+            if (status && status != data.at(i) && !status->retweetedStatus)
+                retweeted = QSharedDataPointer<QTweetStatusData>(status);
+
+            retweetedById.insert(id, retweeted);
+        } else {
+            retweeted = retweetedById.value(id);
+        }
+    }
+}
+
+/**
+ *  Replaces status user (and user of retweeted status) with pooled one
+ */
+void QTweetConvert::sharePooledUsers(QTweetStatus &status, QTweetUserPool *userPool)
+{
+    QTweetStatusData *d = status.d.data();
+
+    d->user = userPool->pooled(d->user);
+
+    // not shared yet, no detach
+    if (d->retweetedStatus) {
+        QTweetStatusData *retweeted = d->retweetedStatus.data();
+        retweeted->user = userPool->pooled(retweeted->user);
+    }
+}
+
+/**
+ *  Replaces sender and recipient with pooled ones
+ */
+void QTweetConvert::sharePooledUsers(QTweetDMStatus &directMessage, QTweetUserPool *userPool)
+{
+    QTweetDMStatusData *d = directMessage.d.data();
+
+    d->sender = userPool->pooled(d->sender);
+    d->recipient = userPool->pooled(d->recipient);
+}
+
+/**
+ *  Replaces user with pooled one
+ */
+void QTweetConvert::sharePooledUsers(QTweetUser &user, QTweetUserPool *userPool)
+{
+    user = userPool->pooled(user);
+}
+
+/**
+ *  Converts user through the pool
+ *  @param version id of the status or direct message carrying the user, 0 if unknown
+ *  @remarks Trimmed users (only id) and users converted with SkipNestedStatus
+ *           never replace pooled users
+ */
+QTweetUser QTweetConvert::jsonObjectToPooledUser(const QJsonObject &jsonObject, QTweetUserPool *userPool,
+                                                 qint64 version, Options options)
+{
+    if (options & UserIdOnly) {
+        QTweetUser user;
+        user.setId(static_cast<qint64>(jsonObject.value("id").toDouble()));
+        return user;
+    }
+
+    if (!userPool)
+        return jsonObjectToUser(jsonObject, 0, options);
+
+    qint64 userid = static_cast<qint64>(jsonObject.value("id").toDouble());
+    bool trimmed = !jsonObject.contains("name");
+
+    QTweetUser pooledUser;
+
+    if (userPool->find(userid, trimmed ? 0 : version, &pooledUser))
+        return pooledUser;
+
+    QTweetUser user = jsonObjectToUser(jsonObject, 0, options);
+
+    // user converted without status isn't complete either
+    if (trimmed || (options & SkipNestedStatus))
+        return user;
+
+    return userPool->insert(user, version);
 }
 
 /**
@@ -255,13 +679,14 @@ QList<QTweetList> QTweetConvert::jsonArrayToTweetLists(const QJsonArray& jsonArr
 QTweetSearchResult QTweetConvert::jsonObjectToSearchResult(const QJsonObject& jsonObject)
 {
     QTweetSearchResult result;
+    QTweetStringTable *strings = QTweetStringTable::instance();
 
     result.setCreatedAt(jsonObject["created_at"].toString());
     result.setFromUser(jsonObject["from_user"].toString());
     result.setId(static_cast<qint64>(jsonObject["id"].toDouble()));
-    result.setLang(jsonObject["iso_language_code"].toString());
-    result.setProfileImageUrl(jsonObject["profile_image_url"].toString());
-    result.setSource(jsonObject["source"].toString());
+    result.setLang(strings->intern(QTweetStringTable::Lang, jsonObject["iso_language_code"].toString()));
+    result.setProfileImageUrl(strings->intern(QTweetStringTable::ProfileImageUrl, jsonObject["profile_image_url"].toString()));
+    result.setSource(strings->intern(QTweetStringTable::Source, jsonObject["source"].toString()));
     result.setText(jsonObject["text"].toString());
     result.setToUser(jsonObject["to_user"].toString());
 
@@ -294,139 +719,176 @@ QTweetSearchPageResults QTweetConvert::jsonObjectToSearchPageResults(const QJson
     return page;
 }
 
-QTweetPlace QTweetConvert::jsonObjectToPlace(const QJsonObject& jsonObject)
+QList<QTweetStatus> QTweetConvert::jsonArrayToSearchStatusList(const QJsonArray &jsonArray, QTweetUserPool *userPool, Options options)
 {
-    QTweetPlace place;
+    return convertArray(jsonArray, jsonObjectToSearchStatus, userPool, options);
+}
 
-    place.setName(jsonObject["name"].toString());
-    place.setCountryCode(jsonObject["country_code"].toString());
-    place.setCountry(jsonObject["country"].toString());
-    place.setID(jsonObject["id"].toString());
-    place.setFullName(jsonObject["full_name"].toString());
+/**
+ *  Converts search result into status, so search and timelines share one representation
+ *  @param userPool when set, pooled user is used instead of the partial search user
+ *  @remarks Search payload has only screen name, name, id and profile image url of the user,
+ *           place is not converted
+ */
+QTweetStatus QTweetConvert::jsonObjectToSearchStatus(const QJsonObject &json, QTweetUserPool *userPool, Options options)
+{
+    QTweetStatus status;
+    QTweetStatusData *d = status.d.data();
+    QTweetStringTable *strings = QTweetStringTable::instance();
+
+    d->id = static_cast<qint64>(json.value("id").toDouble());
+    d->text = json.value("text").toString();
+    d->createdAt = searchDateToEpoch(json.value("created_at").toString());
+    d->source = strings->intern(QTweetStringTable::Source, json.value("source").toString());
+    d->inReplyToUserId = static_cast<qint64>(json.value("to_user_id").toDouble());
+    d->inReplyToScreenName = json.value("to_user").toString();
+    d->inReplyToStatusId = static_cast<qint64>(json.value("in_reply_to_status_id").toDouble());
+
+    qint64 userid = static_cast<qint64>(json.value("from_user_id").toDouble());
+
+    if (!userPool || !userPool->find(userid, 0, &d->user)) {
+        QTweetUserData *u = d->user.d.data();
+        u->id = userid;
+
+        if (!(options & UserIdOnly)) {
+            u->screenName = json.value("from_user").toString();
+            u->name = json.value("from_user_name").toString();
+            u->profileImageUrl = strings->intern(QTweetStringTable::ProfileImageUrl,
+                                                 json.value("profile_image_url").toString());
+        }
+    }
 
-    QString placeType = jsonObject["place_type"].toString();
+    if (!(options & SkipEntities) && json.contains("entities"))
+        appendEntities(d, json.value("entities").toObject());
 
-    if (placeType == "poi")
-        place.setType(QTweetPlace::Poi);
-    else if (placeType == "neighborhood")
-        place.setType(QTweetPlace::Neighborhood);
-    else if (placeType == "city")
-        place.setType(QTweetPlace::City);
-    else if (placeType == "admin")
-        place.setType(QTweetPlace::Admin);
-    else if (placeType == "country")
-        place.setType(QTweetPlace::Country);
-    else
-        place.setType(QTweetPlace::Neighborhood);   //twitter default
+    if (options & RenderRichText)
+        d->richText = QTweetTextRenderer::toHtml(status);
 
-    QJsonValue bbJsonValue = jsonObject["bounding_box"];
+    return status;
+}
 
-    if (!bbJsonValue.isNull()) {
-        QJsonObject bbJsonObject = bbJsonValue.toObject();
+/**
+ *  Converts already converted search result into status
+ *  @remarks Only fields of the search result are set
+ */
+QTweetStatus QTweetConvert::searchResultToStatus(const QTweetSearchResult &result)
+{
+    QTweetStatus status;
+    QTweetStatusData *d = status.d.data();
 
-        if (bbJsonObject["type"].toString() == "Polygon") {
-            QJsonArray coordList = bbJsonObject["coordinates"].toArray();
+    d->id = result.id();
+    d->text = result.text();
+    d->createdAt = result.createdAtEpoch();
+    d->source = result.source();
+    d->inReplyToScreenName = result.toUser();
 
-            if (coordList.count() == 1) {
-                QJsonArray latLongList = coordList[0].toArray();
+    QTweetUserData *u = d->user.d.data();
+    u->screenName = result.fromUser();
+    u->profileImageUrl = result.profileImageUrl();
 
-                if (latLongList.count() == 4) {
-                    QTweetGeoBoundingBox box;
+    return status;
+}
 
-                    QJsonArray coordsBottomLeft = latLongList[0].toArray();
-                    box.setBottomLeft(QTweetGeoCoord(coordsBottomLeft[1].toDouble(), coordsBottomLeft[0].toDouble()));
+static QTweetPlace::Type placeType(const QString& type)
+{
+    if (type == "poi")
+        return QTweetPlace::Poi;
+    else if (type == "neighborhood")
+        return QTweetPlace::Neighborhood;
+    else if (type == "city")
+        return QTweetPlace::City;
+    else if (type == "admin")
+        return QTweetPlace::Admin;
+    else if (type == "country")
+        return QTweetPlace::Country;
+
+    return QTweetPlace::Neighborhood;   //twitter default
+}
 
-                    QJsonArray coordsBottomRight = latLongList[1].toArray();
-                    box.setBottomRight(QTweetGeoCoord(coordsBottomRight[1].toDouble(), coordsBottomRight[0].toDouble()));
+static void setPlaceBoundingBox(QTweetPlace& place, const QJsonValue& bbJsonValue)
+{
+    if (bbJsonValue.isNull())
+        return;
 
-                    QJsonArray coordsTopRight = latLongList[2].toArray();
-                    box.setTopRight(QTweetGeoCoord(coordsTopRight[1].toDouble(), coordsTopRight[0].toDouble()));
+    QJsonObject bbJsonObject = bbJsonValue.toObject();
 
-                    QJsonArray coordsTopLeft = latLongList[3].toArray();
-                    box.setTopLeft(QTweetGeoCoord(coordsTopLeft[1].toDouble(), coordsTopLeft[0].toDouble()));
+    if (bbJsonObject.value("type").toString() != "Polygon")
+        return;
 
-                    place.setBoundingBox(box);
-                }
-            }
-        }
-    }
-    return place;
-}
+    QJsonArray coordList = bbJsonObject.value("coordinates").toArray();
 
-//not to be used in timelines api, but in geo api, where place contains other places
-//is it recursive responsive?
-QTweetPlace QTweetConvert::jsonObjectToPlaceRecursive(const QJsonObject& jsonObject)
-{
-    QTweetPlace place;
+    if (coordList.count() != 1)
+        return;
 
-    place.setName(jsonObject["name"].toString());
-    place.setCountryCode(jsonObject["country_code"].toString());
-    place.setCountry(jsonObject["country"].toString());
-    place.setID(jsonObject["id"].toString());
-    place.setFullName(jsonObject["full_name"].toString());
+    QJsonArray latLongList = coordList.at(0).toArray();
 
-    QString placeType = jsonObject["place_type"].toString();
+    if (latLongList.count() != 4)
+        return;
 
-    if (placeType == "poi")
-        place.setType(QTweetPlace::Poi);
-    else if (placeType == "neighborhood")
-        place.setType(QTweetPlace::Neighborhood);
-    else if (placeType == "city")
-        place.setType(QTweetPlace::City);
-    else if (placeType == "admin")
-        place.setType(QTweetPlace::Admin);
-    else if (placeType == "country")
-        place.setType(QTweetPlace::Country);
-    else
-        place.setType(QTweetPlace::Neighborhood);   //twitter default
+    QTweetGeoBoundingBox box;
 
-    QJsonValue bbVar = jsonObject["bounding_box"];
+    QJsonArray coordsBottomLeft = latLongList.at(0).toArray();
+    box.setBottomLeft(QTweetGeoCoord(coordsBottomLeft.at(1).toDouble(), coordsBottomLeft.at(0).toDouble()));
 
-    if (!bbVar.isNull()) {
-        QJsonObject bbObject = bbVar.toObject();
+    QJsonArray coordsBottomRight = latLongList.at(1).toArray();
+    box.setBottomRight(QTweetGeoCoord(coordsBottomRight.at(1).toDouble(), coordsBottomRight.at(0).toDouble()));
 
-        if (bbObject["type"].toString() == "Polygon") {
-            QJsonArray coordList = bbObject["coordinates"].toArray();
+    QJsonArray coordsTopRight = latLongList.at(2).toArray();
+    box.setTopRight(QTweetGeoCoord(coordsTopRight.at(1).toDouble(), coordsTopRight.at(0).toDouble()));
 
-            if (coordList.count() == 1) {
-                QJsonArray latLongList = coordList[0].toArray();
+    QJsonArray coordsTopLeft = latLongList.at(3).toArray();
+    box.setTopLeft(QTweetGeoCoord(coordsTopLeft.at(1).toDouble(), coordsTopLeft.at(0).toDouble()));
 
-                if (latLongList.count() == 4) {
-                    QTweetGeoBoundingBox box;
+    place.setBoundingBox(box);
+}
 
-                    QJsonArray coordsBottomLeft = latLongList[0].toArray();
-                    box.setBottomLeft(QTweetGeoCoord(coordsBottomLeft[1].toDouble(), coordsBottomLeft[0].toDouble()));
+/**
+ *  Converts place and places it is contained within into nodes of the place graph
+ *  @remarks Place already in the graph is returned without conversion
+ */
+QTweetPlace QTweetConvert::jsonObjectToPlace(const QJsonObject& jsonObject)
+{
+    QTweetPlaceGraph *graph = QTweetPlaceGraph::instance();
 
-                    QJsonArray coordsBottomRight = latLongList[1].toArray();
-                    box.setBottomRight(QTweetGeoCoord(coordsBottomRight[1].toDouble(), coordsBottomRight[0].toDouble()));
+    QString id = jsonObject.value("id").toString();
+    QJsonArray containedArray = jsonObject.value("contained_within").toArray();
 
-                    QJsonArray coordsTopRight = latLongList[2].toArray();
-                    box.setTopRight(QTweetGeoCoord(coordsTopRight[1].toDouble(), coordsTopRight[0].toDouble()));
+    QTweetPlace place;
 
-                    QJsonArray coordsTopLeft = latLongList[3].toArray();
-                    box.setTopLeft(QTweetGeoCoord(coordsTopLeft[1].toDouble(), coordsTopLeft[0].toDouble()));
+    // full place object is converted, so node is refreshed with its data
+    if (containedArray.isEmpty() && graph->find(id, &place))
+        return place;
 
-                    place.setBoundingBox(box);
-                }
-            }
-        }
-    }
+    QTweetStringTable *strings = QTweetStringTable::instance();
 
-    QJsonArray containedArray = jsonObject["contained_within"].toArray();
+    place.setName(jsonObject.value("name").toString());
+    place.setCountryCode(strings->intern(QTweetStringTable::CountryCode, jsonObject.value("country_code").toString()));
+    place.setCountry(strings->intern(QTweetStringTable::Country, jsonObject.value("country").toString()));
+    place.setID(id);
+    place.setFullName(jsonObject.value("full_name").toString());
+    place.setType(placeType(jsonObject.value("place_type").toString()));
 
-    QList<QTweetPlace> containedInPlacesList;
+    setPlaceBoundingBox(place, jsonObject.value("bounding_box"));
 
     if (!containedArray.isEmpty()) {
-        for (int i = 0; i < containedArray.size(); ++i) {
-            QTweetPlace containedPlace = jsonObjectToPlaceRecursive(containedArray[i].toObject());
+        QList<QTweetPlace> containedInPlacesList;
+        containedInPlacesList.reserve(containedArray.size());
 
-            containedInPlacesList.append(containedPlace);
-        }
+        for (int i = 0; i < containedArray.size(); ++i)
+            containedInPlacesList.append(jsonObjectToPlace(containedArray.at(i).toObject()));
+
+        place.setContainedWithin(containedInPlacesList);
     }
 
-    place.setContainedWithin(containedInPlacesList);
+    return graph->insert(place);
+}
 
-    return place;
+/**
+ *  Same as jsonObjectToPlace, kept for compatibility
+ */
+QTweetPlace QTweetConvert::jsonObjectToPlaceRecursive(const QJsonObject& jsonObject)
+{
+    return jsonObjectToPlace(jsonObject);
 }
 
 QList<QTweetPlace> QTweetConvert::jsonObjectToPlaceList(const QJsonObject& jsonObject)
@@ -537,3 +999,48 @@ QTweetEntityMedia QTweetConvert::jsonObjectToEntityMedia(const QJsonObject &json
 
     return entityMedia;
 }
+
+/**
+ *  Converts date from REST API to seconds since epoch
+ *  @param twitterDate date in 'Wed Sep 01 11:27:25 +0000 2010' format
+ *  @return seconds since epoch (UTC), InvalidEpoch if date is not valid
+ *  @remarks Doesn't allocate and doesn't depend on locale
+ */
+qint64 QTweetConvert::twitterDateToEpoch(const QString &twitterDate)
+{
+    return ::twitterDateToEpoch(twitterDate.constData(), twitterDate.size());
+}
+
+/**
+ *  Converts date from Search API to seconds since epoch
+ *  @param searchDate date in 'Mon, 04 Oct 2010 12:51:42 +0000' format
+ *  @return seconds since epoch (UTC), InvalidEpoch if date is not valid
+ */
+qint64 QTweetConvert::searchDateToEpoch(const QString &searchDate)
+{
+    return ::searchDateToEpoch(searchDate.constData(), searchDate.size());
+}
+
+/**
+ *  Converts date time to seconds since epoch
+ *  @return InvalidEpoch for invalid date time
+ */
+qint64 QTweetConvert::dateTimeToEpoch(const QDateTime &dateTime)
+{
+    if (!dateTime.isValid())
+        return InvalidEpoch;
+
+    return dateTime.toMSecsSinceEpoch() / 1000;
+}
+
+/**
+ *  Converts seconds since epoch to UTC date time
+ *  @return invalid date time for InvalidEpoch
+ */
+QDateTime QTweetConvert::epochToDateTime(qint64 epoch)
+{
+    if (epoch == InvalidEpoch)
+        return QDateTime();
+
+    return QDateTime::fromMSecsSinceEpoch(epoch * 1000).toUTC();
+}
@@ -19,8 +19,10 @@
 #define QTWEETCONVERT_H
 
 #include <QList>
+#include <QFlags>
 
 class QTweetStatus;
+class QTweetStatusBatch;
 class QTweetUser;
 class QTweetDMStatus;
 class QTweetList;
@@ -31,7 +33,9 @@ class QTweetEntityUrl;
 class QTweetEntityHashtag;
 class QTweetEntityUserMentions;
 class QTweetEntityMedia;
+class QTweetUserPool;
 
+class QDateTime;
 class QJsonArray;
 class QJsonObject;
 
@@ -41,16 +45,39 @@ class QJsonObject;
 class QTweetConvert
 {
 public:
-    static QList<QTweetStatus> jsonArrayToStatusList(const QJsonArray& jsonArray);
-    static QTweetStatus jsonObjectToStatus(const QJsonObject& jsonObject);
-    static QTweetUser jsonObjectToUser(const QJsonObject& jsonObject);
-    static QList<QTweetDMStatus> jsonArrayToDirectMessagesList(const QJsonArray& jsonArray);
-    static QTweetDMStatus jsonObjectToDirectMessage(const QJsonObject& jsonObject);
-    static QTweetList jsonObjectToTweetList(const QJsonObject& jsonObject);
-    static QList<QTweetUser> jsonArrayToUserInfoList(const QJsonArray& jsonArray);
-    static QList<QTweetList> jsonArrayToTweetLists(const QJsonArray& jsonArray);
+    /** Epoch value of invalid or missing date */
+    static const qint64 InvalidEpoch = Q_INT64_C(-9223372036854775807) - 1;
+
+    /**
+     *  Parts of the payload converters skip. UserIdOnly applies to users
+     *  embedded in statuses, direct messages and lists, not to top level users.
+     *  RenderRichText caches QTweetTextRenderer output on converted statuses.
+     */
+    enum Option {
+        NoOptions = 0,
+        SkipEntities = 0x1,
+        SkipPlace = 0x2,
+        UserIdOnly = 0x4,
+        SkipNestedStatus = 0x8,
+        SkipRetweetedStatus = 0x10,
+        RenderRichText = 0x20
+    };
+    Q_DECLARE_FLAGS(Options, Option)
+
+    static QList<QTweetStatus> jsonArrayToStatusList(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetStatusBatch jsonArrayToStatusBatch(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetStatus jsonObjectToStatus(const QJsonObject& jsonObject, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetUser jsonObjectToUser(const QJsonObject& jsonObject, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QList<QTweetDMStatus> jsonArrayToDirectMessagesList(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetDMStatus jsonObjectToDirectMessage(const QJsonObject& jsonObject, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetList jsonObjectToTweetList(const QJsonObject& jsonObject, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QList<QTweetUser> jsonArrayToUserInfoList(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QList<QTweetList> jsonArrayToTweetLists(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
     static QTweetSearchResult jsonObjectToSearchResult(const QJsonObject& var);
     static QTweetSearchPageResults jsonObjectToSearchPageResults(const QJsonObject& jsonObject);
+    static QList<QTweetStatus> jsonArrayToSearchStatusList(const QJsonArray& jsonArray, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetStatus jsonObjectToSearchStatus(const QJsonObject& jsonObject, QTweetUserPool *userPool = 0, Options options = NoOptions);
+    static QTweetStatus searchResultToStatus(const QTweetSearchResult& result);
     static QTweetPlace jsonObjectToPlace(const QJsonObject& var);
     static QTweetPlace jsonObjectToPlaceRecursive(const QJsonObject& jsonObject);
     static QList<QTweetPlace> jsonObjectToPlaceList(const QJsonObject& jsonObject);
@@ -58,6 +85,21 @@ public:
     static QTweetEntityHashtag jsonObjectToEntityHashtag(const QJsonObject &jsonObject);
     static QTweetEntityUserMentions jsonObjectToEntityUserMentions(const QJsonObject& jsonObject);
     static QTweetEntityMedia jsonObjectToEntityMedia(const QJsonObject& jsonObject);
+    static qint64 twitterDateToEpoch(const QString& twitterDate);
+    static qint64 searchDateToEpoch(const QString& searchDate);
+    static qint64 dateTimeToEpoch(const QDateTime& dateTime);
+    static QDateTime epochToDateTime(qint64 epoch);
+    static void setParallelThreshold(int count);
+    static int parallelThreshold();
+
+private:
+    static void shareRetweetedStatuses(QList<QTweetStatus>& statuses);
+    static void sharePooledUsers(QTweetStatus& status, QTweetUserPool *userPool);
+    static void sharePooledUsers(QTweetDMStatus& directMessage, QTweetUserPool *userPool);
+    static void sharePooledUsers(QTweetUser& user, QTweetUserPool *userPool);
+    static QTweetUser jsonObjectToPooledUser(const QJsonObject& jsonObject, QTweetUserPool *userPool, qint64 version, Options options);
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QTweetConvert::Options)
+
 #endif // QTWEETCONVERT_H
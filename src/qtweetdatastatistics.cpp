@@ -0,0 +1,85 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QAtomicInt>
+#include "qtweetdatastatistics.h"
+
+static QBasicAtomicInt allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInt detachCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInt refCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/**
+ *  Checks if the library counts data objects
+ */
+bool QTweetDataStatistics::isEnabled()
+{
+#ifdef QTWEETLIB_DATA_STATISTICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  Gets number of data objects constructed, copies made by detach included
+ */
+int QTweetDataStatistics::allocations()
+{
+    return allocationCount;
+}
+
+/**
+ *  Gets number of data objects copied because shared one was changed
+ */
+int QTweetDataStatistics::detaches()
+{
+    return detachCount;
+}
+
+/**
+ *  Gets number of value object copies sharing data, each one is a ref count increment.
+ *  Moves and swaps aren't counted
+ */
+int QTweetDataStatistics::refs()
+{
+    return refCount;
+}
+
+/**
+ *  Sets all counters to 0
+ */
+void QTweetDataStatistics::reset()
+{
+    allocationCount.fetchAndStoreRelaxed(0);
+    detachCount.fetchAndStoreRelaxed(0);
+    refCount.fetchAndStoreRelaxed(0);
+}
+
+void QTweetDataStatistics::countAllocation()
+{
+    allocationCount.ref();
+}
+
+void QTweetDataStatistics::countDetach()
+{
+    detachCount.ref();
+}
+
+void QTweetDataStatistics::countRef()
+{
+    refCount.ref();
+}
@@ -0,0 +1,44 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETDATASTATISTICS_H
+#define QTWEETDATASTATISTICS_H
+
+#include "qtweetlib_global.h"
+
+/**
+ *  Counters of data objects of QTweetStatus, QTweetUser and QTweetDMStatus
+ *
+ *  Counted only when the library is built with QTWEETLIB_DATA_STATISTICS defined
+ *  (CONFIG += data_statistics with qmake, -DQTWEETLIB_DATA_STATISTICS=ON with CMake),
+ *  otherwise counters stay 0. Used by the footprint example to compare converters.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetDataStatistics
+{
+public:
+    static bool isEnabled();
+    static int allocations();
+    static int detaches();
+    static int refs();
+    static void reset();
+
+    static void countAllocation();
+    static void countDetach();
+    static void countRef();
+};
+
+#endif // QTWEETDATASTATISTICS_H
@@ -0,0 +1,56 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETDATASTATISTICS_P_H
+#define QTWEETDATASTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+//  This file is not part of the QTweetLib API. It's used by the value classes
+//  to count their data objects and may change without notice.
+//
+
+#include "qtweetdatastatistics.h"
+
+#ifdef QTWEETLIB_DATA_STATISTICS
+
+// Member of data classes, counts their construction and copies made by detach
+struct QTweetDataCounter
+{
+    QTweetDataCounter() { QTweetDataStatistics::countAllocation(); }
+
+    QTweetDataCounter(const QTweetDataCounter&)
+    {
+        QTweetDataStatistics::countAllocation();
+        QTweetDataStatistics::countDetach();
+    }
+
+    QTweetDataCounter& operator=(const QTweetDataCounter&) { return *this; }
+};
+
+// copy of value object, one ref count increment of its data
+#define QTWEET_COUNT_REF() QTweetDataStatistics::countRef()
+
+#else
+
+#define QTWEET_COUNT_REF()
+
+#endif // QTWEETLIB_DATA_STATISTICS
+
+#endif // QTWEETDATASTATISTICS_P_H
@@ -53,8 +53,8 @@ void QTweetDirectMessageDestroy::destroyMessage(qint64 id, bool includeEntities)
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/direct_messages/destroy.json");
-    QUrl urlQuery("https://api.twitter.com/1.1/direct_messages/destroy.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/destroy.json");
+    QUrl urlQuery = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/destroy.json");
 
     urlQuery.addQueryItem("id", QString::number(id));
 
@@ -70,14 +70,13 @@ void QTweetDirectMessageDestroy::destroyMessage(qint64 id, bool includeEntities)
     QByteArray statusPost = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     statusPost.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, statusPost);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, statusPost);
 }
 
 void QTweetDirectMessageDestroy::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetDMStatus dm = QTweetConvert::jsonObjectToDirectMessage(jsonDoc.object());
+        QTweetDMStatus dm = QTweetConvert::jsonObjectToDirectMessage(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedDirectMessage(dm);
     }
@@ -57,7 +57,7 @@ void QTweetDirectMessageNew::post(qint64 user,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1.1/direct_messages/new.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/new.json");
 
     QUrl urlQuery(url);
 
@@ -75,8 +75,7 @@ void QTweetDirectMessageNew::post(qint64 user,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 /**
@@ -92,7 +91,7 @@ void QTweetDirectMessageNew::post(const QString &screenName, const QString &text
         return;
     }
 
-    QUrl url("http://api.twitter.com/1.1/direct_messages/new.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/new.json");
 
     QUrl urlQuery(url);
 
@@ -111,14 +110,13 @@ void QTweetDirectMessageNew::post(const QString &screenName, const QString &text
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetDirectMessageNew::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetDMStatus dm = QTweetConvert::jsonObjectToDirectMessage(jsonDoc.object());
+        QTweetDMStatus dm = QTweetConvert::jsonObjectToDirectMessage(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedDirectMessage(dm);
     }
@@ -60,7 +60,7 @@ void QTweetDirectMessages::fetch(qint64 sinceid,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/direct_messages.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages.json");
 
     if (sinceid != 0)
         url.addQueryItem("since_id", QString::number(sinceid));
@@ -79,14 +79,13 @@ void QTweetDirectMessages::fetch(qint64 sinceid,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetDirectMessages::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDoc.array());
+        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedDirectMessages(directMessages);
     }
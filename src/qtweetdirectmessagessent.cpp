@@ -62,7 +62,7 @@ void QTweetDirectMessagesSent::fetch(qint64 sinceid,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/direct_messages/sent.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/sent.json");
 
     if (sinceid)
         url.addQueryItem("since_id", QString::number(sinceid));
@@ -84,14 +84,13 @@ void QTweetDirectMessagesSent::fetch(qint64 sinceid,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetDirectMessagesSent::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDoc.array());
+        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedDirectMessages(directMessages);
     }
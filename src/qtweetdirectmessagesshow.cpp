@@ -56,7 +56,7 @@ void QTweetDirectMessagesShow::fetch(qint64 id)
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/direct_messages/show.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "direct_messages/show.json");
     url.addQueryItem("id", QString::number(id));
 
     QNetworkRequest req(url);
@@ -64,14 +64,13 @@ void QTweetDirectMessagesShow::fetch(qint64 id)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetDirectMessagesShow::parseJsonFinished(const QJsonDocument &jsonDocument)
 {
     if (jsonDocument.isArray()) {
-        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDocument.array());
+        QList<QTweetDMStatus> directMessages = QTweetConvert::jsonArrayToDirectMessagesList(jsonDocument.array(), userPool(), convertOptions());
 
         if (directMessages.size())
             emit parsedDirectMessage(directMessages.at(0));
@@ -15,24 +15,10 @@
  * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
  */
 
-#include <QSharedData>
 #include <QDateTime>
 #include "qtweetuser.h"
-#include "qtweetdmstatus.h"
-
-class QTweetDMStatusData : public QSharedData
-{
-public:
-    QDateTime createdAt;
-    QString senderScreenName;
-    QTweetUser sender;
-    QString text;
-    QString recipientScreenName;
-    qint64 id;
-    QTweetUser recipient;
-    qint64 recipientId;
-    qint64 senderId;
-};
+#include "qtweetdmstatus_p.h"
+#include "qtweetconvert.h"
 
 QTweetDMStatus::QTweetDMStatus() :
         d(new QTweetDMStatusData)
@@ -42,12 +28,15 @@ QTweetDMStatus::QTweetDMStatus() :
 QTweetDMStatus::QTweetDMStatus(const QTweetDMStatus &other) :
         d(other.d)
 {
+    QTWEET_COUNT_REF();
 }
 
 QTweetDMStatus& QTweetDMStatus::operator =(const QTweetDMStatus &other)
 {
-    if (this != &other)
+    if (this != &other) {
+        QTWEET_COUNT_REF();
         d.operator =(other.d);
+    }
     return *this;
 }
 
@@ -55,17 +44,57 @@ QTweetDMStatus::~QTweetDMStatus()
 {
 }
 
+void QTweetDMStatus::swap(QTweetDMStatus &other)
+{
+    d.swap(other.d);
+}
+
+void QTweetDMStatus::moveSenderScreenName(QString &screenName)
+{
+    d->senderScreenName.swap(screenName);
+}
+
+void QTweetDMStatus::moveSender(QTweetUser &sender)
+{
+    d->sender.swap(sender);
+}
+
+void QTweetDMStatus::moveText(QString &text)
+{
+    d->text.swap(text);
+}
+
+void QTweetDMStatus::moveRecipientScreenName(QString &screenName)
+{
+    d->recipientScreenName.swap(screenName);
+}
+
+void QTweetDMStatus::moveRecipient(QTweetUser &recipient)
+{
+    d->recipient.swap(recipient);
+}
+
 void QTweetDMStatus::setCreatedAt(const QString &twitterDate)
 {
-    d->createdAt = QTweetUser::twitterDateToQDateTime(twitterDate);
+    d->createdAt = QTweetConvert::twitterDateToEpoch(twitterDate);
 }
 
 void QTweetDMStatus::setCreatedAt(const QDateTime &datetime)
 {
-    d->createdAt = datetime;
+    d->createdAt = QTweetConvert::dateTimeToEpoch(datetime);
 }
 
 QDateTime QTweetDMStatus::createdAt() const
+{
+    return QTweetConvert::epochToDateTime(d->createdAt);
+}
+
+void QTweetDMStatus::setCreatedAtEpoch(qint64 secs)
+{
+    d->createdAt = secs;
+}
+
+qint64 QTweetDMStatus::createdAtEpoch() const
 {
     return d->createdAt;
 }
@@ -22,6 +22,7 @@
 #include <QSharedDataPointer>
 #include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetUser;
 class QTweetDMStatusData;
 
@@ -35,10 +36,13 @@ public:
     QTweetDMStatus(const QTweetDMStatus& other);
     QTweetDMStatus& operator=(const QTweetDMStatus& other);
     ~QTweetDMStatus();
+    void swap(QTweetDMStatus& other);
 
     void setCreatedAt(const QString& twitterDate);
     void setCreatedAt(const QDateTime& datetime);
     QDateTime createdAt() const;
+    void setCreatedAtEpoch(qint64 secs);
+    qint64 createdAtEpoch() const;
     void setSenderScreenName(const QString& screenName);
     QString senderScreenName() const;
     void setSender(const QTweetUser& sender);
@@ -56,10 +60,32 @@ public:
     void setSenderId(qint64 id);
     qint64 senderId() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetDMStatus &operator=(QTweetDMStatus &&other) { swap(other); return *this; }
+    void setSenderScreenName(QString&& screenName) { moveSenderScreenName(screenName); }
+    void setSender(QTweetUser&& sender) { moveSender(sender); }
+    void setText(QString&& text) { moveText(text); }
+    void setRecipientScreenName(QString&& screenName) { moveRecipientScreenName(screenName); }
+    void setRecipient(QTweetUser&& recipient) { moveRecipient(recipient); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveSenderScreenName(QString& screenName);
+    void moveSender(QTweetUser& sender);
+    void moveText(QString& text);
+    void moveRecipientScreenName(QString& screenName);
+    void moveRecipient(QTweetUser& recipient);
+
+    friend class QTweetConvert;   // fills data in place
+
     QSharedDataPointer<QTweetDMStatusData> d;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetDMStatus& directMessage);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetDMStatus& directMessage);
+
 Q_DECLARE_METATYPE(QTweetDMStatus)
 
 #endif // QTWEETDMSTATUS_H
@@ -0,0 +1,51 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETDMSTATUS_P_H
+#define QTWEETDMSTATUS_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by the converters
+//  to fill data in place and may change without notice.
+//
+
+#include <QSharedData>
+#include <QString>
+#include "qtweetuser.h"
+#include "qtweetconvert.h"
+#include "qtweetdatastatistics_p.h"
+
+class QTweetDMStatusData : public QSharedData
+{
+public:
+    QTweetDMStatusData() : createdAt(QTweetConvert::InvalidEpoch) {}
+
+    qint64 createdAt;   // seconds since epoch
+    QString senderScreenName;
+    QTweetUser sender;
+    QString text;
+    QString recipientScreenName;
+    qint64 id;
+    QTweetUser recipient;
+    qint64 recipientId;
+    qint64 senderId;
+#ifdef QTWEETLIB_DATA_STATISTICS
+    QTweetDataCounter counter;
+#endif
+};
+
+#endif // QTWEETDMSTATUS_P_H
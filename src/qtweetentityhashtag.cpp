@@ -48,6 +48,16 @@ QTweetEntityHashtag::~QTweetEntityHashtag()
 {
 }
 
+void QTweetEntityHashtag::swap(QTweetEntityHashtag &other)
+{
+    data.swap(other.data);
+}
+
+void QTweetEntityHashtag::moveText(QString &text)
+{
+    data->hashtag.swap(text);
+}
+
 void QTweetEntityHashtag::setText(const QString &text)
 {
     data->hashtag = text;
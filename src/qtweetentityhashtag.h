@@ -19,7 +19,9 @@
 #define QTWEETENTITYHASHTAG_H
 
 #include <QSharedDataPointer>
+#include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetEntityHashtagData;
 
 class QTweetEntityHashtag
@@ -29,6 +31,7 @@ public:
     QTweetEntityHashtag(const QTweetEntityHashtag &);
     QTweetEntityHashtag &operator=(const QTweetEntityHashtag &);
     ~QTweetEntityHashtag();
+    void swap(QTweetEntityHashtag &other);
 
     void setText(const QString& text);
     QString text() const;
@@ -37,8 +40,20 @@ public:
     void setHigherIndex(int index);
     int higherIndex() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetEntityHashtag &operator=(QTweetEntityHashtag &&other) { swap(other); return *this; }
+    void setText(QString&& text) { moveText(text); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveText(QString& text);
+
     QSharedDataPointer<QTweetEntityHashtagData> data;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetEntityHashtag& entity);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetEntityHashtag& entity);
+
 #endif // QTWEETENTITYHASHTAG_H
@@ -61,6 +61,41 @@ QTweetEntityMedia::~QTweetEntityMedia()
 {
 }
 
+void QTweetEntityMedia::swap(QTweetEntityMedia &other)
+{
+    data.swap(other.data);
+}
+
+void QTweetEntityMedia::moveID(QString &id)
+{
+    data->id.swap(id);
+}
+
+void QTweetEntityMedia::moveMediaUrl(QString &url)
+{
+    data->mediaUrl.swap(url);
+}
+
+void QTweetEntityMedia::moveMediaUrlHttps(QString &url)
+{
+    data->mediaUrlHttps.swap(url);
+}
+
+void QTweetEntityMedia::moveUrl(QString &url)
+{
+    data->url.swap(url);
+}
+
+void QTweetEntityMedia::moveDisplayUrl(QString &url)
+{
+    data->displayUrl.swap(url);
+}
+
+void QTweetEntityMedia::moveExpandedUrl(QString &url)
+{
+    data->expandedUrl.swap(url);
+}
+
 void QTweetEntityMedia::setID(const QString &id)
 {
     data->id = id;
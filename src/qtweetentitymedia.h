@@ -19,7 +19,9 @@
 #define QTWEETENTITYMEDIA_H
 
 #include <QSharedDataPointer>
+#include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetEntityMediaData;
 class QSize;
 
@@ -30,6 +32,7 @@ public:
     QTweetEntityMedia(const QTweetEntityMedia& );
     QTweetEntityMedia & operator = (const QTweetEntityMedia& );
     ~QTweetEntityMedia();
+    void swap(QTweetEntityMedia &other);
 
     enum MediaSize {
         LARGE,
@@ -65,8 +68,30 @@ public:
     void setLowerIndex(int index);
     int lowerIndex() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetEntityMedia &operator=(QTweetEntityMedia &&other) { swap(other); return *this; }
+    void setID(QString&& id) { moveID(id); }
+    void setMediaUrl(QString&& url) { moveMediaUrl(url); }
+    void setMediaUrlHttps(QString&& url) { moveMediaUrlHttps(url); }
+    void setUrl(QString&& url) { moveUrl(url); }
+    void setDisplayUrl(QString&& url) { moveDisplayUrl(url); }
+    void setExpandedUrl(QString&& url) { moveExpandedUrl(url); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveID(QString& id);
+    void moveMediaUrl(QString& url);
+    void moveMediaUrlHttps(QString& url);
+    void moveUrl(QString& url);
+    void moveDisplayUrl(QString& url);
+    void moveExpandedUrl(QString& url);
+
     QSharedDataPointer<QTweetEntityMediaData> data;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetEntityMedia& entity);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetEntityMedia& entity);
+
 #endif // QTWEETENTITYMEDIA_H
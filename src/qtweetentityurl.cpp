@@ -53,6 +53,26 @@ QTweetEntityUrl::~QTweetEntityUrl()
 {
 }
 
+void QTweetEntityUrl::swap(QTweetEntityUrl &other)
+{
+    data.swap(other.data);
+}
+
+void QTweetEntityUrl::moveDisplayUrl(QString &url)
+{
+    data->displayUrl.swap(url);
+}
+
+void QTweetEntityUrl::moveUrl(QString &url)
+{
+    data->url.swap(url);
+}
+
+void QTweetEntityUrl::moveExpandedUrl(QString &url)
+{
+    data->expandedUrl.swap(url);
+}
+
 void QTweetEntityUrl::setDisplayUrl(const QString &url)
 {
     data->displayUrl = url;
@@ -75,12 +95,12 @@ QString QTweetEntityUrl::url() const
 
 void QTweetEntityUrl::setExpandedUrl(const QString &url)
 {
-    data->url = url;
+    data->expandedUrl = url;
 }
 
 QString QTweetEntityUrl::expandedUrl() const
 {
-    return data->url;
+    return data->expandedUrl;
 }
 
 void QTweetEntityUrl::setLowerIndex(int index)
@@ -19,7 +19,9 @@
 #define QTWEETENTITYURL_H
 
 #include <QSharedDataPointer>
+#include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetEntityUrlData;
 
 class QTweetEntityUrl
@@ -29,6 +31,7 @@ public:
     QTweetEntityUrl(const QTweetEntityUrl &);
     QTweetEntityUrl &operator=(const QTweetEntityUrl &);
     ~QTweetEntityUrl();
+    void swap(QTweetEntityUrl &other);
 
     void setDisplayUrl(const QString& url);
     QString displayUrl() const;
@@ -41,8 +44,24 @@ public:
     void setHigherIndex(int index);
     int higherIndex() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetEntityUrl &operator=(QTweetEntityUrl &&other) { swap(other); return *this; }
+    void setDisplayUrl(QString&& url) { moveDisplayUrl(url); }
+    void setUrl(QString&& url) { moveUrl(url); }
+    void setExpandedUrl(QString&& url) { moveExpandedUrl(url); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveDisplayUrl(QString& url);
+    void moveUrl(QString& url);
+    void moveExpandedUrl(QString& url);
+
     QSharedDataPointer<QTweetEntityUrlData> data;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetEntityUrl& entity);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetEntityUrl& entity);
+
 #endif // QTWEETENTITYURL_H
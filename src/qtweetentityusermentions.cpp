@@ -52,6 +52,21 @@ QTweetEntityUserMentions::~QTweetEntityUserMentions()
 {
 }
 
+void QTweetEntityUserMentions::swap(QTweetEntityUserMentions &other)
+{
+    data.swap(other.data);
+}
+
+void QTweetEntityUserMentions::moveScreenName(QString &screenName)
+{
+    data->screenName.swap(screenName);
+}
+
+void QTweetEntityUserMentions::moveName(QString &name)
+{
+    data->name.swap(name);
+}
+
 void QTweetEntityUserMentions::setScreenName(const QString &screenName)
 {
     data->screenName = screenName;
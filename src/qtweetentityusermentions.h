@@ -19,7 +19,9 @@
 #define QTWEETENTITYUSERMENTIONS_H
 
 #include <QSharedDataPointer>
+#include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetEntityUserMentionsData;
 
 class QTweetEntityUserMentions
@@ -29,6 +31,7 @@ public:
     QTweetEntityUserMentions(const QTweetEntityUserMentions &);
     QTweetEntityUserMentions &operator=(const QTweetEntityUserMentions &);
     ~QTweetEntityUserMentions();
+    void swap(QTweetEntityUserMentions &other);
 
     void setScreenName(const QString& screenName);
     QString screenName() const;
@@ -41,8 +44,22 @@ public:
     void setHigherIndex(int index);
     int higherIndex() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetEntityUserMentions &operator=(QTweetEntityUserMentions &&other) { swap(other); return *this; }
+    void setScreenName(QString&& screenName) { moveScreenName(screenName); }
+    void setName(QString&& name) { moveName(name); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveScreenName(QString& screenName);
+    void moveName(QString& name);
+
     QSharedDataPointer<QTweetEntityUserMentionsData> data;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetEntityUserMentions& entity);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetEntityUserMentions& entity);
+
 #endif // QTWEETENTITYUSERMENTIONS_H
@@ -20,6 +20,7 @@
 #include <QNetworkReply>
 #include "qtweetfavorites.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonarray.h"
@@ -58,9 +59,9 @@ void QTweetFavorites::fetch(qint64 id, int page, bool includeEntities)
     QUrl url;
 
     if (id) {
-        url.setUrl(QString("http://api.twitter.com/1/favorites/%1.json").arg(id));
+        url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("favorites/%1.json").arg(id));
     } else {
-        url.setUrl("http://api.twitter.com/1/favorites.json");
+        url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "favorites.json");
     }
 
     if (page)
@@ -74,14 +75,18 @@ void QTweetFavorites::fetch(qint64 id, int page, bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetFavorites::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array());
+        if (isStatusBatchEnabled()) {
+            emit parsedStatusBatch(QTweetConvert::jsonArrayToStatusBatch(jsonDoc.array(), userPool(), convertOptions()));
+            return;
+        }
+
+        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedFavorites(statuses);
     }
@@ -54,7 +54,7 @@ void QTweetFavoritesCreate::create(qint64 statusid, bool includeEntities)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/favorites/create/%1.json").arg(statusid));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("favorites/create/%1.json").arg(statusid));
 
     if (includeEntities)
         url.addQueryItem("include_entities", "true");
@@ -65,14 +65,13 @@ void QTweetFavoritesCreate::create(qint64 statusid, bool includeEntities)
     req.setRawHeader(AUTH_HEADER, oauthHeader);
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, QByteArray());
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, QByteArray());
 }
 
 void QTweetFavoritesCreate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedStatus(status);
     }
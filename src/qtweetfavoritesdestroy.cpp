@@ -54,7 +54,7 @@ void QTweetFavoritesDestroy::unfavorite(qint64 statusid, bool includeEntities)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/favorites/destroy/%1.json").arg(statusid));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("favorites/destroy/%1.json").arg(statusid));
 
     if (includeEntities)
         url.addQueryItem("include_entities", "true");
@@ -64,14 +64,13 @@ void QTweetFavoritesDestroy::unfavorite(qint64 statusid, bool includeEntities)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::DELETE);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->deleteResource(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startDelete(req);
 }
 
 void QTweetFavoritesDestroy::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedStatus(status);
     }
@@ -48,7 +48,7 @@ QTweetFollowersID::QTweetFollowersID(OAuthTwitter *oauthTwitter, QObject *parent
  */
 void QTweetFollowersID::fetch(qint64 user, const QString &cursor)
 {
-    QUrl url("http://api.twitter.com/1/followers/ids.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "followers/ids.json");
 
     url.addQueryItem("user_id", QString::number(user));
     url.addQueryItem("cursor", cursor);
@@ -60,8 +60,7 @@ void QTweetFollowersID::fetch(qint64 user, const QString &cursor)
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 /**
@@ -71,7 +70,7 @@ void QTweetFollowersID::fetch(qint64 user, const QString &cursor)
  */
 void QTweetFollowersID::fetch(const QString &screenName, const QString &cursor)
 {
-    QUrl url("http://api.twitter.com/1/followers/ids.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "followers/ids.json");
 
     url.addQueryItem("screen_name", screenName);
     url.addQueryItem("cursor", cursor);
@@ -83,8 +82,7 @@ void QTweetFollowersID::fetch(const QString &screenName, const QString &cursor)
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetFollowersID::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -105,3 +103,33 @@ void QTweetFollowersID::parseJsonFinished(const QJsonDocument &jsonDoc)
         emit parsedIDs(idList, nextCursor, prevCursor);
     }
 }
+
+bool QTweetFollowersID::isProgressiveParsingSupported() const
+{
+    return true;
+}
+
+QString QTweetFollowersID::progressiveArrayKey() const
+{
+    return QString("ids");
+}
+
+QTweetFollowersID::JsonElementType QTweetFollowersID::jsonElementType() const
+{
+    return IDElements;
+}
+
+void QTweetFollowersID::parseJsonElements(const QJsonArray &elements)
+{
+    appendJsonIDs(elements);
+}
+
+void QTweetFollowersID::endJsonElements(const QJsonDocument &skeleton)
+{
+    QJsonObject respJsonObject = skeleton.object();
+
+    QString nextCursor = respJsonObject["next_cursor_str"].toString();
+    QString prevCursor = respJsonObject["previous_cursor_str"].toString();
+
+    emit parsedIDs(takeJsonIDs(), nextCursor, prevCursor);
+}
@@ -47,5 +47,12 @@ signals:
 
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
+
+protected:
+    bool isProgressiveParsingSupported() const;
+    QString progressiveArrayKey() const;
+    JsonElementType jsonElementType() const;
+    void parseJsonElements(const QJsonArray &elements);
+    void endJsonElements(const QJsonDocument &skeleton);
 };
 #endif // QTWEETFOLLOWERSID_H
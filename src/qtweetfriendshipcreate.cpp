@@ -57,7 +57,7 @@ void QTweetFriendshipCreate::create(qint64 userid,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/friendships/create.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "friendships/create.json");
 
     QUrl urlQuery(url);
 
@@ -78,8 +78,7 @@ void QTweetFriendshipCreate::create(qint64 userid,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 /**
@@ -97,7 +96,7 @@ void QTweetFriendshipCreate::create(const QString &screenName,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/friendships/create.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "friendships/create.json");
 
     QUrl urlQuery(url);
 
@@ -118,14 +117,13 @@ void QTweetFriendshipCreate::create(const QString &screenName,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetFriendshipCreate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser user = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedUser(user);
     }
@@ -46,6 +46,13 @@ signals:
 
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
+
+protected:
+    bool isProgressiveParsingSupported() const;
+    QString progressiveArrayKey() const;
+    JsonElementType jsonElementType() const;
+    void parseJsonElements(const QJsonArray &elements);
+    void endJsonElements(const QJsonDocument &skeleton);
 };
 
 #endif // QTWEETFRIENDSID_H
@@ -0,0 +1,212 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+
+#ifndef QTWEETFUTURE_H
+#define QTWEETFUTURE_H
+
+#include <QList>
+#include <QSharedData>
+#include <QExplicitlySharedDataPointer>
+#include "qtweetnetbase.h"
+
+template <typename T> class QTweetPromise;
+
+/**
+ *  Result handle of an asynchronous call, cheap to copy
+ *
+ *  Copies share the same result. Continuations registered with then() are called
+ *  once when the call finishes, or immediately if it is already finished.
+ *  @remarks Receiver of a continuation must outlive the call or cancel() it
+ */
+template <typename T>
+class QTweetFuture
+{
+public:
+    typedef void (*Callback)(const QTweetFuture<T>& future);
+
+    QTweetFuture() : d(new Data) {}
+
+    /** Checks if call is finished, successfully or with error */
+    bool isFinished() const { return d->finished; }
+
+    /** Checks if call is finished with error */
+    bool isError() const { return d->finished && d->error != 0; }
+
+    /** Gets error code, valid when isError() */
+    QTweetNetBase::ErrorCode error() const { return static_cast<QTweetNetBase::ErrorCode>(d->error); }
+
+    /** Gets error message, valid when isError() */
+    QString errorMessage() const { return d->errorMessage; }
+
+    /** Gets raw response */
+    QByteArray response() const { return d->response; }
+
+    /** Gets converted result, default constructed until finished */
+    T result() const { return d->result; }
+
+    /** Calls callback when finished */
+    void then(Callback callback) const
+    {
+        addContinuation(new CallbackContinuation(callback));
+    }
+
+    /** Calls receiver's method when finished, receiver doesn't have to be QObject */
+    template <typename Receiver>
+    void then(Receiver *receiver, void (Receiver::*method)(const QTweetFuture<T>&)) const
+    {
+        addContinuation(new MethodContinuation<Receiver>(receiver, method));
+    }
+
+    /** Drops continuations not yet called, call itself is not aborted */
+    void cancel() const
+    {
+        qDeleteAll(d->continuations);
+        d->continuations.clear();
+    }
+
+private:
+    friend class QTweetPromise<T>;
+
+    class Continuation
+    {
+    public:
+        virtual ~Continuation() {}
+        virtual void invoke(const QTweetFuture<T>& future) = 0;
+    };
+
+    class CallbackContinuation : public Continuation
+    {
+    public:
+        CallbackContinuation(Callback callback) : m_callback(callback) {}
+        void invoke(const QTweetFuture<T>& future) { m_callback(future); }
+
+    private:
+        Callback m_callback;
+    };
+
+    template <typename Receiver>
+    class MethodContinuation : public Continuation
+    {
+    public:
+        MethodContinuation(Receiver *receiver, void (Receiver::*method)(const QTweetFuture<T>&)) :
+            m_receiver(receiver), m_method(method) {}
+        void invoke(const QTweetFuture<T>& future) { (m_receiver->*m_method)(future); }
+
+    private:
+        Receiver *m_receiver;
+        void (Receiver::*m_method)(const QTweetFuture<T>&);
+    };
+
+    class Data : public QSharedData
+    {
+    public:
+        Data() : finished(false), error(0) {}
+        ~Data() { qDeleteAll(continuations); }
+
+        bool finished;
+        int error;
+        QString errorMessage;
+        QByteArray response;
+        T result;
+        QList<Continuation*> continuations;
+    };
+
+    void addContinuation(Continuation *continuation) const
+    {
+        if (d->finished) {
+            continuation->invoke(*this);
+            delete continuation;
+        } else {
+            d->continuations.append(continuation);
+        }
+    }
+
+    void finish() const
+    {
+        d->finished = true;
+
+        // continuation may register new ones or drop the last reference
+        QTweetFuture<T> keep(*this);
+        QList<Continuation*> continuations = d->continuations;
+        d->continuations.clear();
+
+        for (int i = 0; i < continuations.size(); ++i) {
+            continuations.at(i)->invoke(keep);
+            delete continuations.at(i);
+        }
+    }
+
+    QExplicitlySharedDataPointer<Data> d;
+};
+
+/**
+ *  Producer side of QTweetFuture
+ *
+ *  Finishing the promise finishes all futures got from it.
+ *  Finishing already finished promise does nothing.
+ */
+template <typename T>
+class QTweetPromise
+{
+public:
+    /** Gets future finished by this promise */
+    QTweetFuture<T> future() const { return m_future; }
+
+    /** Checks if promise is finished */
+    bool isFinished() const { return m_future.isFinished(); }
+
+    /** Sets raw response, doesn't finish */
+    void setResponse(const QByteArray& response) { m_future.d->response = response; }
+
+    /** Sets result without finishing, finish() later publishes it */
+    void setResult(const T& result)
+    {
+        if (!m_future.d->finished)
+            m_future.d->result = result;
+    }
+
+    /** Finishes successfully with current result */
+    void finish()
+    {
+        if (!m_future.d->finished)
+            m_future.finish();
+    }
+
+    /** Finishes successfully with result */
+    void finish(const T& result)
+    {
+        setResult(result);
+        finish();
+    }
+
+    /** Finishes with error */
+    void finishWithError(QTweetNetBase::ErrorCode code, const QString& errorMessage)
+    {
+        if (m_future.d->finished)
+            return;
+
+        m_future.d->error = code;
+        m_future.d->errorMessage = errorMessage;
+        m_future.finish();
+    }
+
+private:
+    QTweetFuture<T> m_future;
+};
+
+#endif // QTWEETFUTURE_H
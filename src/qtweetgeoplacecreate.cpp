@@ -60,7 +60,7 @@ void QTweetGeoPlaceCreate::create(const QString &name,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/geo/place.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "geo/place.json");
     QUrl urlQuery(url);
 
     urlQuery.addEncodedQueryItem("name", QUrl::toPercentEncoding(name));
@@ -78,8 +78,7 @@ void QTweetGeoPlaceCreate::create(const QString &name,
     QByteArray statusPost = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     statusPost.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, statusPost);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, statusPost);
 }
 
 void QTweetGeoPlaceCreate::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -48,7 +48,7 @@ QTweetGeoPlaceID::QTweetGeoPlaceID(OAuthTwitter *oauthTwitter, QObject *parent)
  */
 void QTweetGeoPlaceID::get(const QString &placeid)
 {
-    QUrl url(QString("http://api.twitter.com/1/geo/id/%1.json").arg(placeid));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("geo/id/%1.json").arg(placeid));
 
     QNetworkRequest req(url);
 
@@ -57,8 +57,7 @@ void QTweetGeoPlaceID::get(const QString &placeid)
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetGeoPlaceID::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -53,7 +53,7 @@ void QTweetGeoReverseGeoCode::getPlaces(const QTweetGeoCoord& latLong,
                                         QTweetPlace::Type granularity,
                                         int maxResults)
 {
-    QUrl url("http://api.twitter.com/1/geo/reverse_geocode.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "geo/reverse_geocode.json");
 
     url.addQueryItem("lat", QString::number(latLong.latitude()));
     url.addQueryItem("long", QString::number(latLong.longitude()));
@@ -91,8 +91,7 @@ void QTweetGeoReverseGeoCode::getPlaces(const QTweetGeoCoord& latLong,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetGeoReverseGeoCode::parseJsonFinished(const QJsonDocument &jsonDoc)
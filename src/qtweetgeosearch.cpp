@@ -60,7 +60,7 @@ void QTweetGeoSearch::search(const QTweetGeoCoord &latLong,
                              int maxResults,
                              const QString &containedWithin)
 {
-    QUrl url("http://api.twitter.com/1/geo/search.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "geo/search.json");
 
     if (latLong.isValid()) {
         url.addQueryItem("lat", QString::number(latLong.latitude()));
@@ -110,8 +110,7 @@ void QTweetGeoSearch::search(const QTweetGeoCoord &latLong,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetGeoSearch::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -51,7 +51,7 @@ QTweetGeoSimilarPlaces::QTweetGeoSimilarPlaces(OAuthTwitter *oauthTwitter, QObje
  */
 void QTweetGeoSimilarPlaces::get(const QTweetGeoCoord &latLong, const QString &name, const QString &containedWithin)
 {
-    QUrl url("http://api.twitter.com/1/geo/similar_places.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "geo/similar_places.json");
 
     url.addQueryItem("lat", QString::number(latLong.latitude()));
     url.addQueryItem("long",QString::number(latLong.longitude()));
@@ -67,8 +67,7 @@ void QTweetGeoSimilarPlaces::get(const QTweetGeoCoord &latLong, const QString &n
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetGeoSimilarPlaces::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -0,0 +1,142 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QElapsedTimer>
+#include <string.h>
+#include <zlib.h>
+#include "qtweetgzipinflater_p.h"
+
+static const int outputChunkSize = 16 * 1024;
+
+QTweetGzipInflater::QTweetGzipInflater() :
+    m_stream(new z_stream), m_valid(false), m_compressedBytes(0), m_inflatedBytes(0), m_inflateNSecs(0)
+{
+    init();
+}
+
+QTweetGzipInflater::~QTweetGzipInflater()
+{
+    if (m_valid)
+        inflateEnd(m_stream);
+
+    delete m_stream;
+}
+
+/**
+ *  Checks if inflater could be initialized (zlib can fail on memory or version mismatch)
+ *  @remarks Invalid inflater fails every inflate(), reset() tries to initialize it again
+ */
+bool QTweetGzipInflater::isValid() const
+{
+    return m_valid;
+}
+
+/**
+ *  Inflates next chunk of the stream, appends inflated data to the inflated
+ *  @return false if data is corrupted, stream has to be reset then. Always false
+ *          when inflater isn't valid
+ */
+bool QTweetGzipInflater::inflate(const QByteArray &compressed, QByteArray *inflated)
+{
+    if (!m_valid)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_compressedBytes += compressed.size();
+
+    m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.constData()));
+    m_stream->avail_in = compressed.size();
+
+    char buffer[outputChunkSize];
+    bool ok = true;
+
+    forever {
+        m_stream->next_out = reinterpret_cast<Bytef*>(buffer);
+        m_stream->avail_out = outputChunkSize;
+
+        int ret = ::inflate(m_stream, Z_NO_FLUSH);
+
+        int size = outputChunkSize - m_stream->avail_out;
+        inflated->append(buffer, size);
+        m_inflatedBytes += size;
+
+        if (ret == Z_STREAM_END) {
+            // next gzip member can follow
+            inflateReset(m_stream);
+
+            if (!m_stream->avail_in)
+                break;
+
+            continue;
+        }
+
+        if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            ok = false;
+            break;
+        }
+
+        // all input consumed and nothing pending in the inflater
+        if (!m_stream->avail_in && m_stream->avail_out)
+            break;
+
+        // no progress possible, needs more input
+        if (ret == Z_BUF_ERROR && !size)
+            break;
+    }
+
+    m_inflateNSecs += timer.nsecsElapsed();
+
+    return ok;
+}
+
+/**
+ *  Resets state for new stream, counters are kept
+ */
+void QTweetGzipInflater::reset()
+{
+    if (m_valid)
+        inflateReset(m_stream);
+    else
+        init();
+}
+
+bool QTweetGzipInflater::init()
+{
+    memset(m_stream, 0, sizeof(z_stream));
+
+    // 16 + MAX_WBITS: gzip header and trailer
+    m_valid = inflateInit2(m_stream, 16 + MAX_WBITS) == Z_OK;
+
+    return m_valid;
+}
+
+qint64 QTweetGzipInflater::compressedBytes() const
+{
+    return m_compressedBytes;
+}
+
+qint64 QTweetGzipInflater::inflatedBytes() const
+{
+    return m_inflatedBytes;
+}
+
+qint64 QTweetGzipInflater::inflateNSecs() const
+{
+    return m_inflateNSecs;
+}
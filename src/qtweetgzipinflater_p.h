@@ -0,0 +1,58 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETGZIPINFLATER_P_H
+#define QTWEETGZIPINFLATER_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by the user stream
+//  and may change without notice.
+//
+
+#include <QByteArray>
+
+struct z_stream_s;
+
+// Incremental gzip inflater for chunks of compressed stream, keeps
+// compressed/inflated byte counters and time spent inflating
+class QTweetGzipInflater
+{
+public:
+    QTweetGzipInflater();
+    ~QTweetGzipInflater();
+
+    bool isValid() const;
+    bool inflate(const QByteArray& compressed, QByteArray *inflated);
+    void reset();
+
+    qint64 compressedBytes() const;
+    qint64 inflatedBytes() const;
+    qint64 inflateNSecs() const;
+
+private:
+    Q_DISABLE_COPY(QTweetGzipInflater)
+
+    bool init();
+
+    z_stream_s *m_stream;
+    bool m_valid;
+    qint64 m_compressedBytes;
+    qint64 m_inflatedBytes;
+    qint64 m_inflateNSecs;
+};
+
+#endif // QTWEETGZIPINFLATER_P_H
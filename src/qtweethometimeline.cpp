@@ -20,6 +20,7 @@
 #include <QNetworkReply>
 #include "qtweethometimeline.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonarray.h"
@@ -81,7 +82,7 @@ void QTweetHomeTimeline::fetch(qint64 sinceid,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/statuses/home_timeline.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/home_timeline.json");
 
     if (sinceid != 0)
         url.addQueryItem("since_id", QString::number(sinceid));
@@ -109,8 +110,7 @@ void QTweetHomeTimeline::fetch(qint64 sinceid,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetHomeTimeline::get()
@@ -121,9 +121,40 @@ void QTweetHomeTimeline::get()
 void QTweetHomeTimeline::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array());
+        if (isStatusBatchEnabled()) {
+            emit parsedStatusBatch(QTweetConvert::jsonArrayToStatusBatch(jsonDoc.array(), userPool(), convertOptions()));
+            return;
+        }
+
+        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedStatuses(statuses);
     }
 }
 
+bool QTweetHomeTimeline::isProgressiveParsingSupported() const
+{
+    return !isStatusBatchEnabled();
+}
+
+QString QTweetHomeTimeline::progressiveArrayKey() const
+{
+    return QString();
+}
+
+QTweetHomeTimeline::JsonElementType QTweetHomeTimeline::jsonElementType() const
+{
+    return StatusElements;
+}
+
+void QTweetHomeTimeline::parseJsonElements(const QJsonArray &elements)
+{
+    appendJsonStatuses(elements);
+}
+
+void QTweetHomeTimeline::endJsonElements(const QJsonDocument &skeleton)
+{
+    Q_UNUSED(skeleton)
+
+    emit parsedStatuses(takeJsonStatuses());
+}
@@ -19,6 +19,7 @@
 #define QTWEETHOMETIMELINE_H
 
 #include "qtweetnetbase.h"
+#include "qtweetstatus.h"
 
 /**
  *   Fetches user home timeline
@@ -74,6 +75,13 @@ signals:
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
 
+protected:
+    bool isProgressiveParsingSupported() const;
+    QString progressiveArrayKey() const;
+    JsonElementType jsonElementType() const;
+    void parseJsonElements(const QJsonArray &elements);
+    void endJsonElements(const QJsonDocument &skeleton);
+
 private:
     // ### TODO: Use pimpl
     qint64 m_sinceid;
@@ -0,0 +1,195 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+
+#include "qtweetjsonarraystreamer_p.h"
+
+static inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+QTweetJsonArrayStreamer::QTweetJsonArrayStreamer()
+{
+    reset(QString());
+}
+
+/**
+ *  Starts new response
+ *  @param arrayKey key of the array in top level object, empty for top level array
+ */
+void QTweetJsonArrayStreamer::reset(const QString &arrayKey)
+{
+    m_arrayKey = arrayKey.toUtf8();
+    m_buffer.clear();
+    m_skeleton.clear();
+    m_lastString.clear();
+    m_state = Searching;
+    m_depth = 0;
+    m_arrayDepth = 0;
+    m_elementStart = -1;
+    m_stringStart = -1;
+    m_inString = false;
+    m_escape = false;
+    m_keyMatched = false;
+}
+
+/**
+ *  Scans next chunk of response
+ *  @param elements complete elements are appended, each followed by comma
+ *  @return number of elements appended
+ */
+int QTweetJsonArrayStreamer::append(const QByteArray &data, QByteArray *elements)
+{
+    int count = 0;
+    int scanFrom = m_buffer.size();
+
+    m_buffer.append(data);
+
+    const char *p = m_buffer.constData();
+    int size = m_buffer.size();
+
+    // start of bytes going into skeleton, -1 while inside the array
+    int skeletonFrom = (m_state == InsideArray) ? -1 : scanFrom;
+
+    for (int i = scanFrom; i < size; ++i) {
+        char c = p[i];
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+
+                if (m_stringStart >= 0) {
+                    m_lastString = QByteArray(p + m_stringStart, i - m_stringStart);
+                    m_stringStart = -1;
+                }
+            }
+
+            continue;
+        }
+
+        if (m_state == InsideArray && m_depth == m_arrayDepth) {
+            if (c == ',' || c == ']') {
+                if (m_elementStart >= 0) {
+                    int end = i;
+
+                    while (end > m_elementStart && isJsonSpace(p[end - 1]))
+                        --end;
+
+                    elements->append(p + m_elementStart, end - m_elementStart);
+                    elements->append(',');
+                    ++count;
+
+                    m_elementStart = -1;
+                }
+
+                if (c == ']') {
+                    --m_depth;
+                    m_state = ArrayDone;
+                    skeletonFrom = i;
+                }
+
+                continue;
+            }
+
+            if (m_elementStart < 0 && !isJsonSpace(c))
+                m_elementStart = i;
+        }
+
+        switch (c) {
+        case '"':
+            m_inString = true;
+
+            // remember keys of top level object
+            if (m_state == Searching && m_depth == 1 && !m_arrayKey.isEmpty())
+                m_stringStart = i + 1;
+            break;
+        case '{':
+            ++m_depth;
+            break;
+        case '[':
+            ++m_depth;
+
+            if (m_state == Searching &&
+                    ((m_arrayKey.isEmpty() && m_depth == 1) || (m_keyMatched && m_depth == 2))) {
+                m_state = InsideArray;
+                m_arrayDepth = m_depth;
+
+                m_skeleton.append(p + skeletonFrom, i + 1 - skeletonFrom);
+                skeletonFrom = -1;
+            }
+            break;
+        case '}':
+        case ']':
+            --m_depth;
+            break;
+        case ':':
+            if (m_state == Searching && m_depth == 1 && !m_arrayKey.isEmpty())
+                m_keyMatched = (m_lastString == m_arrayKey);
+            break;
+        case ',':
+            if (m_depth == 1)
+                m_keyMatched = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (skeletonFrom >= 0)
+        m_skeleton.append(p + skeletonFrom, size - skeletonFrom);
+
+    // keep only unfinished element or key
+    int keepFrom = m_elementStart;
+
+    if (m_stringStart >= 0 && (keepFrom < 0 || m_stringStart < keepFrom))
+        keepFrom = m_stringStart;
+
+    if (keepFrom < 0) {
+        m_buffer.clear();
+    } else {
+        m_buffer.remove(0, keepFrom);
+
+        if (m_elementStart >= 0)
+            m_elementStart -= keepFrom;
+
+        if (m_stringStart >= 0)
+            m_stringStart -= keepFrom;
+    }
+
+    return count;
+}
+
+/**
+ *  Checks if the array was found in response so far
+ */
+bool QTweetJsonArrayStreamer::isArrayFound() const
+{
+    return m_state != Searching;
+}
+
+/**
+ *  Gets response without the array elements
+ */
+QByteArray QTweetJsonArrayStreamer::skeleton() const
+{
+    return m_skeleton;
+}
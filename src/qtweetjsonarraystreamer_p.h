@@ -0,0 +1,64 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+
+#ifndef QTWEETJSONARRAYSTREAMER_P_H
+#define QTWEETJSONARRAYSTREAMER_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by QTweetNetBase
+//  for progressive parsing and may change without notice.
+//
+
+#include <QByteArray>
+#include <QString>
+
+// Splits JSON array out of response while it's downloaded. Gives complete
+// elements of the array as they arrive and keeps rest of the response with
+// the array emptied (skeleton), e.g. cursors of {"ids":[...],"next_cursor":1}
+class QTweetJsonArrayStreamer
+{
+public:
+    QTweetJsonArrayStreamer();
+
+    void reset(const QString& arrayKey);
+    int append(const QByteArray& data, QByteArray *elements);
+    bool isArrayFound() const;
+    QByteArray skeleton() const;
+
+private:
+    enum State {
+        Searching,
+        InsideArray,
+        ArrayDone
+    };
+
+    QByteArray m_arrayKey;
+    QByteArray m_buffer;
+    QByteArray m_skeleton;
+    QByteArray m_lastString;
+    State m_state;
+    int m_depth;
+    int m_arrayDepth;
+    int m_elementStart;
+    int m_stringStart;
+    bool m_inString;
+    bool m_escape;
+    bool m_keyMatched;
+};
+
+#endif // QTWEETJSONARRAYSTREAMER_P_H
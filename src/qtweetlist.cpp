@@ -56,6 +56,46 @@ QTweetList::~QTweetList()
 {
 }
 
+void QTweetList::swap(QTweetList &other)
+{
+    d.swap(other.d);
+}
+
+void QTweetList::moveMode(QString &mode)
+{
+    d->mode.swap(mode);
+}
+
+void QTweetList::moveDescription(QString &desc)
+{
+    d->description.swap(desc);
+}
+
+void QTweetList::moveFullName(QString &name)
+{
+    d->fullname.swap(name);
+}
+
+void QTweetList::moveSlug(QString &slug)
+{
+    d->slug.swap(slug);
+}
+
+void QTweetList::moveName(QString &name)
+{
+    d->name.swap(name);
+}
+
+void QTweetList::moveUri(QString &uri)
+{
+    d->uri.swap(uri);
+}
+
+void QTweetList::moveUser(QTweetUser &user)
+{
+    d->user.swap(user);
+}
+
 void QTweetList::setMode(const QString &mode)
 {
     d->mode = mode;
@@ -22,6 +22,7 @@
 #include <QSharedDataPointer>
 #include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetUser;
 class QTweetListData;
 
@@ -35,6 +36,7 @@ public:
     QTweetList(const QTweetList& other);
     QTweetList& operator=(const QTweetList& other);
     ~QTweetList();
+    void swap(QTweetList& other);
 
     void setMode(const QString& mode);
     QString mode() const;
@@ -59,10 +61,34 @@ public:
     void setUser(const QTweetUser& user);
     QTweetUser user() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetList &operator=(QTweetList &&other) { swap(other); return *this; }
+    void setMode(QString&& mode) { moveMode(mode); }
+    void setDescription(QString&& desc) { moveDescription(desc); }
+    void setFullName(QString&& name) { moveFullName(name); }
+    void setSlug(QString&& slug) { moveSlug(slug); }
+    void setName(QString&& name) { moveName(name); }
+    void setUri(QString&& uri) { moveUri(uri); }
+    void setUser(QTweetUser&& user) { moveUser(user); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveMode(QString& mode);
+    void moveDescription(QString& desc);
+    void moveFullName(QString& name);
+    void moveSlug(QString& slug);
+    void moveName(QString& name);
+    void moveUri(QString& uri);
+    void moveUser(QTweetUser& user);
+
     QSharedDataPointer<QTweetListData> d;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetList& list);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetList& list);
+
 Q_DECLARE_METATYPE(QTweetList)
 
 #endif // QTWEETLIST_H
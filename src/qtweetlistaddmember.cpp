@@ -46,7 +46,7 @@ void QTweetListAddMember::add(qint64 user, qint64 list, qint64 memberid)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/%2/members.json").arg(user).arg(list));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/%2/members.json").arg(user).arg(list));
 
     url.addQueryItem("id", QString::number(memberid));
 
@@ -56,14 +56,13 @@ void QTweetListAddMember::add(qint64 user, qint64 list, qint64 memberid)
     req.setRawHeader(AUTH_HEADER, oauthHeader);
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, QByteArray());
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, QByteArray());
 }
 
 void QTweetListAddMember::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
@@ -51,7 +51,7 @@ void QTweetListCreate::create(qint64 user,
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/lists.json").arg(user));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/lists.json").arg(user));
 
     QUrl urlQuery(url);
 
@@ -72,14 +72,13 @@ void QTweetListCreate::create(qint64 user,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetListCreate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
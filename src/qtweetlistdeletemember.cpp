@@ -46,7 +46,7 @@ void QTweetListDeleteMember::remove(qint64 user, qint64 list, qint64 member)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/%2/members.json").arg(user).arg(list));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/%2/members.json").arg(user).arg(list));
 
     url.addQueryItem("id", QString::number(member));
 
@@ -55,14 +55,13 @@ void QTweetListDeleteMember::remove(qint64 user, qint64 list, qint64 member)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::DELETE);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->deleteResource(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startDelete(req);
 }
 
 void QTweetListDeleteMember::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
@@ -49,21 +49,20 @@ void QTweetListShowList::show(qint64 id, qint64 list)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/lists/%2.json").arg(id).arg(list));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/lists/%2.json").arg(id).arg(list));
 
     QNetworkRequest req(url);
 
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetListShowList::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
@@ -45,7 +45,7 @@ void QTweetListSubscribe::follow(qint64 user, qint64 list)
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/%2/subscribers.json").arg(user).arg(list));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/%2/subscribers.json").arg(user).arg(list));
 
     QNetworkRequest req(url);
 
@@ -53,14 +53,13 @@ void QTweetListSubscribe::follow(qint64 user, qint64 list)
     req.setRawHeader(AUTH_HEADER, oauthHeader);
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, QByteArray());
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, QByteArray());
 }
 
 void QTweetListSubscribe::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
@@ -52,7 +52,7 @@ void QTweetListUpdate::update(qint64 user,
         return;
     }
 
-    QUrl url(QString("http://api.twitter.com/1/%1/lists/%2.json").arg(user).arg(list));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, QString("%1/lists/%2.json").arg(user).arg(list));
 
     QUrl urlQuery(url);
 
@@ -74,14 +74,13 @@ void QTweetListUpdate::update(qint64 user,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetListUpdate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object());
+        QTweetList list = QTweetConvert::jsonObjectToTweetList(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedList(list);
     }
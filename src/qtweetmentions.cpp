@@ -20,6 +20,7 @@
 #include <QNetworkReply>
 #include "qtweetmentions.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonarray.h"
@@ -79,7 +80,7 @@ void QTweetMentions::fetch(qint64 sinceid,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/statuses/mentions_timeline.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/mentions_timeline.json");
 
     if (sinceid != 0)
         url.addQueryItem("since_id", QString::number(sinceid));
@@ -113,8 +114,7 @@ void QTweetMentions::fetch(qint64 sinceid,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetMentions::get()
@@ -126,9 +126,40 @@ void QTweetMentions::get()
 void QTweetMentions::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array());
+        if (isStatusBatchEnabled()) {
+            emit parsedStatusBatch(QTweetConvert::jsonArrayToStatusBatch(jsonDoc.array(), userPool(), convertOptions()));
+            return;
+        }
+
+        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedStatuses(statuses);
     }
 }
 
+bool QTweetMentions::isProgressiveParsingSupported() const
+{
+    return !isStatusBatchEnabled();
+}
+
+QString QTweetMentions::progressiveArrayKey() const
+{
+    return QString();
+}
+
+QTweetMentions::JsonElementType QTweetMentions::jsonElementType() const
+{
+    return StatusElements;
+}
+
+void QTweetMentions::parseJsonElements(const QJsonArray &elements)
+{
+    appendJsonStatuses(elements);
+}
+
+void QTweetMentions::endJsonElements(const QJsonDocument &skeleton)
+{
+    Q_UNUSED(skeleton)
+
+    emit parsedStatuses(takeJsonStatuses());
+}
@@ -16,10 +16,29 @@
  */
 
 #include <QtDebug>
+#include <QCoreApplication>
 #include <QThreadPool>
 #include <QNetworkReply>
+#include <QNetworkAccessManager>
+#include <QHttpMultiPart>
+#include <QPointer>
+#include <QRunnable>
+#include <QEvent>
+#include <QTimerEvent>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QLocale>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QtAlgorithms>
 #include "qtweetnetbase.h"
+#include "qtweetrequestcoalescer.h"
+#include "qtweetresponsecache.h"
+#include "qtweetjsonarraystreamer_p.h"
+#include "qtweetshareddocument_p.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetdmstatus.h"
 #include "qtweetuser.h"
 #include "qtweetlist.h"
@@ -27,12 +46,333 @@
 #include "qtweetsearchpageresults.h"
 #include "qtweetplace.h"
 #include "json/qjsondocument.h"
+#include "json/qjsonarray.h"
+#include "json/qjsonobject.h"
+
+Q_GLOBAL_STATIC(QThreadPool, parserThreadPool)
+
+// Converts array of ids, safe on any thread
+static QList<qint64> jsonArrayToIDs(const QJsonArray &elements)
+{
+    QList<qint64> ids;
+    ids.reserve(elements.size());
+
+    for (int i = 0; i < elements.size(); ++i)
+        ids.append(static_cast<qint64>(elements[i].toDouble()));
+
+    return ids;
+}
+
+// Type of event posted to the endpoint when its parse job is done
+static QEvent::Type parsedEventType()
+{
+    static int type = QEvent::registerEventType();
+
+    return static_cast<QEvent::Type>(type);
+}
+
+/**
+ *  Response parsed on parser thread, with its elements converted there when endpoint
+ *  has them. Rest of the conversion is done on the endpoint's thread
+ */
+class QTweetParsedResponse
+{
+public:
+    QTweetParsedResponse() :
+        cacheParsed(false), elementsConverted(false)
+    {
+    }
+
+    QNetworkRequest request;
+    QByteArray response;
+    QJsonDocument jsonDoc;
+    // response is in the response cache, parsed document is kept there
+    bool cacheParsed;
+    // see QTweetNetBase::jsonElementType()
+    bool elementsConverted;
+    QList<QTweetStatus> statuses;
+    QList<QTweetUser> users;
+    QList<qint64> ids;
+};
+
+/**
+ *  Parse jobs of one endpoint, shared with the running job so it can outlive the endpoint
+ */
+class QTweetParseContext
+{
+public:
+    QTweetParseContext(QTweetNetBase *endpoint) :
+        ref(1), endpoint(endpoint), eventType(parsedEventType())
+    {
+    }
+
+    ~QTweetParseContext()
+    {
+        qDeleteAll(parsed);
+    }
+
+    void release()
+    {
+        if (!ref.deref())
+            delete this;
+    }
+
+    QAtomicInt ref;
+    QMutex mutex;
+    // 0 when endpoint is deleted
+    QTweetNetBase *endpoint;
+    QEvent::Type eventType;
+    // parsed responses waiting for the endpoint's thread
+    QList<QTweetParsedResponse*> parsed;
+};
+
+/**
+ *  Parses one response on parser thread and converts its elements, never calls the endpoint
+ */
+class QTweetParseJob : public QRunnable
+{
+public:
+    QTweetParseJob(QTweetParseContext *context, QTweetParsedResponse *parsed, bool jsonParsed) :
+        m_context(context), m_parsed(parsed), m_jsonParsed(jsonParsed),
+        m_elementType(QTweetNetBase::NoJsonElements), m_userPool(0), m_options(QTweetConvert::NoOptions)
+    {
+        m_context->ref.ref();
+    }
+
+    ~QTweetParseJob()
+    {
+        delete m_parsed;
+        m_context->release();
+    }
+
+    void run()
+    {
+        {
+            QMutexLocker locker(&m_context->mutex);
+
+            if (!m_context->endpoint)
+                return;
+        }
+
+        // response of coalesced request is parsed by the first endpoint needing it
+        if (m_sharedDoc)
+            m_parsed->jsonDoc = m_sharedDoc->document();
+        else if (!m_jsonParsed)
+            m_parsed->jsonDoc = QJsonDocument::fromJson(m_parsed->response);
+
+        if (m_elementType != QTweetNetBase::NoJsonElements)
+            convertElements();
+
+        // under the lock, so endpoint can't be deleted in between
+        QMutexLocker locker(&m_context->mutex);
+
+        if (!m_context->endpoint)
+            return;
+
+        m_context->parsed.append(m_parsed);
+        m_parsed = 0;
+
+        QCoreApplication::postEvent(m_context->endpoint, new QEvent(m_context->eventType));
+    }
+
+    void convertElements()
+    {
+        const QJsonDocument &jsonDoc = m_parsed->jsonDoc;
+        QJsonArray elements;
+
+        if (m_arrayKey.isEmpty() && jsonDoc.isArray())
+            elements = jsonDoc.array();
+        else if (!m_arrayKey.isEmpty() && jsonDoc.isObject() && jsonDoc.object().value(m_arrayKey).isArray())
+            elements = jsonDoc.object().value(m_arrayKey).toArray();
+        else
+            return;     // error response, converted by parseJsonFinished()
+
+        if (m_elementType == QTweetNetBase::StatusElements)
+            m_parsed->statuses = QTweetConvert::jsonArrayToStatusList(elements, m_userPool, m_options);
+        else if (m_elementType == QTweetNetBase::UserElements)
+            m_parsed->users = QTweetConvert::jsonArrayToUserInfoList(elements, m_userPool, m_options);
+        else
+            m_parsed->ids = jsonArrayToIDs(elements);
+
+        m_parsed->elementsConverted = true;
+    }
+
+    QTweetParseContext *m_context;
+    QTweetParsedResponse *m_parsed;
+    bool m_jsonParsed;
+    QExplicitlySharedDataPointer<QTweetSharedDocument> m_sharedDoc;
+    // elements are converted only when endpoint has them
+    QTweetNetBase::JsonElementType m_elementType;
+    QString m_arrayKey;
+    QTweetUserPool *m_userPool;
+    QTweetConvert::Options m_options;
+};
+
+/**
+ *  One GET with its retries and hedged copy, or one write watched by deadline
+ */
+class QTweetRequestState
+{
+public:
+    QTweetRequestState() :
+        retryable(false), progressive(false), plain(false), sent(0), retries(0), deadlineTimer(0), hedgeTimer(0), retryTimer(0)
+    {
+        elapsed.start();
+    }
+
+    QNetworkRequest request;
+    bool retryable;
+    // progressive GET is never hedged, retried only until it delivers elements
+    bool progressive;
+    // started by startPlainGet, every attempt is reported by requestSent
+    bool plain;
+    int sent;
+    int retries;
+    int deadlineTimer;
+    int hedgeTimer;
+    int retryTimer;
+    QElapsedTimer elapsed;
+    // attempts in flight, with elapsed time when they were sent
+    QList<QNetworkReply*> replies;
+    QList<qint64> sentAt;
+    // attempts waiting in request scheduler
+    QList<QTweetPendingRequest*> queued;
+};
+
+/**
+ *  Request waiting in request scheduler, sent by QTweetNetBase::sendScheduled()
+ */
+class QTweetPendingRequest
+{
+public:
+    QTweetPendingRequest() :
+        operation(QNetworkAccessManager::GetOperation), multiPart(0), coalesced(false), progressive(false), state(0)
+    {
+    }
+
+    QNetworkAccessManager::Operation operation;
+    QNetworkRequest request;
+    QByteArray data;
+    QHttpMultiPart *multiPart;
+    // GET which can join identical one in flight
+    bool coalesced;
+    bool progressive;
+    // set for attempt of request with retries, hedging or deadline
+    QTweetRequestState *state;
+    QPointer<QTweetRequestScheduler> scheduler;
+};
+
+// latencies of recent successful attempts per endpoint class, for hedge delay
+struct QTweetLatencyWindow
+{
+    QTweetLatencyWindow() : next(0) {}
+
+    QVector<int> samples;
+    int next;
+};
+
+typedef QHash<const QMetaObject*, QTweetLatencyWindow> QTweetLatencyTable;
+
+Q_GLOBAL_STATIC(QTweetLatencyTable, latencyTable)
+Q_GLOBAL_STATIC(QMutex, latencyMutex)
+
+static const int LatencyWindowSize = 64;
+static const int MinLatencySamples = 16;
+static const int DefaultHedgeDelay = 1000;
+
+static void recordLatency(const QMetaObject *endpoint, int msecs)
+{
+    QMutexLocker locker(latencyMutex());
+    QTweetLatencyWindow& window = (*latencyTable())[endpoint];
+
+    if (window.samples.size() < LatencyWindowSize) {
+        window.samples.append(msecs);
+    } else {
+        window.samples[window.next] = msecs;
+        window.next = (window.next + 1) % LatencyWindowSize;
+    }
+}
+
+// -1 until there are enough samples
+static int latencyPercentile(const QMetaObject *endpoint, int percentile)
+{
+    QVector<int> samples;
+
+    {
+        QMutexLocker locker(latencyMutex());
+        samples = latencyTable()->value(endpoint).samples;
+    }
+
+    if (samples.size() < MinLatencySamples)
+        return -1;
+
+    qSort(samples);
+
+    return samples.at((samples.size() - 1) * percentile / 100);
+}
+
+// server errors and rate limiting which go away by themselves
+static bool isTransientError(QNetworkReply *reply)
+{
+    switch (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()) {
+    case QTweetNetBase::EnhanceYourCalm:
+    case 429:
+    case QTweetNetBase::InternalServerError:
+    case QTweetNetBase::BadGateway:
+    case QTweetNetBase::ServiceUnavailable:
+    case 504:
+        return true;
+    default:
+        break;
+    }
+
+    switch (reply->error()) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Retry-After in seconds or as HTTP date, -1 if there is none
+static int retryAfterMSecs(QNetworkReply *reply)
+{
+    QByteArray value = reply->rawHeader("Retry-After").trimmed();
+
+    if (value.isEmpty())
+        return -1;
+
+    bool ok;
+    int seconds = value.toInt(&ok);
+
+    if (ok)
+        return qBound(0, seconds, 3600) * 1000;
+
+    // e.g. "Fri, 31 Dec 1999 23:59:59 GMT"
+    QDateTime date = QLocale::c().toDateTime(QString::fromLatin1(value.left(25)), "ddd, dd MMM yyyy hh:mm:ss");
+
+    if (!date.isValid())
+        return -1;
+
+    date.setTimeSpec(Qt::UTC);
+
+    return static_cast<int>(qBound(Q_INT64_C(0), QDateTime::currentDateTime().toUTC().msecsTo(date), Q_INT64_C(3600000)));
+}
 
 /**
  *   Constructor
  */
 QTweetNetBase::QTweetNetBase(QObject *parent) :
-    QObject(parent), m_oauthTwitter(0), m_jsonParsingEnabled(true), m_authentication(true)
+    QObject(parent), m_oauthTwitter(0), m_userPool(0), m_jsonParsingEnabled(true), m_authentication(true),
+    m_statusBatch(false), m_convertOptions(QTweetConvert::NoOptions), m_threadedParsing(false),
+    m_parseContext(0), m_parseRunning(false), m_progressiveParsing(false),
+    m_partialBatchSize(0), m_rawResponse(true), m_progressiveReply(0), m_progressivePending(0), m_progressiveState(0), m_streamer(0), m_pendingElementCount(0),
+    m_maxRetries(0), m_retryBaseDelay(1000), m_retryMaxDelay(32000), m_deadline(0), m_hedging(false), m_hedgeDelay(0), m_jitterState(0),
+    m_priority(-1)
 {
 }
 
@@ -42,16 +382,52 @@ QTweetNetBase::QTweetNetBase(QObject *parent) :
  *   @param parent QObject parent
  */
 QTweetNetBase::QTweetNetBase(OAuthTwitter *oauthTwitter, QObject *parent) :
-        QObject(parent), m_oauthTwitter(oauthTwitter), m_jsonParsingEnabled(true), m_authentication(true)
+        QObject(parent), m_oauthTwitter(oauthTwitter), m_userPool(0), m_jsonParsingEnabled(true), m_authentication(true),
+        m_statusBatch(false), m_convertOptions(QTweetConvert::NoOptions), m_threadedParsing(false),
+        m_parseContext(0), m_parseRunning(false), m_progressiveParsing(false),
+        m_partialBatchSize(0), m_rawResponse(true), m_progressiveReply(0), m_progressivePending(0), m_progressiveState(0), m_streamer(0), m_pendingElementCount(0),
+        m_maxRetries(0), m_retryBaseDelay(1000), m_retryMaxDelay(32000), m_deadline(0), m_hedging(false), m_hedgeDelay(0), m_jitterState(0),
+        m_priority(-1)
 {
 
 }
 
 /**
  *  Desctructor
+ *  @remarks Responses still being parsed on parser thread are dropped
  */
 QTweetNetBase::~QTweetNetBase()
 {
+    QList<QTweetRequestState*> states = m_requestStates.values() + m_requestTimers.values();
+
+    foreach (QTweetRequestState *state, states.toSet()) {
+        foreach (QTweetPendingRequest *pending, state->queued)
+            cancelScheduled(pending);
+
+        delete state;
+    }
+
+    if (m_progressivePending)
+        cancelScheduled(m_progressivePending);
+
+    // not owned by the coalescer, nothing else deletes it
+    if (m_progressiveReply) {
+        disconnect(m_progressiveReply, 0, this, 0);
+        m_progressiveReply->abort();
+        m_progressiveReply->deleteLater();
+    }
+
+    delete m_streamer;
+    qDeleteAll(m_parseQueue);
+
+    // running job keeps the context, it doesn't post its response anymore
+    if (m_parseContext) {
+        m_parseContext->mutex.lock();
+        m_parseContext->endpoint = 0;
+        m_parseContext->mutex.unlock();
+
+        m_parseContext->release();
+    }
 }
 
 /**
@@ -72,6 +448,278 @@ OAuthTwitter* QTweetNetBase::oauthTwitter() const
     return m_oauthTwitter;
 }
 
+/**
+ *   Sets user pool used when converting responses
+ *   @param userPool user pool, not owned. 0 (default) disables pooling
+ *   @remarks Same pool can be shared between several endpoints
+ */
+void QTweetNetBase::setUserPool(QTweetUserPool *userPool)
+{
+    m_userPool = userPool;
+}
+
+/**
+ *   Gets user pool used when converting responses
+ */
+QTweetUserPool* QTweetNetBase::userPool() const
+{
+    return m_userPool;
+}
+
+/**
+ *   Enables converting status lists into QTweetStatusBatch
+ *   @param enable true to emit parsedStatusBatch instead of status list signal
+ *   @remarks Only timelines, mentions, favorites and retweets support it
+ */
+void QTweetNetBase::setStatusBatchEnabled(bool enable)
+{
+    m_statusBatch = enable;
+}
+
+/**
+ *   Gets if status lists are converted into QTweetStatusBatch
+ */
+bool QTweetNetBase::isStatusBatchEnabled() const
+{
+    return m_statusBatch;
+}
+
+/**
+ *   Sets parts of the response skipped when converting
+ *   @param options conversion options, NoOptions (default) converts everything
+ */
+void QTweetNetBase::setConvertOptions(QTweetConvert::Options options)
+{
+    m_convertOptions = options;
+}
+
+/**
+ *   Gets parts of the response skipped when converting
+ */
+QTweetConvert::Options QTweetNetBase::convertOptions() const
+{
+    return m_convertOptions;
+}
+
+/**
+ *   Enables parsing responses on parser thread pool, disabled by default
+ *   @remarks Elements of long lists (see jsonElementType()) are converted there too,
+ *            the rest of the conversion and all signals are done on object's thread.
+ *            Responses of one object are parsed and signaled in order they arrived,
+ *            responses of different objects are parsed in parallel.
+ *            Object can be deleted any time, responses still being parsed are dropped
+ */
+void QTweetNetBase::setThreadedParsingEnabled(bool enable)
+{
+    m_threadedParsing = enable;
+}
+
+/**
+ *   Checks if responses are parsed on parser thread pool
+ */
+bool QTweetNetBase::isThreadedParsingEnabled() const
+{
+    return m_threadedParsing;
+}
+
+/**
+ *   Sets maximum number of parser threads, shared by all objects
+ *   @param count maximum number of threads, default is number of CPU cores
+ */
+void QTweetNetBase::setParserThreadCount(int count)
+{
+    parserThreadPool()->setMaxThreadCount(count);
+}
+
+/**
+ *   Gets maximum number of parser threads
+ */
+int QTweetNetBase::parserThreadCount()
+{
+    return parserThreadPool()->maxThreadCount();
+}
+
+/**
+ *   Enables parsing response while it's downloaded, disabled by default
+ *   @remarks Only for endpoints returning long lists: home timeline, mentions, user timeline,
+ *            followers and friends ids, followers list. Others and responses served by
+ *            response cache are parsed when finished. Ignored when threaded parsing is enabled.
+ *            Elements are converted as they arrive, so whole response is never parsed at once.
+ *            Progressive request is not coalesced, new request aborts previous one
+ */
+void QTweetNetBase::setProgressiveParsingEnabled(bool enable)
+{
+    m_progressiveParsing = enable;
+}
+
+/**
+ *   Checks if response is parsed while it's downloaded
+ */
+bool QTweetNetBase::isProgressiveParsingEnabled() const
+{
+    return m_progressiveParsing;
+}
+
+/**
+ *   Sets number of elements emitted by partial signals in progressive parsing
+ *   @param size minimum number of elements in parsedPartialStatuses, parsedPartialUsers or
+ *               parsedPartialIDs, last one can be smaller. 0 (default) disables partial signals
+ */
+void QTweetNetBase::setPartialBatchSize(int size)
+{
+    m_partialBatchSize = size;
+}
+
+/**
+ *   Gets number of elements emitted by partial signals
+ */
+int QTweetNetBase::partialBatchSize() const
+{
+    return m_partialBatchSize;
+}
+
+/**
+ *   Enables keeping raw response, enabled by default
+ *   @remarks When disabled finished signal is not emitted, response() is empty after
+ *            conversion and responses aren't stored in the response cache
+ */
+void QTweetNetBase::setRawResponseEnabled(bool enable)
+{
+    m_rawResponse = enable;
+}
+
+/**
+ *   Checks if raw response is kept
+ */
+bool QTweetNetBase::isRawResponseEnabled() const
+{
+    return m_rawResponse;
+}
+
+/**
+ *   Sets how many times failed GET is sent again, 0 (default) disables retries
+ *   @remarks Retries server errors (500, 502, 503, 504), rate limiting (420, 429) and
+ *            transient network errors after jittered exponential backoff, or after the
+ *            time in Retry-After header when server sends it. Writes are never retried
+ */
+void QTweetNetBase::setMaxRetries(int retries)
+{
+    m_maxRetries = retries;
+}
+
+/**
+ *   Gets how many times failed GET is sent again
+ */
+int QTweetNetBase::maxRetries() const
+{
+    return m_maxRetries;
+}
+
+/**
+ *   Sets backoff between retries
+ *   @param baseMsecs delay before first retry, doubled for each next one (default 1000)
+ *   @param maxMsecs upper limit of the delay (default 32000)
+ *   @remarks Actual delay is random between half and full value
+ */
+void QTweetNetBase::setRetryDelay(int baseMsecs, int maxMsecs)
+{
+    m_retryBaseDelay = qMax(1, baseMsecs);
+    m_retryMaxDelay = qMax(m_retryBaseDelay, maxMsecs);
+}
+
+/**
+ *   Gets delay before first retry
+ */
+int QTweetNetBase::retryBaseDelay() const
+{
+    return m_retryBaseDelay;
+}
+
+/**
+ *   Gets upper limit of delay between retries
+ */
+int QTweetNetBase::retryMaxDelay() const
+{
+    return m_retryMaxDelay;
+}
+
+/**
+ *   Sets deadline of requests, 0 (default) means no deadline
+ *   @param msecs time for request to finish, including retries and backoff
+ *   @remarks Request not finished in time is aborted and error is emitted with Timeout code.
+ *            Requests with deadline or hedging are not coalesced
+ */
+void QTweetNetBase::setDeadline(int msecs)
+{
+    m_deadline = msecs;
+}
+
+/**
+ *   Gets deadline of requests
+ */
+int QTweetNetBase::deadline() const
+{
+    return m_deadline;
+}
+
+/**
+ *   Enables hedged GETs, disabled by default
+ *   @remarks When GET isn't finished after hedge delay, its copy is sent and the response
+ *            which comes first is used, the other request is aborted.
+ *            Progressive GETs are not hedged
+ */
+void QTweetNetBase::setHedgingEnabled(bool enable)
+{
+    m_hedging = enable;
+}
+
+/**
+ *   Checks if GETs are hedged
+ */
+bool QTweetNetBase::isHedgingEnabled() const
+{
+    return m_hedging;
+}
+
+/**
+ *   Sets time after which GET is hedged
+ *   @param msecs delay, 0 (default) is 95th percentile of recent latencies of this kind of endpoint
+ */
+void QTweetNetBase::setHedgeDelay(int msecs)
+{
+    m_hedgeDelay = msecs;
+}
+
+/**
+ *   Gets time after which GET is hedged, 0 if it's 95th percentile of recent latencies
+ */
+int QTweetNetBase::hedgeDelay() const
+{
+    return m_hedgeDelay;
+}
+
+/**
+ *   Sets priority class of requests in request scheduler of OAuthTwitter
+ *   @remarks By default reads are Normal and writes (POST, DELETE) Interactive
+ */
+void QTweetNetBase::setPriority(QTweetRequestScheduler::Priority priority)
+{
+    m_priority = priority;
+}
+
+/**
+ *   Gets priority class of requests, Normal if it wasn't set
+ */
+QTweetRequestScheduler::Priority QTweetNetBase::priority() const
+{
+    return m_priority >= 0 ? static_cast<QTweetRequestScheduler::Priority>(m_priority) : QTweetRequestScheduler::Normal;
+}
+
+QTweetRequestScheduler::Priority QTweetNetBase::writePriority() const
+{
+    return m_priority >= 0 ? static_cast<QTweetRequestScheduler::Priority>(m_priority) : QTweetRequestScheduler::Interactive;
+}
+
 /**
  *  Gets response
  */
@@ -130,55 +778,1054 @@ void QTweetNetBase::parseJson(const QByteArray &jsonData)
     //### TODO error
     QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData);
 
-    parseJsonFinished(jsonDoc);
+    convertResponse(&jsonDoc, 0);
 }
 
 /**
- *  Called after response from twitter
+ *  Sends GET request, response is handled by reply()
+ *  @remarks Joins identical GET in flight when request coalescing is enabled on OAuthTwitter,
+ *           sends validators of cached response when OAuthTwitter has response cache.
+ *           Like every request, waits for its turn when OAuthTwitter has request scheduler
  */
-void QTweetNetBase::reply()
+void QTweetNetBase::startGet(const QNetworkRequest &request)
+{
+    sendGet(request, true);
+}
+
+/**
+ *  Sends GET request like startGet()
+ *  @param validators false to send it without validators of cached response
+ */
+void QTweetNetBase::sendGet(const QNetworkRequest &request, bool validators)
+{
+    QNetworkRequest req(request);
+    QTweetResponseCache *cache = m_oauthTwitter->responseCache();
+
+    if (cache && validators)
+        cache->addValidators(&req);
+
+    bool progressive = isProgressive();
+
+    if (progressive)
+        beginProgressive();
+
+    // two progressive replies can't feed one streamer
+    if (m_maxRetries > 0 || m_deadline > 0 || (m_hedging && !progressive)) {
+        QTweetRequestState *state = new QTweetRequestState;
+        state->request = req;
+        state->retryable = true;
+        state->progressive = progressive;
+
+        if (progressive)
+            m_progressiveState = state;
+
+        startRequestState(state);
+        return;
+    }
+
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->request = req;
+    pending->coalesced = !progressive;
+    pending->progressive = progressive;
+
+    sendRequest(pending, priority());
+}
+
+/**
+ *  Sends GET request without coalescing and caching, response is handled by reply()
+ *  @remarks Retried, hedged and put on deadline like startGet(). Only final reply gets
+ *           to reply(), every attempt is reported by requestSent(), request which missed
+ *           the deadline by requestTimedOut()
+ */
+void QTweetNetBase::startPlainGet(const QNetworkRequest &request)
+{
+    if (m_maxRetries > 0 || m_deadline > 0 || m_hedging) {
+        QTweetRequestState *state = new QTweetRequestState;
+        state->request = request;
+        state->retryable = true;
+        state->plain = true;
+
+        startRequestState(state);
+        return;
+    }
+
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->request = request;
+
+    sendRequest(pending, priority());
+}
+
+/**
+ *  Sends POST request, response is handled by reply()
+ */
+void QTweetNetBase::startPost(const QNetworkRequest &request, const QByteArray &data)
+{
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->operation = QNetworkAccessManager::PostOperation;
+    pending->request = request;
+    pending->data = data;
+
+    sendRequest(pending, writePriority());
+}
+
+/**
+ *  Sends multipart POST request, response is handled by reply()
+ *  @param multiPart body, deleted with the reply
+ */
+void QTweetNetBase::startPost(const QNetworkRequest &request, QHttpMultiPart *multiPart)
+{
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->operation = QNetworkAccessManager::PostOperation;
+    pending->request = request;
+    pending->multiPart = multiPart;
+
+    sendRequest(pending, writePriority());
+}
+
+/**
+ *  Sends DELETE request, response is handled by reply()
+ */
+void QTweetNetBase::startDelete(const QNetworkRequest &request)
+{
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->operation = QNetworkAccessManager::DeleteOperation;
+    pending->request = request;
+
+    sendRequest(pending, writePriority());
+}
+
+/**
+ *  Called when request started by startPlainGet, startPost or startDelete is sent
+ *  @remarks Can be later than the start when OAuthTwitter has request scheduler.
+ *           Called for every attempt of retried or hedged plain GET.
+ *           Default implementation does nothing
+ */
+void QTweetNetBase::requestSent(QNetworkReply *reply)
+{
+    Q_UNUSED(reply)
+}
+
+/**
+ *  Called when request didn't finish before its deadline, its replies are already aborted
+ *  @remarks Default implementation emits error with Timeout code
+ */
+void QTweetNetBase::requestTimedOut(const QNetworkRequest &request)
+{
+    Q_UNUSED(request)
+
+    setLastErrorMessage("Request deadline exceeded");
+    emit error(Timeout, m_lastErrorMessage);
+}
+
+/**
+ *  Converts response of reply handled by reimplemented reply() like any other response,
+ *  through parseJsonFinished(), parsed on parser thread when threaded parsing is enabled
+ *  @remarks Doesn't emit finished or error and doesn't use the response cache
+ */
+void QTweetNetBase::convertReply(QNetworkReply *reply)
+{
+    m_response = reply->readAll();
+
+    if (isJsonParsingEnabled())
+        convertResponse(0, 0, reply->request());
+
+    if (!m_rawResponse)
+        m_response.clear();
+}
+
+/**
+ *  Gets request of the response converted by parseJsonFinished(), valid only while
+ *  parseJsonFinished() runs. Null request for parseJson()
+ */
+QNetworkRequest QTweetNetBase::parsedRequest() const
+{
+    return m_parsedRequest;
+}
+
+/**
+ *  Gets time in msecs until rate limit allows requests again, from Retry-After
+ *  or X-Rate-Limit-Reset header of the reply, -1 when it has neither
+ */
+int QTweetNetBase::rateLimitWait(QNetworkReply *reply)
+{
+    int retryAfter = retryAfterMSecs(reply);
+
+    if (retryAfter >= 0)
+        return retryAfter;
+
+    bool ok;
+    qint64 reset = reply->rawHeader("X-Rate-Limit-Reset").trimmed().toLongLong(&ok);
+
+    if (!ok)
+        return -1;
+
+    // epoch seconds
+    qint64 wait = reset * 1000 - QDateTime::currentMSecsSinceEpoch();
+
+    return static_cast<int>(qBound(Q_INT64_C(0), wait, Q_INT64_C(3600000)));
+}
+
+/**
+ *  Sends request now, or queues it in request scheduler of OAuthTwitter
+ */
+void QTweetNetBase::sendRequest(QTweetPendingRequest *pending, QTweetRequestScheduler::Priority priority)
+{
+    QTweetRequestScheduler *scheduler = m_oauthTwitter->requestScheduler();
+
+    if (!scheduler) {
+        sendScheduled(pending);
+        return;
+    }
+
+    // before submit, scheduler can send it right away
+    if (pending->state)
+        pending->state->queued.append(pending);
+
+    if (pending->progressive)
+        m_progressivePending = pending;
+
+    pending->scheduler = scheduler;
+    scheduler->submit(this, priority, pending, pending->request.url().host());
+}
+
+/**
+ *  Sends the request and deletes it
+ *  @return reply, shared one if the request joined identical request in flight
+ */
+QNetworkReply* QTweetNetBase::sendScheduled(QTweetPendingRequest *pending)
+{
+    QNetworkAccessManager *netManager = m_oauthTwitter->networkAccessManager();
+    QTweetRequestCoalescer *coalescer = m_oauthTwitter->requestCoalescer();
+    QNetworkReply *reply;
+
+    if (pending->coalesced && coalescer) {
+        reply = coalescer->get(netManager, pending->request, this);
+    } else {
+        if (pending->operation == QNetworkAccessManager::PostOperation && pending->multiPart) {
+            reply = netManager->post(pending->request, pending->multiPart);
+            pending->multiPart->setParent(reply);
+        } else if (pending->operation == QNetworkAccessManager::PostOperation) {
+            reply = netManager->post(pending->request, pending->data);
+        } else if (pending->operation == QNetworkAccessManager::DeleteOperation) {
+            reply = netManager->deleteResource(pending->request);
+        } else {
+            reply = netManager->get(pending->request);
+        }
+
+        // attempts go through attemptReply(), only response of the request gets to reply()
+        if (pending->state)
+            connect(reply, SIGNAL(finished()), this, SLOT(attemptReply()));
+        else
+            connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    }
+
+    if (pending->progressive) {
+        m_progressivePending = 0;
+        m_progressiveReply = reply;
+        connect(reply, SIGNAL(readyRead()), this, SLOT(progressiveReadyRead()));
+    }
+
+    if (pending->state) {
+        QTweetRequestState *state = pending->state;
+
+        state->queued.removeOne(pending);
+        state->replies.append(reply);
+        state->sentAt.append(state->elapsed.elapsed());
+
+        m_requestStates.insert(reply, state);
+
+        if (state->plain)
+            requestSent(reply);
+    } else if (!pending->coalesced && !pending->progressive) {
+        // GET without retries, hedging or deadline isn't watched
+        if (pending->operation != QNetworkAccessManager::GetOperation)
+            watchReply(reply);
+
+        requestSent(reply);
+    }
+
+    delete pending;
+
+    return reply;
+}
+
+/**
+ *  Deletes request which won't be sent
+ */
+void QTweetNetBase::discardScheduled(QTweetPendingRequest *pending)
+{
+    delete pending->multiPart;
+    delete pending;
+}
+
+/**
+ *  Removes queued request from request scheduler and deletes it
+ */
+void QTweetNetBase::cancelScheduled(QTweetPendingRequest *pending)
+{
+    if (pending->state)
+        pending->state->queued.removeOne(pending);
+
+    if (pending == m_progressivePending)
+        m_progressivePending = 0;
+
+    // scheduler sends what is queued when it's deleted
+    if (pending->scheduler && pending->scheduler->cancel(pending))
+        discardScheduled(pending);
+}
+
+/**
+ *  Called after response from twitter
+ */
+void QTweetNetBase::reply()
 {
     QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
 
     if (reply) {
-        if (reply->error() == QNetworkReply::NoError) {
+        if (reply == m_progressiveReply) {
+            finishProgressiveReply(reply);
+        } else {
             m_response = reply->readAll();
+            finishReply(reply, 0);
+        }
+
+        reply->deleteLater();
+    }
+}
+
+/**
+ *  Called after attempt of request with retries, hedging or deadline,
+ *  passes response of the request to reply()
+ */
+void QTweetNetBase::attemptReply()
+{
+    QNetworkReply *attempt = qobject_cast<QNetworkReply*>(sender());
+
+    if (!attempt)
+        return;
+
+    if (m_requestStates.contains(attempt) && !attemptFinished(attempt)) {
+        if (attempt == m_progressiveReply)
+            m_progressiveReply = 0;
+
+        attempt->deleteLater();
+        return;
+    }
+
+    // sender() is still the reply
+    reply();
+}
+
+/**
+ *  Called by the coalescer with response of the shared request
+ *  @param sharedDoc response shared by endpoints of the request, parsed once
+ */
+void QTweetNetBase::coalescedReply(QNetworkReply *reply, const QByteArray &response, QTweetSharedDocument *sharedDoc,
+                                   bool *cached)
+{
+    m_response = response;
+    finishReply(reply, sharedDoc, cached);
+}
+
+/**
+ *  Emits, converts and caches response of the request
+ *  @param sharedDoc response of coalesced reply, 0 to parse m_response
+ *  @param cached shared by endpoints of coalesced reply, set when response is stored in the cache
+ *  @remarks 304 is served from the cache, request is sent again without validators
+ *           when response isn't cached anymore. 304 is never cached itself
+ */
+void QTweetNetBase::finishReply(QNetworkReply *reply, QTweetSharedDocument *sharedDoc, bool *cached)
+{
+    // retries, hedged copies and deadline decide if this is the response of the request
+    if (m_requestStates.contains(reply) && !attemptFinished(reply))
+        return;
+
+    QTweetResponseCache *cache = m_oauthTwitter ? m_oauthTwitter->responseCache() : 0;
+    bool cacheable = cache && reply->operation() == QNetworkAccessManager::GetOperation;
+    bool notModified = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == NotModified;
+
+    // not modified, served from the cache as if it was sent again
+    if (cacheable && notModified) {
+        QJsonDocument cachedDoc;
+
+        if (cache->find(reply->request(), &m_response, &cachedDoc)) {
+            if (m_rawResponse)
+                emit finished(m_response);
+
+            // response read from disk is parsed like a new one and kept parsed
+            if (isJsonParsingEnabled() && cachedDoc.isNull()) {
+                QNetworkRequest request = reply->request();
+                QJsonDocument parsedDoc;
+
+                convertResponse(0, &parsedDoc, request, true);
+
+                if (!parsedDoc.isNull())
+                    cache->insertParsed(request, m_response, parsedDoc);
+            } else if (isJsonParsingEnabled()) {
+                convertResponse(&cachedDoc, 0, reply->request());
+            }
+
+            if (!m_rawResponse)
+                m_response.clear();
+
+            return;
+        }
+
+        QNetworkRequest request = reply->request();
+
+        // response was evicted from the cache after its validators were sent, get it whole
+        if (request.hasRawHeader("If-None-Match") || request.hasRawHeader("If-Modified-Since")) {
+            request.setRawHeader("If-None-Match", QByteArray());
+            request.setRawHeader("If-Modified-Since", QByteArray());
+
+            m_response.clear();
+            sendGet(request, false);
+            return;
+        }
+    }
+
+    // 304 has no body, nothing to emit, convert or cache
+    if (notModified) {
+        m_response.clear();
+        setLastErrorMessage("Not modified");
+        emit error(NotModified, m_lastErrorMessage);
+        return;
+    }
+
+    if (reply->error() == QNetworkReply::NoError) {
+        if (m_rawResponse)
             emit finished(m_response);
 
-            if (isJsonParsingEnabled())
-                parseJson(m_response);
+        // endpoints of coalesced reply store it once
+        bool store = cacheable && m_rawResponse && !(cached && *cached);
+        QNetworkRequest request = reply->request();
+        QJsonDocument parsedDoc;
+
+        if (isJsonParsingEnabled())
+            convertResponse(0, &parsedDoc, request, store, sharedDoc);
+
+        if (store) {
+            cache->insert(request, reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"),
+                          m_response, parsedDoc);
+
+            if (cached)
+                *cached = true;
+        }
+
+        if (!m_rawResponse)
+            m_response.clear();
+    } else {
+        //dump error
+        qDebug() << "Network error: " << reply->error();
+        qDebug() << "Error string: " << reply->errorString();
+        qDebug() << "Error response: " << m_response;
+
+        //HTTP status code
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        //### TODO: try to json parse the error response
+
+        switch (httpStatus) {
+        case NotModified:
+        case BadRequest:
+        case Unauthorized:
+        case Forbidden:
+        case NotFound:
+        case NotAcceptable:
+        case EnhanceYourCalm:
+        case InternalServerError:
+        case BadGateway:
+        case ServiceUnavailable:
+            emit error(static_cast<ErrorCode>(httpStatus), m_lastErrorMessage);
+            break;
+        default:
+            emit error(UnknownError, m_lastErrorMessage);
+        }
+    }
+}
+
+/**
+ *  Converts response with parseJsonFinished, or queues it for parser thread
+ *  @param jsonDoc already parsed response, 0 to parse m_response
+ *  @param parsedDoc filled with parsed response, can be 0. Stays null when it's parsed on parser thread
+ *  @param request request of the response, see parsedRequest()
+ *  @param cacheParsed response is in the response cache, document parsed on parser
+ *                     thread is kept there
+ *  @param sharedDoc response of coalesced request, parsed once for all its endpoints
+ */
+void QTweetNetBase::convertResponse(const QJsonDocument *jsonDoc, QJsonDocument *parsedDoc,
+                                    const QNetworkRequest &request, bool cacheParsed,
+                                    QTweetSharedDocument *sharedDoc)
+{
+    if (m_threadedParsing) {
+        if (!m_parseContext)
+            m_parseContext = new QTweetParseContext(this);
+
+        QTweetParsedResponse *parsed = new QTweetParsedResponse;
+        parsed->request = request;
+        parsed->response = m_response;
+        parsed->cacheParsed = cacheParsed && !jsonDoc;
+
+        if (jsonDoc)
+            parsed->jsonDoc = *jsonDoc;
+
+        QTweetParseJob *job = new QTweetParseJob(m_parseContext, parsed, jsonDoc != 0);
+        job->m_sharedDoc = sharedDoc;
+
+        // settings are read here, job doesn't touch the endpoint
+        if (isProgressiveParsingSupported()) {
+            job->m_elementType = jsonElementType();
+            job->m_arrayKey = progressiveArrayKey();
+            job->m_userPool = userPool();
+            job->m_options = convertOptions();
+        }
+
+        m_parseQueue.append(job);
+        startParseJob();
+
+        if (parsedDoc && jsonDoc)
+            *parsedDoc = *jsonDoc;
+
+        return;
+    }
+
+    QJsonDocument doc;
+
+    if (jsonDoc)
+        doc = *jsonDoc;
+    else if (sharedDoc)
+        doc = sharedDoc->document();
+    else
+        doc = QJsonDocument::fromJson(m_response);
+
+    m_parsedRequest = request;
+    parseJsonFinished(doc);
+    m_parsedRequest = QNetworkRequest();
+
+    emit parseFinished();
+
+    if (parsedDoc)
+        *parsedDoc = doc;
+}
+
+/**
+ *  Starts next queued response on parser thread, one at a time to keep the order
+ */
+void QTweetNetBase::startParseJob()
+{
+    if (m_parseRunning || m_parseQueue.isEmpty())
+        return;
+
+    m_parseRunning = true;
+    parserThreadPool()->start(m_parseQueue.takeFirst());
+}
+
+/**
+ *  Converts response parsed on parser thread, on endpoint's thread
+ */
+void QTweetNetBase::parseJobFinished()
+{
+    QList<QTweetParsedResponse*> parsedResponses;
+
+    {
+        QMutexLocker locker(&m_parseContext->mutex);
+        parsedResponses.swap(m_parseContext->parsed);
+    }
+
+    m_parseRunning = false;
+
+    QTweetResponseCache *cache = m_oauthTwitter ? m_oauthTwitter->responseCache() : 0;
+
+    foreach (QTweetParsedResponse *parsed, parsedResponses) {
+        m_parsedRequest = parsed->request;
+
+        if (parsed->elementsConverted) {
+            beginJsonElements();
+            m_elementStatuses = parsed->statuses;
+            m_elementUsers = parsed->users;
+            m_elementIDs = parsed->ids;
+            endJsonElements(parsed->jsonDoc);
         } else {
-            m_response = reply->readAll();
+            parseJsonFinished(parsed->jsonDoc);
+        }
 
-            //dump error
-            qDebug() << "Network error: " << reply->error();
-            qDebug() << "Error string: " << reply->errorString();
-            qDebug() << "Error response: " << m_response;
-
-            //HTTP status code
-            int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-            //### TODO: try to json parse the error response
-
-            switch (httpStatus) {
-            case NotModified:
-            case BadRequest:
-            case Unauthorized:
-            case Forbidden:
-            case NotFound:
-            case NotAcceptable:
-            case EnhanceYourCalm:
-            case InternalServerError:
-            case BadGateway:
-            case ServiceUnavailable:
-                emit error(static_cast<ErrorCode>(httpStatus), m_lastErrorMessage);
-                break;
-            default:
-                emit error(UnknownError, m_lastErrorMessage);
-            }
+        m_parsedRequest = QNetworkRequest();
+
+        if (cache && parsed->cacheParsed && !parsed->jsonDoc.isNull())
+            cache->insertParsed(parsed->request, parsed->response, parsed->jsonDoc);
+
+        delete parsed;
+
+        emit parseFinished();
+    }
+
+    startParseJob();
+}
+
+/**
+ *  Puts deadline on a reply not started by startGet, e.g. POST
+ *  @remarks Does nothing when there is no deadline. Such replies are not retried or hedged,
+ *           time spent in request scheduler doesn't count
+ */
+void QTweetNetBase::watchReply(QNetworkReply *reply)
+{
+    if (m_deadline <= 0)
+        return;
+
+    QTweetRequestState *state = new QTweetRequestState;
+    state->replies.append(reply);
+    state->sentAt.append(0);
+
+    m_requestStates.insert(reply, state);
+
+    startRequestTimer(state, &state->deadlineTimer, m_deadline);
+}
+
+/**
+ *  Starts timers of the state and sends its first attempt
+ */
+void QTweetNetBase::startRequestState(QTweetRequestState *state)
+{
+    // before sending, attempt can finish right away
+    if (m_deadline > 0)
+        startRequestTimer(state, &state->deadlineTimer, m_deadline);
+
+    if (m_hedging && !state->progressive)
+        startRequestTimer(state, &state->hedgeTimer, effectiveHedgeDelay());
+
+    sendAttempt(state);
+}
+
+/**
+ *  Sends request of the state, again with fresh oauth nonce if it was sent before
+ */
+void QTweetNetBase::sendAttempt(QTweetRequestState *state)
+{
+    QNetworkRequest req(state->request);
+
+    if (state->sent && req.hasRawHeader(AUTH_HEADER))
+        req.setRawHeader(AUTH_HEADER, m_oauthTwitter->generateAuthorizationHeader(req.url(), OAuth::GET));
+
+    // elements of failed attempt are dropped
+    if (state->sent && state->progressive)
+        beginProgressive(state);
+
+    ++state->sent;
+
+    QTweetPendingRequest *pending = new QTweetPendingRequest;
+    pending->request = req;
+    pending->state = state;
+    pending->progressive = state->progressive;
+    // coalesced reply is shared, it can't be aborted by deadline or hedge
+    pending->coalesced = !state->progressive && !state->plain && m_deadline <= 0 && !m_hedging;
+
+    sendRequest(pending, priority());
+}
+
+/**
+ *  Handles finished attempt of the request
+ *  @return true if the reply is response of the request, false if it is retried
+ *          or hedged copy is still running
+ */
+bool QTweetNetBase::attemptFinished(QNetworkReply *reply)
+{
+    QTweetRequestState *state = m_requestStates.take(reply);
+
+    int i = state->replies.indexOf(reply);
+    qint64 sentAt = state->sentAt.at(i);
+    state->replies.removeAt(i);
+    state->sentAt.removeAt(i);
+
+    bool transient = reply->error() != QNetworkReply::NoError && state->retryable && isTransientError(reply);
+
+    // hedged copy can still succeed
+    if (transient && (!state->replies.isEmpty() || !state->queued.isEmpty()))
+        return false;
+
+    if (transient && state->retries < m_maxRetries) {
+        int delay = retryDelay(state->retries, reply);
+
+        if (m_deadline <= 0 || state->elapsed.elapsed() + delay < m_deadline) {
+            ++state->retries;
+            startRequestTimer(state, &state->retryTimer, delay);
+            return false;
         }
+    }
+
+    if (reply->error() == QNetworkReply::NoError && state->retryable && !state->retries)
+        recordLatency(metaObject(), static_cast<int>(state->elapsed.elapsed() - sentAt));
+
+    finishRequestState(state);
+
+    return true;
+}
+
+/**
+ *  Aborts attempts still in flight or queued, stops timers and deletes the state
+ */
+void QTweetNetBase::finishRequestState(QTweetRequestState *state)
+{
+    // queued attempt must not be sent for deleted state
+    foreach (QTweetPendingRequest *pending, state->queued)
+        cancelScheduled(pending);
+
+    foreach (QNetworkReply *reply, state->replies) {
+        m_requestStates.remove(reply);
+
+        if (reply == m_progressiveReply)
+            m_progressiveReply = 0;
+
+        disconnect(reply, 0, this, 0);
+        reply->abort();
         reply->deleteLater();
     }
+
+    int timers[] = { state->deadlineTimer, state->hedgeTimer, state->retryTimer };
+
+    for (int i = 0; i < 3; ++i) {
+        if (timers[i]) {
+            killTimer(timers[i]);
+            m_requestTimers.remove(timers[i]);
+        }
+    }
+
+    if (state == m_progressiveState)
+        m_progressiveState = 0;
+
+    delete state;
+}
+
+/**
+ *  Gets delay before retry, jittered exponential backoff unless server sent Retry-After
+ */
+int QTweetNetBase::retryDelay(int retry, QNetworkReply *reply) const
+{
+    int retryAfter = retryAfterMSecs(reply);
+
+    if (retryAfter >= 0)
+        return retryAfter;
+
+    qint64 ceiling = qMin(qint64(m_retryBaseDelay) << qMin(retry, 20), qint64(m_retryMaxDelay));
+    int half = static_cast<int>(ceiling / 2);
+
+    // own xorshift generator, qrand() state belongs to the application,
+    // seeded differently for every client and endpoint
+    if (!m_jitterState)
+        m_jitterState = (quint32(QDateTime::currentMSecsSinceEpoch()) ^ quint32(quintptr(this))) | 1;
+
+    m_jitterState ^= m_jitterState << 13;
+    m_jitterState ^= m_jitterState >> 17;
+    m_jitterState ^= m_jitterState << 5;
+
+    // random half spreads retries of many clients after the same outage
+    return half + static_cast<int>(m_jitterState % quint32(half + 1));
+}
+
+int QTweetNetBase::effectiveHedgeDelay() const
+{
+    if (m_hedgeDelay > 0)
+        return m_hedgeDelay;
+
+    int p95 = latencyPercentile(metaObject(), 95);
+
+    return p95 >= 0 ? qMax(1, p95) : DefaultHedgeDelay;
+}
+
+void QTweetNetBase::startRequestTimer(QTweetRequestState *state, int *timerId, int msecs)
+{
+    *timerId = startTimer(msecs);
+    m_requestTimers.insert(*timerId, state);
+}
+
+/**
+ *  Deadline, hedge and retry timers of requests
+ */
+void QTweetNetBase::timerEvent(QTimerEvent *e)
+{
+    QTweetRequestState *state = m_requestTimers.take(e->timerId());
+
+    if (!state) {
+        QObject::timerEvent(e);
+        return;
+    }
+
+    killTimer(e->timerId());
+
+    if (e->timerId() == state->hedgeTimer) {
+        state->hedgeTimer = 0;
+
+        // not when waiting for retry or for request scheduler
+        if (state->replies.size() == 1 && state->queued.isEmpty())
+            sendAttempt(state);
+    } else if (e->timerId() == state->retryTimer) {
+        state->retryTimer = 0;
+        sendAttempt(state);
+    } else if (e->timerId() == state->deadlineTimer) {
+        QNetworkRequest request = state->request;
+
+        state->deadlineTimer = 0;
+        finishRequestState(state);
+
+        requestTimedOut(request);
+    }
+}
+
+/**
+ *  Checks if endpoint supports progressive parsing of current request
+ *  @remarks Reimplemented by endpoints returning long lists together with
+ *           progressiveArrayKey, beginJsonElements, parseJsonElements and endJsonElements
+ */
+bool QTweetNetBase::isProgressiveParsingSupported() const
+{
+    return false;
+}
+
+/**
+ *  Gets key of array parsed progressively in top level object, empty for top level array
+ */
+QString QTweetNetBase::progressiveArrayKey() const
+{
+    return QString();
+}
+
+/**
+ *  Gets type of elements converted by parseJsonElements(), used by threaded parsing
+ *  to convert them on parser thread
+ *  @remarks Elements converted there are collected as by appendJsonStatuses(),
+ *           appendJsonUsers() or appendJsonIDs() and handed to endJsonElements() with whole
+ *           response as skeleton. Default is NoJsonElements, response is converted by parseJsonFinished()
+ */
+QTweetNetBase::JsonElementType QTweetNetBase::jsonElementType() const
+{
+    return NoJsonElements;
+}
+
+/**
+ *  Called when progressive request starts, previously collected elements should be dropped
+ *  @remarks Default implementation drops elements collected by appendJsonStatuses(),
+ *           appendJsonUsers() and appendJsonIDs()
+ */
+void QTweetNetBase::beginJsonElements()
+{
+    m_elementStatuses.clear();
+    m_elementUsers.clear();
+    m_elementIDs.clear();
+}
+
+/**
+ *  Called with array elements as they arrive in progressive parsing
+ */
+void QTweetNetBase::parseJsonElements(const QJsonArray &elements)
+{
+    Q_UNUSED(elements)
+}
+
+/**
+ *  Called when progressive request is finished
+ *  @param skeleton rest of the response, with emptied array
+ */
+void QTweetNetBase::endJsonElements(const QJsonDocument &skeleton)
+{
+    Q_UNUSED(skeleton)
+}
+
+/**
+ *  Converts elements to statuses, emits them as partial batch and collects them
+ *  @remarks Used by parseJsonElements() of endpoints returning status list
+ */
+void QTweetNetBase::appendJsonStatuses(const QJsonArray &elements)
+{
+    QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(elements, userPool(), convertOptions());
+
+    if (partialBatchSize())
+        emit parsedPartialStatuses(statuses);
+
+    m_elementStatuses.append(statuses);
+}
+
+/**
+ *  Same as appendJsonStatuses(), for user lists
+ */
+void QTweetNetBase::appendJsonUsers(const QJsonArray &elements)
+{
+    QList<QTweetUser> users = QTweetConvert::jsonArrayToUserInfoList(elements, userPool(), convertOptions());
+
+    if (partialBatchSize())
+        emit parsedPartialUsers(users);
+
+    m_elementUsers.append(users);
+}
+
+/**
+ *  Same as appendJsonStatuses(), for id lists
+ */
+void QTweetNetBase::appendJsonIDs(const QJsonArray &elements)
+{
+    QList<qint64> ids = jsonArrayToIDs(elements);
+
+    if (partialBatchSize())
+        emit parsedPartialIDs(ids);
+
+    m_elementIDs.append(ids);
+}
+
+/**
+ *  Gets statuses collected by appendJsonStatuses() and drops them, used by endJsonElements()
+ */
+QList<QTweetStatus> QTweetNetBase::takeJsonStatuses()
+{
+    QList<QTweetStatus> statuses;
+    statuses.swap(m_elementStatuses);
+
+    return statuses;
+}
+
+/**
+ *  Gets users collected by appendJsonUsers() and drops them, used by endJsonElements()
+ */
+QList<QTweetUser> QTweetNetBase::takeJsonUsers()
+{
+    QList<QTweetUser> users;
+    users.swap(m_elementUsers);
+
+    return users;
+}
+
+/**
+ *  Gets ids collected by appendJsonIDs() and drops them, used by endJsonElements()
+ */
+QList<qint64> QTweetNetBase::takeJsonIDs()
+{
+    QList<qint64> ids;
+    ids.swap(m_elementIDs);
+
+    return ids;
+}
+
+bool QTweetNetBase::isProgressive() const
+{
+    return m_progressiveParsing && !m_threadedParsing && isJsonParsingEnabled() && isProgressiveParsingSupported();
+}
+
+/**
+ *  Aborts previous progressive request, except retried state, and starts parsing again
+ */
+void QTweetNetBase::beginProgressive(QTweetRequestState *retried)
+{
+    if (m_progressiveState && m_progressiveState != retried)
+        finishRequestState(m_progressiveState);
+
+    if (m_progressiveReply) {
+        disconnect(m_progressiveReply, 0, this, 0);
+        m_progressiveReply->abort();
+        m_progressiveReply->deleteLater();
+        m_progressiveReply = 0;
+    }
+
+    if (m_progressivePending)
+        cancelScheduled(m_progressivePending);
+
+    if (!m_streamer)
+        m_streamer = new QTweetJsonArrayStreamer;
+
+    m_streamer->reset(progressiveArrayKey());
+    m_response.clear();
+    m_pendingElements.clear();
+    m_pendingElementCount = 0;
+
+    beginJsonElements();
+}
+
+void QTweetNetBase::progressiveReadyRead()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+    if (reply && reply == m_progressiveReply)
+        parseProgressive(reply->readAll(), false);
+}
+
+/**
+ *  Feeds downloaded data to the streamer, converts complete elements
+ *  @param flush true to convert all complete elements, regardless of partial batch size
+ */
+void QTweetNetBase::parseProgressive(const QByteArray &data, bool flush)
+{
+    if (m_rawResponse)
+        m_response.append(data);
+
+    m_pendingElementCount += m_streamer->append(data, &m_pendingElements);
+
+    if (!m_pendingElementCount || (!flush && m_pendingElementCount < m_partialBatchSize))
+        return;
+
+    // elements are followed by comma, replace last one to get json array
+    m_pendingElements.prepend('[');
+    m_pendingElements[m_pendingElements.size() - 1] = ']';
+
+    QJsonDocument batch = QJsonDocument::fromJson(m_pendingElements);
+
+    m_pendingElements.clear();
+    m_pendingElementCount = 0;
+
+    // delivered elements can't be taken back by retry
+    if (m_progressiveState)
+        m_progressiveState->retryable = false;
+
+    parseJsonElements(batch.array());
+}
+
+void QTweetNetBase::finishProgressiveReply(QNetworkReply *reply)
+{
+    m_progressiveReply = 0;
+
+    parseProgressive(reply->readAll(), true);
+
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    // errors and not modified responses (cache) aren't arrays, go the usual way
+    if (reply->error() != QNetworkReply::NoError || httpStatus == NotModified) {
+        if (!m_rawResponse)
+            m_response = m_streamer->skeleton();
+
+        finishReply(reply, 0);
+        return;
+    }
+
+    if (m_rawResponse)
+        emit finished(m_response);
+
+    QJsonDocument skeleton = QJsonDocument::fromJson(m_streamer->skeleton());
+
+    if (m_streamer->isArrayFound()) {
+        endJsonElements(skeleton);
+    } else {
+        m_parsedRequest = reply->request();
+        parseJsonFinished(skeleton);
+        m_parsedRequest = QNetworkRequest();
+    }
+
+    emit parseFinished();
+
+    QTweetResponseCache *cache = m_oauthTwitter->responseCache();
+
+    if (cache && m_rawResponse)
+        cache->insert(reply->request(), reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"),
+                      m_response, QJsonDocument());
+
+    m_streamer->reset(QString());
+}
+
+/**
+ *  Handles responses parsed on parser thread
+ */
+bool QTweetNetBase::event(QEvent *e)
+{
+    if (m_parseContext && e->type() == m_parseContext->eventType) {
+        parseJobFinished();
+        return true;
+    }
+
+    return QObject::event(e);
 }
 
 /**
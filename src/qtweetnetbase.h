@@ -21,17 +21,34 @@
 #include <QObject>
 #include <QVariantMap>
 #include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QNetworkRequest>
 #include "oauthtwitter.h"
+#include "qtweetconvert.h"
+#include "qtweetrequestscheduler.h"
 #include "qtweetlib_global.h"
 
 class QTweetStatus;
+class QTweetStatusBatch;
 class QTweetUser;
 class QTweetDMStatus;
 class QTweetList;
 class QTweetSearchResult;
 class QTweetSearchPageResults;
 class QTweetPlace;
+class QTweetUserPool;
 class QJsonDocument;
+class QNetworkReply;
+class QHttpMultiPart;
+class QTweetParseJob;
+class QTweetParseContext;
+class QTweetParsedResponse;
+class QTweetSharedDocument;
+class QTweetRequestState;
+class QTweetPendingRequest;
+class QTweetJsonArrayStreamer;
+class QJsonArray;
 
 /**
  *   Base class for Twitter API classes
@@ -42,6 +59,11 @@ class QTWEETLIBSHARED_EXPORT QTweetNetBase : public QObject
     Q_PROPERTY(OAuthTwitter* oauthTwitter READ oauthTwitter WRITE setOAuthTwitter)
     Q_PROPERTY(bool jsonParsing READ isJsonParsingEnabled WRITE setJsonParsingEnabled)
     Q_PROPERTY(bool authenticaion READ isAuthenticationEnabled WRITE setAuthenticationEnabled)
+    Q_PROPERTY(bool statusBatch READ isStatusBatchEnabled WRITE setStatusBatchEnabled)
+    Q_PROPERTY(bool threadedParsing READ isThreadedParsingEnabled WRITE setThreadedParsingEnabled)
+    Q_PROPERTY(bool progressiveParsing READ isProgressiveParsingEnabled WRITE setProgressiveParsingEnabled)
+    Q_PROPERTY(int partialBatchSize READ partialBatchSize WRITE setPartialBatchSize)
+    Q_PROPERTY(bool rawResponse READ isRawResponseEnabled WRITE setRawResponseEnabled)
 public: 
     QTweetNetBase(QObject *parent = 0);
     QTweetNetBase(OAuthTwitter *oauthTwitter, QObject *parent = 0);
@@ -50,6 +72,7 @@ public:
     enum ErrorCode {
         JsonParsingError = 1,       /** JSON parsing error */
         UnknownError = 2,           /** Unknown error */
+        Timeout = 3,                /** Request didn't finish before its deadline */
         NotModified = 304,          /** There was no new data to return. */
         BadRequest = 400,           /** The request was invalid. This is the status code will be returned during rate limiting. */
         Unauthorized = 401,         /** Authentication credentials were missing or incorrect. */
@@ -71,6 +94,42 @@ public:
     void setAuthenticationEnabled(bool enable);
     bool isAuthenticationEnabled() const;
 
+    void setUserPool(QTweetUserPool *userPool);
+    QTweetUserPool* userPool() const;
+
+    void setStatusBatchEnabled(bool enable);
+    bool isStatusBatchEnabled() const;
+
+    void setConvertOptions(QTweetConvert::Options options);
+    QTweetConvert::Options convertOptions() const;
+
+    void setThreadedParsingEnabled(bool enable);
+    bool isThreadedParsingEnabled() const;
+    static void setParserThreadCount(int count);
+    static int parserThreadCount();
+
+    void setProgressiveParsingEnabled(bool enable);
+    bool isProgressiveParsingEnabled() const;
+    void setPartialBatchSize(int size);
+    int partialBatchSize() const;
+    void setRawResponseEnabled(bool enable);
+    bool isRawResponseEnabled() const;
+
+    void setMaxRetries(int retries);
+    int maxRetries() const;
+    void setRetryDelay(int baseMsecs, int maxMsecs);
+    int retryBaseDelay() const;
+    int retryMaxDelay() const;
+    void setDeadline(int msecs);
+    int deadline() const;
+    void setHedgingEnabled(bool enable);
+    bool isHedgingEnabled() const;
+    void setHedgeDelay(int msecs);
+    int hedgeDelay() const;
+
+    void setPriority(QTweetRequestScheduler::Priority priority);
+    QTweetRequestScheduler::Priority priority() const;
+
     QByteArray response() const;
     QString lastErrorMessage() const;
 
@@ -89,20 +148,142 @@ signals:
      */
     void error(QTweetNetBase::ErrorCode code, const QString& errorMsg);
 
+    /**
+     *  Emitted by status list endpoints instead of their status list signal
+     *  when status batch is enabled
+     */
+    void parsedStatusBatch(const QTweetStatusBatch& batch);
+
+    /**
+     *  Emitted when response is parsed and parsed signals are emitted, even if response
+     *  didn't have expected content. Not emitted when json parsing is disabled
+     */
+    void parseFinished();
+
+    /**
+     *  Emitted with statuses converted so far when progressive parsing and partial batches
+     *  are enabled. Whole list is still emitted by status list signal at the end
+     */
+    void parsedPartialStatuses(const QList<QTweetStatus>& statuses);
+
+    /** Same as parsedPartialStatuses, for user lists */
+    void parsedPartialUsers(const QList<QTweetUser>& users);
+
+    /** Same as parsedPartialStatuses, for id lists */
+    void parsedPartialIDs(const QList<qint64>& ids);
+
 protected slots:
     virtual void reply();
 
+private slots:
+    void progressiveReadyRead();
+    void attemptReply();
+
 protected:
+    /** Type of array elements converted by parseJsonElements() */
+    enum JsonElementType {
+        NoJsonElements,     /** Response is converted by parseJsonFinished() */
+        StatusElements,     /** Statuses, see appendJsonStatuses() */
+        UserElements,       /** Users, see appendJsonUsers() */
+        IDElements          /** Ids, see appendJsonIDs() */
+    };
+
+    bool event(QEvent *e);
+    void timerEvent(QTimerEvent *e);
     virtual void parseJsonFinished(const QJsonDocument& jsonDoc) = 0;
     void parseJson(const QByteArray& jsonData);
     void setLastErrorMessage(const QString& errMsg);
+    void startGet(const QNetworkRequest& request);
+    void startPlainGet(const QNetworkRequest& request);
+    void startPost(const QNetworkRequest& request, const QByteArray& data);
+    void startPost(const QNetworkRequest& request, QHttpMultiPart *multiPart);
+    void startDelete(const QNetworkRequest& request);
+    virtual void requestSent(QNetworkReply *reply);
+    virtual void requestTimedOut(const QNetworkRequest& request);
+    void convertReply(QNetworkReply *reply);
+    QNetworkRequest parsedRequest() const;
+    static int rateLimitWait(QNetworkReply *reply);
+
+    virtual bool isProgressiveParsingSupported() const;
+    virtual QString progressiveArrayKey() const;
+    virtual JsonElementType jsonElementType() const;
+    virtual void beginJsonElements();
+    virtual void parseJsonElements(const QJsonArray& elements);
+    virtual void endJsonElements(const QJsonDocument& skeleton);
+    void appendJsonStatuses(const QJsonArray& elements);
+    void appendJsonUsers(const QJsonArray& elements);
+    void appendJsonIDs(const QJsonArray& elements);
+    QList<QTweetStatus> takeJsonStatuses();
+    QList<QTweetUser> takeJsonUsers();
+    QList<qint64> takeJsonIDs();
 
 private:
+    friend class QTweetRequestCoalescer;
+    friend class QTweetParseJob;
+    friend class QTweetRequestScheduler;
+
+    void coalescedReply(QNetworkReply *reply, const QByteArray& response, QTweetSharedDocument *sharedDoc,
+                        bool *cached);
+    void finishReply(QNetworkReply *reply, QTweetSharedDocument *sharedDoc, bool *cached = 0);
+    void sendGet(const QNetworkRequest& request, bool validators);
+    void convertResponse(const QJsonDocument *jsonDoc, QJsonDocument *parsedDoc,
+                         const QNetworkRequest& request = QNetworkRequest(), bool cacheParsed = false,
+                         QTweetSharedDocument *sharedDoc = 0);
+    void startParseJob();
+    void parseJobFinished();
+    bool isProgressive() const;
+    void beginProgressive(QTweetRequestState *retried = 0);
+    void parseProgressive(const QByteArray& data, bool flush);
+    void finishProgressiveReply(QNetworkReply *reply);
+    void sendRequest(QTweetPendingRequest *pending, QTweetRequestScheduler::Priority priority);
+    QNetworkReply* sendScheduled(QTweetPendingRequest *pending);
+    static void discardScheduled(QTweetPendingRequest *pending);
+    void cancelScheduled(QTweetPendingRequest *pending);
+    QTweetRequestScheduler::Priority writePriority() const;
+    void watchReply(QNetworkReply *reply);
+    void startRequestState(QTweetRequestState *state);
+    void sendAttempt(QTweetRequestState *state);
+    bool attemptFinished(QNetworkReply *reply);
+    void finishRequestState(QTweetRequestState *state);
+    int retryDelay(int retry, QNetworkReply *reply) const;
+    int effectiveHedgeDelay() const;
+    void startRequestTimer(QTweetRequestState *state, int *timerId, int msecs);
+
     OAuthTwitter *m_oauthTwitter;
+    QTweetUserPool *m_userPool;
     QByteArray m_response;
     QString m_lastErrorMessage;
     bool m_jsonParsingEnabled;
     bool m_authentication;
+    bool m_statusBatch;
+    QTweetConvert::Options m_convertOptions;
+    bool m_threadedParsing;
+    QList<QTweetParseJob*> m_parseQueue;
+    QTweetParseContext *m_parseContext;
+    QNetworkRequest m_parsedRequest;
+    bool m_parseRunning;
+    bool m_progressiveParsing;
+    int m_partialBatchSize;
+    bool m_rawResponse;
+    QNetworkReply *m_progressiveReply;
+    QTweetPendingRequest *m_progressivePending;
+    QTweetRequestState *m_progressiveState;
+    QTweetJsonArrayStreamer *m_streamer;
+    QByteArray m_pendingElements;
+    int m_pendingElementCount;
+    QList<QTweetStatus> m_elementStatuses;
+    QList<QTweetUser> m_elementUsers;
+    QList<qint64> m_elementIDs;
+    int m_maxRetries;
+    int m_retryBaseDelay;
+    int m_retryMaxDelay;
+    int m_deadline;
+    bool m_hedging;
+    int m_hedgeDelay;
+    mutable quint32 m_jitterState;
+    QHash<QNetworkReply*, QTweetRequestState*> m_requestStates;
+    QHash<int, QTweetRequestState*> m_requestTimers;
+    int m_priority;
 };
 
 #endif // QTWEETNETBASE_H
@@ -15,88 +15,155 @@
  * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
  */
 
+#include <QSharedData>
 #include "qtweetplace.h"
 
-QTweetPlace::QTweetPlace()
+class QTweetPlaceData : public QSharedData
 {
+public:
+    QTweetPlaceData() : type(QTweetPlace::Neighborhood) {}
+
+    QString name;
+    QString country;
+    QString countryCode;
+    // ### TODO: Attributes
+    QString id;
+    QTweetGeoBoundingBox boundingBox;
+    QList<QTweetPlace> containedWithin;
+    QString fullName;
+    QTweetPlace::Type type;
+};
+
+// Statuses without place share this one instead of allocating empty place
+Q_GLOBAL_STATIC_WITH_ARGS(QSharedDataPointer<QTweetPlaceData>, sharedNullPlace, (new QTweetPlaceData))
+
+QTweetPlace::QTweetPlace() :
+    d(*sharedNullPlace())
+{
+}
+
+QTweetPlace::QTweetPlace(const QTweetPlace &other) :
+    d(other.d)
+{
+}
+
+QTweetPlace& QTweetPlace::operator=(const QTweetPlace &other)
+{
+    if (this != &other)
+        d.operator=(other.d);
+    return *this;
+}
+
+QTweetPlace::~QTweetPlace()
+{
+}
+
+void QTweetPlace::swap(QTweetPlace &other)
+{
+    d.swap(other.d);
+}
+
+void QTweetPlace::moveName(QString &name)
+{
+    d->name.swap(name);
+}
+
+void QTweetPlace::moveCountry(QString &country)
+{
+    d->country.swap(country);
+}
+
+void QTweetPlace::moveCountryCode(QString &code)
+{
+    d->countryCode.swap(code);
+}
+
+void QTweetPlace::moveID(QString &id)
+{
+    d->id.swap(id);
+}
+
+void QTweetPlace::moveFullName(QString &name)
+{
+    d->fullName.swap(name);
 }
 
 void QTweetPlace::setName(const QString &name)
 {
-    m_name = name;
+    d->name = name;
 }
 
 QString QTweetPlace::name() const
 {
-    return m_name;
+    return d->name;
 }
 
 void QTweetPlace::setCountry(const QString &country)
 {
-    m_country = country;
+    d->country = country;
 }
 
 QString QTweetPlace::country() const
 {
-    return m_country;
+    return d->country;
 }
 
 void QTweetPlace::setCountryCode(const QString &code)
 {
-    m_countryCode = code;
+    d->countryCode = code;
 }
 
 QString QTweetPlace::countryCode() const
 {
-    return m_countryCode;
+    return d->countryCode;
 }
 
 void QTweetPlace::setID(const QString &id)
 {
-    m_id = id;
+    d->id = id;
 }
 
 QString QTweetPlace::id() const
 {
-    return m_id;
+    return d->id;
 }
 
 void QTweetPlace::setBoundingBox(const QTweetGeoBoundingBox &box)
 {
-    m_boundingBox = box;
+    d->boundingBox = box;
 }
 
 QTweetGeoBoundingBox QTweetPlace::boundingBox() const
 {
-    return m_boundingBox;
+    return d->boundingBox;
 }
 
 void QTweetPlace::setContainedWithin(const QList<QTweetPlace> &places)
 {
-    m_containedWithin = places;
+    d->containedWithin = places;
 }
 
 QList<QTweetPlace> QTweetPlace::containedWithin() const
 {
-    return m_containedWithin;
+    return d->containedWithin;
 }
 
 void QTweetPlace::setFullName(const QString &name)
 {
-    m_fullName = name;
+    d->fullName = name;
 }
 
 QString QTweetPlace::fullName() const
 {
-    return m_fullName;
+    return d->fullName;
 }
 
 void QTweetPlace::setType(Type type)
 {
-    m_type = type;
+    d->type = type;
 }
 
 QTweetPlace::Type QTweetPlace::type() const
 {
-    return m_type;
+    return d->type;
 }
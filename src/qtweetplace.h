@@ -21,9 +21,12 @@
 #include <QVariant>
 #include <QString>
 #include <QList>
+#include <QSharedDataPointer>
 #include "qtweetgeoboundingbox.h"
 #include "qtweetlib_global.h"
 
+class QDataStream;
+class QTweetPlaceData;
 
 /**
  *   Store place info
@@ -34,6 +37,11 @@ public:
     enum Type { Poi, Neighborhood, City, Admin, Country };
 
     QTweetPlace();
+    QTweetPlace(const QTweetPlace& other);
+    QTweetPlace& operator=(const QTweetPlace& other);
+    ~QTweetPlace();
+    void swap(QTweetPlace& other);
+
     void setName(const QString& name);
     QString name() const;
     void setCountry(const QString& country);
@@ -51,18 +59,30 @@ public:
     void setType(Type type);
     Type type() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetPlace &operator=(QTweetPlace &&other) { swap(other); return *this; }
+    void setName(QString&& name) { moveName(name); }
+    void setCountry(QString&& country) { moveCountry(country); }
+    void setCountryCode(QString&& code) { moveCountryCode(code); }
+    void setID(QString&& id) { moveID(id); }
+    void setFullName(QString&& name) { moveFullName(name); }
+#endif
+
 private:
-    QString m_name;
-    QString m_country;
-    QString m_countryCode;
-    // ### TODO: Attributes
-    QString m_id;
-    QTweetGeoBoundingBox m_boundingBox;
-    QList<QTweetPlace> m_containedWithin;
-    QString m_fullName;
-    Type m_type;
+    // used by the inline rvalue setters, argument gets the old value
+    void moveName(QString& name);
+    void moveCountry(QString& country);
+    void moveCountryCode(QString& code);
+    void moveID(QString& id);
+    void moveFullName(QString& name);
+
+    QSharedDataPointer<QTweetPlaceData> d;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetPlace& place);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetPlace& place);
+
 Q_DECLARE_METATYPE(QTweetPlace)
 
 #endif // QTWEETPLACE_H
@@ -0,0 +1,298 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include "qtweetplacegraph.h"
+
+Q_GLOBAL_STATIC(QTweetPlaceGraph, globalPlaceGraph)
+
+// place hierarchies are shallow (poi, city, admin, country), deeper is a cycle
+static const int MaxDepth = 8;
+
+/**
+ *  Constructor
+ */
+QTweetPlaceGraph::QTweetPlaceGraph() :
+    m_maxCount(10000), m_tick(0), m_lookups(0), m_hits(0)
+{
+}
+
+/**
+ *  Destructor
+ */
+QTweetPlaceGraph::~QTweetPlaceGraph()
+{
+}
+
+/**
+ *  Gets global graph used by the converters
+ */
+QTweetPlaceGraph* QTweetPlaceGraph::instance()
+{
+    return globalPlaceGraph();
+}
+
+/**
+ *  Sets maximum number of places in the graph, 10000 by default. 0 disables the graph.
+ *  @remarks When it's exceeded, least recently used eighth of the places is evicted
+ */
+void QTweetPlaceGraph::setMaxCount(int count)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxCount = count;
+    trim();
+}
+
+int QTweetPlaceGraph::maxCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxCount;
+}
+
+/**
+ *  Finds place node
+ *  @param id place id
+ *  @param place filled with the node when found
+ *  @return true if node can be used instead of converting the payload
+ *  @remarks Full place object (with places it is contained within) should be converted
+ *  and inserted instead, so the node is refreshed with its data
+ */
+bool QTweetPlaceGraph::find(const QString &id, QTweetPlace *place)
+{
+    if (id.isEmpty())
+        return false;
+
+    QMutexLocker locker(&m_mutex);
+
+    ++m_lookups;
+
+    QHash<QString, Node>::iterator it = m_nodes.find(id);
+
+    if (it == m_nodes.end())
+        return false;
+
+    ++m_hits;
+    it.value().used = ++m_tick;
+
+    if (place)
+        *place = resolve(id, 0);
+
+    return true;
+}
+
+/**
+ *  Inserts converted place, and places it is contained within when they aren't in the graph
+ *  @return node of the place. Node with parents isn't replaced by place without them.
+ */
+QTweetPlace QTweetPlaceGraph::insert(const QTweetPlace &place)
+{
+    if (place.id().isEmpty())
+        return place;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_maxCount <= 0)
+        return place;
+
+    insertNode(place);
+
+    QTweetPlace node = resolve(place.id(), 0);
+
+    // after resolving, so the inserted place isn't evicted
+    trim();
+
+    return node;
+}
+
+/**
+ *  Gets place node, default constructed if there isn't one
+ */
+QTweetPlace QTweetPlaceGraph::place(const QString &id) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_nodes.contains(id))
+        return QTweetPlace();
+
+    // resolving only fills the cache of handed out places
+    return const_cast<QTweetPlaceGraph *>(this)->resolve(id, 0);
+}
+
+/**
+ *  Checks if place is in the graph
+ */
+bool QTweetPlaceGraph::contains(const QString &id) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_nodes.contains(id);
+}
+
+/**
+ *  Removes all places and resets statistics, places already handed out stay valid
+ */
+void QTweetPlaceGraph::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_nodes.clear();
+    m_resolved.clear();
+    m_lookups = 0;
+    m_hits = 0;
+}
+
+/**
+ *  Gets number of places in the graph
+ */
+int QTweetPlaceGraph::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_nodes.size();
+}
+
+/**
+ *  Gets number of find() calls with non empty id
+ */
+qint64 QTweetPlaceGraph::lookups() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lookups;
+}
+
+/**
+ *  Gets number of lookups served by the graph
+ */
+qint64 QTweetPlaceGraph::hits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+/**
+ *  Gets hierarchy of the place, from the first place it is contained within up to the root.
+ *  Follows first parent of every place.
+ */
+QList<QTweetPlace> QTweetPlaceGraph::ancestors(const QTweetPlace &place)
+{
+    QList<QTweetPlace> hierarchy;
+    QList<QTweetPlace> parents = place.containedWithin();
+
+    while (!parents.isEmpty()) {
+        hierarchy.append(parents.first());
+        parents = parents.first().containedWithin();
+    }
+
+    return hierarchy;
+}
+
+// Inserts place and parents which aren't in the graph yet, mutex must be locked
+void QTweetPlaceGraph::insertNode(const QTweetPlace &place)
+{
+    QList<QTweetPlace> parents = place.containedWithin();
+
+    // converter inserts parents itself, they usually are handed out nodes already
+    for (int i = 0; i < parents.size(); ++i) {
+        QString parentId = parents.at(i).id();
+
+        if (!parentId.isEmpty() && parentId != place.id() && !m_nodes.contains(parentId))
+            insertNode(parents.at(i));
+    }
+
+    QHash<QString, Node>::iterator it = m_nodes.find(place.id());
+
+    if (it != m_nodes.end()) {
+        it.value().used = ++m_tick;
+
+        if (parents.isEmpty() && !it.value().parentIds.isEmpty())
+            return;
+
+        // children of the node could have been handed out with old data
+        m_resolved.clear();
+    }
+
+    Node node;
+    node.place = place;
+    node.used = ++m_tick;
+
+    for (int i = 0; i < parents.size(); ++i)
+        node.parentIds.append(parents.at(i).id());
+
+    m_nodes.insert(place.id(), node);
+}
+
+// Gets place with parents taken from the nodes, mutex must be locked
+QTweetPlace QTweetPlaceGraph::resolve(const QString &id, int depth)
+{
+    QHash<QString, QTweetPlace>::const_iterator cached = m_resolved.constFind(id);
+
+    if (cached != m_resolved.constEnd())
+        return cached.value();
+
+    const Node node = m_nodes.value(id);
+    QTweetPlace place = node.place;
+
+    if (!node.parentIds.isEmpty() && depth < MaxDepth) {
+        QList<QTweetPlace> parents = node.place.containedWithin();
+
+        for (int i = 0; i < parents.size(); ++i) {
+            const QString &parentId = node.parentIds.at(i);
+
+            if (!parentId.isEmpty() && parentId != id && m_nodes.contains(parentId))
+                parents[i] = resolve(parentId, depth + 1);
+        }
+
+        place.setContainedWithin(parents);
+    }
+
+    m_resolved.insert(id, place);
+
+    return place;
+}
+
+// Evicts least recently used nodes when there are more than maximum, mutex must be locked
+void QTweetPlaceGraph::trim()
+{
+    if (m_nodes.size() <= m_maxCount)
+        return;
+
+    // evicting an eighth at once keeps inserts amortized constant
+    int keep = m_maxCount > 0 ? m_maxCount - m_maxCount / 8 : 0;
+    int evict = m_nodes.size() - keep;
+
+    QVector<qint64> used;
+    used.reserve(m_nodes.size());
+
+    QHash<QString, Node>::const_iterator it = m_nodes.constBegin();
+
+    for (; it != m_nodes.constEnd(); ++it)
+        used.append(it.value().used);
+
+    // ticks are unique, nodes used at or before the threshold are evicted
+    qSort(used);
+    qint64 threshold = used.at(evict - 1);
+
+    QHash<QString, Node>::iterator node = m_nodes.begin();
+
+    while (node != m_nodes.end()) {
+        if (node.value().used <= threshold)
+            node = m_nodes.erase(node);
+        else
+            ++node;
+    }
+
+    // children of evicted nodes fall back to their payload parents
+    m_resolved.clear();
+}
@@ -0,0 +1,84 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETPLACEGRAPH_H
+#define QTWEETPLACEGRAPH_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include <QVector>
+#include "qtweetplace.h"
+#include "qtweetlib_global.h"
+
+/**
+ *  Graph of converted places keyed by place id, shared by all converters
+ *
+ *  Place seen again (in statuses or geo results) is handed out from the graph
+ *  instead of being converted, so every place and its hierarchy is stored once.
+ *  Nodes keep ids of their parents, containedWithin() of handed out place
+ *  is looked up from the current nodes, so refreshed parent is seen by children.
+ *  Full place objects (with places they are contained within) replace the node,
+ *  least recently used nodes are evicted when the graph is full. Thread safe.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetPlaceGraph
+{
+public:
+    QTweetPlaceGraph();
+    ~QTweetPlaceGraph();
+
+    static QTweetPlaceGraph* instance();
+
+    void setMaxCount(int count);
+    int maxCount() const;
+
+    bool find(const QString& id, QTweetPlace *place);
+    QTweetPlace insert(const QTweetPlace& place);
+    QTweetPlace place(const QString& id) const;
+    bool contains(const QString& id) const;
+    void clear();
+
+    int count() const;
+    qint64 lookups() const;
+    qint64 hits() const;
+
+    static QList<QTweetPlace> ancestors(const QTweetPlace& place);
+
+private:
+    Q_DISABLE_COPY(QTweetPlaceGraph)
+
+    struct Node {
+        QTweetPlace place;      // parents are payload copies, used when parent isn't in the graph
+        QStringList parentIds;  // ids of containedWithin(), in the same order
+        qint64 used;            // tick of the last use
+    };
+
+    void insertNode(const QTweetPlace& place);
+    QTweetPlace resolve(const QString& id, int depth);
+    void trim();
+
+    mutable QMutex m_mutex;
+    QHash<QString, Node> m_nodes;
+    QHash<QString, QTweetPlace> m_resolved;    // handed out places, until a node is replaced
+    int m_maxCount;
+    qint64 m_tick;
+    qint64 m_lookups;
+    qint64 m_hits;
+};
+
+#endif // QTWEETPLACEGRAPH_H
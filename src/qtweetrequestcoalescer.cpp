@@ -0,0 +1,167 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QUrl>
+#include <QtAlgorithms>
+#include "qtweetrequestcoalescer.h"
+#include "qtweetnetbase.h"
+#include "qtweetshareddocument_p.h"
+
+/**
+ *  Constructor
+ */
+QTweetRequestCoalescer::QTweetRequestCoalescer(QObject *parent) :
+    QObject(parent), m_requests(0), m_coalescedRequests(0), m_deleteWhenIdle(false)
+{
+}
+
+/**
+ *  Destructor, aborts requests in flight
+ *  @remarks Use deleteWhenIdle() to let them finish
+ */
+QTweetRequestCoalescer::~QTweetRequestCoalescer()
+{
+    QList<QNetworkReply*> replies = m_entries.keys();
+
+    foreach (QNetworkReply *reply, replies) {
+        disconnect(reply, 0, this, 0);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+/**
+ *  Sends GET request for the endpoint, or joins identical request in flight
+ *  @return shared reply, owned by the coalescer
+ *  @remarks Endpoint is notified through QTweetNetBase::coalescedReply()
+ */
+QNetworkReply* QTweetRequestCoalescer::get(QNetworkAccessManager *netManager, const QNetworkRequest &request,
+                                 QTweetNetBase *endpoint)
+{
+    QByteArray key = requestKey(request);
+
+    ++m_requests;
+
+    QNetworkReply *reply = m_replies.value(key);
+
+    if (reply) {
+        ++m_coalescedRequests;
+        m_entries[reply].endpoints.append(endpoint);
+        return reply;
+    }
+
+    reply = netManager->get(request);
+    connect(reply, SIGNAL(finished()), this, SLOT(finished()));
+
+    Entry entry;
+    entry.key = key;
+    entry.endpoints.append(endpoint);
+
+    m_replies.insert(key, reply);
+    m_entries.insert(reply, entry);
+
+    return reply;
+}
+
+/**
+ *  Gets number of requests in flight
+ */
+int QTweetRequestCoalescer::inFlightCount() const
+{
+    return m_entries.size();
+}
+
+/**
+ *  Gets number of get() calls
+ */
+qint64 QTweetRequestCoalescer::requests() const
+{
+    return m_requests;
+}
+
+/**
+ *  Gets number of get() calls which joined request in flight
+ */
+qint64 QTweetRequestCoalescer::coalescedRequests() const
+{
+    return m_coalescedRequests;
+}
+
+/**
+ *  Deletes the coalescer after requests in flight are finished and handed to their endpoints
+ *  @remarks Used when coalescing is disabled, get() must not be called after it
+ */
+void QTweetRequestCoalescer::deleteWhenIdle()
+{
+    m_deleteWhenIdle = true;
+
+    if (m_entries.isEmpty())
+        deleteLater();
+}
+
+/**
+ *  Gets canonical form of the GET request: url with query items sorted,
+ *  without OAuth parameters (nonce, timestamp, signature...)
+ */
+QByteArray QTweetRequestCoalescer::requestKey(const QNetworkRequest &request)
+{
+    QUrl url = request.url();
+    QList<QPair<QByteArray, QByteArray> > queryItems = url.encodedQueryItems();
+
+    for (int i = queryItems.size() - 1; i >= 0; --i) {
+        if (queryItems.at(i).first.startsWith("oauth_"))
+            queryItems.removeAt(i);
+    }
+
+    qSort(queryItems);
+    url.setEncodedQueryItems(queryItems);
+
+    return "GET " + url.toEncoded();
+}
+
+void QTweetRequestCoalescer::finished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+    if (!reply)
+        return;
+
+    Entry entry = m_entries.take(reply);
+    m_replies.remove(entry.key);
+
+    QByteArray response = reply->readAll();
+    // parsed once, on this thread or by parse job of the first endpoint with threaded parsing
+    QExplicitlySharedDataPointer<QTweetSharedDocument> sharedDoc(new QTweetSharedDocument(response));
+    // response is stored in the response cache once, by the first endpoint
+    bool cached = false;
+
+    foreach (const QPointer<QTweetNetBase>& endpoint, entry.endpoints) {
+        // endpoint can be deleted by then, also by previous endpoint's signals
+        if (!endpoint)
+            continue;
+
+        endpoint->coalescedReply(reply, response, sharedDoc.data(), &cached);
+    }
+
+    reply->deleteLater();
+
+    if (m_deleteWhenIdle && m_entries.isEmpty())
+        deleteLater();
+}
@@ -0,0 +1,74 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETREQUESTCOALESCER_H
+#define QTWEETREQUESTCOALESCER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QByteArray>
+#include "qtweetlib_global.h"
+
+class QNetworkAccessManager;
+class QNetworkRequest;
+class QNetworkReply;
+class QTweetNetBase;
+
+/**
+ *  Shares one network request between identical GETs in flight
+ *
+ *  GET issued while identical one (same canonical url) is in flight doesn't
+ *  go to the network, its endpoint gets response of the request in flight.
+ *  Response is parsed once, every endpoint still emits its own signals.
+ *  Enabled with OAuthTwitter::setRequestCoalescingEnabled().
+ */
+class QTWEETLIBSHARED_EXPORT QTweetRequestCoalescer : public QObject
+{
+    Q_OBJECT
+public:
+    QTweetRequestCoalescer(QObject *parent = 0);
+    ~QTweetRequestCoalescer();
+
+    QNetworkReply* get(QNetworkAccessManager *netManager, const QNetworkRequest& request, QTweetNetBase *endpoint);
+
+    int inFlightCount() const;
+    qint64 requests() const;
+    qint64 coalescedRequests() const;
+
+    static QByteArray requestKey(const QNetworkRequest& request);
+
+    void deleteWhenIdle();
+
+private slots:
+    void finished();
+
+private:
+    struct Entry {
+        QByteArray key;
+        QList<QPointer<QTweetNetBase> > endpoints;
+    };
+
+    QHash<QByteArray, QNetworkReply*> m_replies;
+    QHash<QNetworkReply*, Entry> m_entries;
+    qint64 m_requests;
+    qint64 m_coalescedRequests;
+    bool m_deleteWhenIdle;
+};
+
+#endif // QTWEETREQUESTCOALESCER_H
@@ -0,0 +1,344 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QNetworkReply>
+#include "qtweetrequestscheduler.h"
+#include "qtweetnetbase.h"
+
+QTweetRequestScheduler::PriorityClass::PriorityClass() :
+    maxRunning(1), running(0), queued(0), started(0), totalWait(0), maxWait(0)
+{
+}
+
+/**
+ *  Constructor
+ *  @remarks By default 6 requests run at once (as many as network access manager
+ *           opens connections to one host): up to 6 Interactive, 4 Normal and
+ *           1 Background, so Interactive request always finds free slot
+ */
+QTweetRequestScheduler::QTweetRequestScheduler(QObject *parent) :
+    QObject(parent), m_maxRunning(6), m_maxHostRunning(6), m_totalRunning(0), m_schedulePending(false)
+{
+    m_classes[Interactive].maxRunning = 6;
+    m_classes[Normal].maxRunning = 4;
+    m_classes[Background].maxRunning = 1;
+}
+
+/**
+ *  Destructor
+ *  @remarks Requests still waiting are sent right away
+ */
+QTweetRequestScheduler::~QTweetRequestScheduler()
+{
+    for (int priority = Interactive; priority <= Background; ++priority) {
+        PriorityClass& priorityClass = m_classes[priority];
+
+        foreach (const OAuthTwitter *account, priorityClass.accounts) {
+            foreach (const Entry& entry, priorityClass.queues.value(account)) {
+                if (entry.endpoint)
+                    entry.endpoint->sendScheduled(entry.pending);
+                else
+                    QTweetNetBase::discardScheduled(entry.pending);
+            }
+        }
+    }
+}
+
+/**
+ *  Sets maximum number of requests running at once, 6 by default
+ */
+void QTweetRequestScheduler::setMaxConcurrentRequests(int count)
+{
+    m_maxRunning = qMax(1, count);
+    scheduleLater();
+}
+
+int QTweetRequestScheduler::maxConcurrentRequests() const
+{
+    return m_maxRunning;
+}
+
+/**
+ *  Sets maximum number of running requests of the priority class
+ *  @remarks Keep sum of Normal and Background below maxConcurrentRequests(),
+ *           otherwise they can take all slots from Interactive requests
+ */
+void QTweetRequestScheduler::setMaxConcurrentRequests(Priority priority, int count)
+{
+    m_classes[priority].maxRunning = qMax(1, count);
+    scheduleLater();
+}
+
+int QTweetRequestScheduler::maxConcurrentRequests(Priority priority) const
+{
+    return m_classes[priority].maxRunning;
+}
+
+/**
+ *  Sets maximum number of requests running at once to one host, 6 by default
+ */
+void QTweetRequestScheduler::setMaxConcurrentRequestsPerHost(int count)
+{
+    m_maxHostRunning = qMax(1, count);
+    scheduleLater();
+}
+
+int QTweetRequestScheduler::maxConcurrentRequestsPerHost() const
+{
+    return m_maxHostRunning;
+}
+
+/**
+ *  Gets number of requests of the priority class waiting to be started
+ */
+int QTweetRequestScheduler::queueDepth(Priority priority) const
+{
+    return m_classes[priority].queued;
+}
+
+/**
+ *  Gets number of running requests of the priority class
+ */
+int QTweetRequestScheduler::runningCount(Priority priority) const
+{
+    return m_classes[priority].running;
+}
+
+/**
+ *  Gets number of started requests of the priority class
+ */
+qint64 QTweetRequestScheduler::startedRequests(Priority priority) const
+{
+    return m_classes[priority].started;
+}
+
+/**
+ *  Gets average time in milliseconds started requests of the priority class spent in the queue
+ */
+qint64 QTweetRequestScheduler::averageWaitTime(Priority priority) const
+{
+    const PriorityClass& priorityClass = m_classes[priority];
+
+    return priorityClass.started ? priorityClass.totalWait / priorityClass.started : 0;
+}
+
+/**
+ *  Gets longest time in milliseconds a started request of the priority class spent in the queue
+ */
+qint64 QTweetRequestScheduler::maxWaitTime(Priority priority) const
+{
+    return m_classes[priority].maxWait;
+}
+
+/**
+ *  Resets started requests and wait times
+ */
+void QTweetRequestScheduler::resetStatistics()
+{
+    for (int priority = Interactive; priority <= Background; ++priority) {
+        m_classes[priority].started = 0;
+        m_classes[priority].totalWait = 0;
+        m_classes[priority].maxWait = 0;
+    }
+}
+
+/**
+ *  Queues request of the endpoint and starts what limits allow
+ *  @param pending request, owned by the scheduler until it's sent
+ */
+void QTweetRequestScheduler::submit(QTweetNetBase *endpoint, Priority priority, QTweetPendingRequest *pending,
+                                    const QString &host)
+{
+    Entry entry;
+    entry.endpoint = endpoint;
+    entry.pending = pending;
+    entry.host = host;
+    entry.queuedFor.start();
+
+    PriorityClass& priorityClass = m_classes[priority];
+    const OAuthTwitter *account = endpoint->oauthTwitter();
+    QQueue<Entry>& queue = priorityClass.queues[account];
+
+    if (queue.isEmpty())
+        priorityClass.accounts.append(account);
+
+    queue.enqueue(entry);
+    ++priorityClass.queued;
+
+    schedule();
+}
+
+/**
+ *  Removes request from the queue
+ *  @return false if request isn't queued
+ */
+bool QTweetRequestScheduler::cancel(QTweetPendingRequest *pending)
+{
+    for (int priority = Interactive; priority <= Background; ++priority) {
+        PriorityClass& priorityClass = m_classes[priority];
+        QHash<const OAuthTwitter*, QQueue<Entry> >::iterator it = priorityClass.queues.begin();
+
+        for (; it != priorityClass.queues.end(); ++it) {
+            QQueue<Entry>& queue = it.value();
+
+            for (int i = 0; i < queue.size(); ++i) {
+                if (queue.at(i).pending != pending)
+                    continue;
+
+                queue.removeAt(i);
+                --priorityClass.queued;
+
+                if (queue.isEmpty()) {
+                    priorityClass.accounts.removeOne(it.key());
+                    priorityClass.queues.erase(it);
+                }
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  Starts queued requests, higher priority classes first
+ */
+void QTweetRequestScheduler::schedule()
+{
+    m_schedulePending = false;
+
+    for (int priority = Interactive; priority <= Background; ++priority) {
+        while (startNext(static_cast<Priority>(priority)))
+            ;
+    }
+}
+
+/**
+ *  Starts next request of the priority class if limits allow
+ *  @return false if nothing was started
+ */
+bool QTweetRequestScheduler::startNext(Priority priority)
+{
+    PriorityClass& priorityClass = m_classes[priority];
+
+    if (!priorityClass.queued || priorityClass.running >= priorityClass.maxRunning || m_totalRunning >= m_maxRunning)
+        return false;
+
+    // first account in turn whose next request doesn't go to busy host
+    for (int i = 0; i < priorityClass.accounts.size(); ++i) {
+        const OAuthTwitter *account = priorityClass.accounts.at(i);
+        QQueue<Entry>& queue = priorityClass.queues[account];
+
+        if (m_hostRunning.value(queue.head().host) >= m_maxHostRunning)
+            continue;
+
+        Entry entry = queue.dequeue();
+        --priorityClass.queued;
+
+        // served account goes to the end of the line
+        priorityClass.accounts.removeAt(i);
+
+        if (queue.isEmpty())
+            priorityClass.queues.remove(account);
+        else
+            priorityClass.accounts.append(account);
+
+        start(priority, entry);
+
+        return true;
+    }
+
+    return false;
+}
+
+void QTweetRequestScheduler::start(Priority priority, const Entry &entry)
+{
+    // endpoint was deleted while its request waited
+    if (!entry.endpoint) {
+        QTweetNetBase::discardScheduled(entry.pending);
+        return;
+    }
+
+    PriorityClass& priorityClass = m_classes[priority];
+    qint64 wait = entry.queuedFor.elapsed();
+
+    ++priorityClass.started;
+    priorityClass.totalWait += wait;
+    priorityClass.maxWait = qMax(priorityClass.maxWait, wait);
+
+    QNetworkReply *reply = entry.endpoint->sendScheduled(entry.pending);
+
+    // joined identical request in flight, it already has its slot
+    if (m_running.contains(reply))
+        return;
+
+    Running running;
+    running.priority = priority;
+    running.host = entry.host;
+
+    m_running.insert(reply, running);
+    ++priorityClass.running;
+    ++m_totalRunning;
+    ++m_hostRunning[entry.host];
+
+    connect(reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+    connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(replyDestroyed(QObject*)));
+}
+
+void QTweetRequestScheduler::replyFinished()
+{
+    release(qobject_cast<QNetworkReply*>(sender()));
+}
+
+/**
+ *  Frees the slot of reply deleted without finishing
+ */
+void QTweetRequestScheduler::replyDestroyed(QObject *reply)
+{
+    // only the address is used, reply is already destroyed
+    release(static_cast<QNetworkReply*>(reply));
+}
+
+void QTweetRequestScheduler::release(QNetworkReply *reply)
+{
+    if (!m_running.contains(reply))
+        return;
+
+    Running running = m_running.take(reply);
+
+    --m_classes[running.priority].running;
+    --m_totalRunning;
+
+    if (--m_hostRunning[running.host] <= 0)
+        m_hostRunning.remove(running.host);
+
+    scheduleLater();
+}
+
+/**
+ *  Schedules from event loop, reply can finish in the middle of endpoint's work
+ *  (e.g. when it's aborted)
+ */
+void QTweetRequestScheduler::scheduleLater()
+{
+    if (m_schedulePending)
+        return;
+
+    m_schedulePending = true;
+    QMetaObject::invokeMethod(this, "schedule", Qt::QueuedConnection);
+}
@@ -0,0 +1,125 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETREQUESTSCHEDULER_H
+#define QTWEETREQUESTSCHEDULER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QQueue>
+#include <QPointer>
+#include <QString>
+#include <QElapsedTimer>
+#include "qtweetlib_global.h"
+
+class QNetworkReply;
+class QTweetNetBase;
+class QTweetPendingRequest;
+class OAuthTwitter;
+
+/**
+ *  Decides when requests of endpoints go to the network
+ *
+ *  Requests wait in one queue per priority class. Interactive requests are
+ *  started first, then Normal, then Background, each class limited by its
+ *  own maximum of running requests, all of them by maximum per host and total
+ *  maximum. Within a class accounts (OAuthTwitter objects) take turns, so one
+ *  account's follower crawl doesn't hold back the others.
+ *  Set with OAuthTwitter::setRequestScheduler(), one scheduler can be shared
+ *  by OAuthTwitter objects of several accounts. Not thread safe, used from
+ *  the thread of the network access manager.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetRequestScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    /** Priority classes, served in this order */
+    enum Priority {
+        Interactive,    /** User is waiting for it, e.g. status update. Default for writes */
+        Normal,         /** Default for reads */
+        Background      /** Bulk work, e.g. follower crawl or prefetching */
+    };
+
+    QTweetRequestScheduler(QObject *parent = 0);
+    ~QTweetRequestScheduler();
+
+    void setMaxConcurrentRequests(int count);
+    int maxConcurrentRequests() const;
+    void setMaxConcurrentRequests(Priority priority, int count);
+    int maxConcurrentRequests(Priority priority) const;
+    void setMaxConcurrentRequestsPerHost(int count);
+    int maxConcurrentRequestsPerHost() const;
+
+    int queueDepth(Priority priority) const;
+    int runningCount(Priority priority) const;
+    qint64 startedRequests(Priority priority) const;
+    qint64 averageWaitTime(Priority priority) const;
+    qint64 maxWaitTime(Priority priority) const;
+    void resetStatistics();
+
+private slots:
+    void schedule();
+    void replyFinished();
+    void replyDestroyed(QObject *reply);
+
+private:
+    friend class QTweetNetBase;
+
+    struct Entry {
+        QPointer<QTweetNetBase> endpoint;
+        QTweetPendingRequest *pending;
+        QString host;
+        QElapsedTimer queuedFor;
+    };
+
+    struct PriorityClass {
+        PriorityClass();
+
+        QHash<const OAuthTwitter*, QQueue<Entry> > queues;
+        // accounts with queued requests, in order of their turn
+        QList<const OAuthTwitter*> accounts;
+        int maxRunning;
+        int running;
+        int queued;
+        qint64 started;
+        qint64 totalWait;
+        qint64 maxWait;
+    };
+
+    struct Running {
+        Priority priority;
+        QString host;
+    };
+
+    void submit(QTweetNetBase *endpoint, Priority priority, QTweetPendingRequest *pending, const QString& host);
+    bool cancel(QTweetPendingRequest *pending);
+    bool startNext(Priority priority);
+    void start(Priority priority, const Entry& entry);
+    void release(QNetworkReply *reply);
+    void scheduleLater();
+
+    PriorityClass m_classes[Background + 1];
+    QHash<QNetworkReply*, Running> m_running;
+    QHash<QString, int> m_hostRunning;
+    int m_maxRunning;
+    int m_maxHostRunning;
+    int m_totalRunning;
+    bool m_schedulePending;
+};
+
+#endif // QTWEETREQUESTSCHEDULER_H
@@ -0,0 +1,332 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QNetworkRequest>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include "qtweetresponsecache.h"
+#include "qtweetrequestcoalescer.h"
+#include "json/qjsondocument.h"
+
+// bump when layout of the cache file changes
+static const quint8 cacheFileVersion = 1;
+
+struct QTweetResponseCache::Entry
+{
+    QByteArray etag;
+    QByteArray lastModified;
+    QByteArray response;
+    QJsonDocument jsonDoc;  // null until parsed
+};
+
+/**
+ *  Constructor
+ */
+QTweetResponseCache::QTweetResponseCache() :
+    m_entries(4 * 1024 * 1024), m_maximumDiskSize(32 * 1024 * 1024), m_diskSize(-1), m_hits(0), m_misses(0)
+{
+}
+
+/**
+ *  Destructor
+ */
+QTweetResponseCache::~QTweetResponseCache()
+{
+}
+
+/**
+ *  Sets memory budget in bytes of response data, 4 MB by default
+ */
+void QTweetResponseCache::setMaximumMemorySize(int bytes)
+{
+    m_entries.setMaxCost(bytes);
+}
+
+int QTweetResponseCache::maximumMemorySize() const
+{
+    return m_entries.maxCost();
+}
+
+/**
+ *  Sets directory where responses are stored, empty (default) keeps responses only in memory
+ */
+void QTweetResponseCache::setCacheDirectory(const QString &path)
+{
+    m_cacheDirectory = path;
+    m_diskSize = -1;
+
+    if (!path.isEmpty())
+        QDir().mkpath(path);
+}
+
+QString QTweetResponseCache::cacheDirectory() const
+{
+    return m_cacheDirectory;
+}
+
+/**
+ *  Sets disk budget in bytes, 32 MB by default. When it's exceeded, oldest files
+ *  are removed until three quarters of the budget are used.
+ */
+void QTweetResponseCache::setMaximumDiskSize(qint64 bytes)
+{
+    m_maximumDiskSize = bytes;
+    trimDisk();
+}
+
+qint64 QTweetResponseCache::maximumDiskSize() const
+{
+    return m_maximumDiskSize;
+}
+
+/**
+ *  Adds If-None-Match and If-Modified-Since headers of cached response to the GET request
+ */
+void QTweetResponseCache::addValidators(QNetworkRequest *request)
+{
+    Entry *cached = entry(QTweetRequestCoalescer::requestKey(*request));
+
+    if (!cached)
+        return;
+
+    if (!cached->etag.isEmpty())
+        request->setRawHeader("If-None-Match", cached->etag);
+
+    if (!cached->lastModified.isEmpty())
+        request->setRawHeader("If-Modified-Since", cached->lastModified);
+}
+
+/**
+ *  Finds cached response, called when server answers 304
+ *  @param jsonDoc filled with parsed response, null when response isn't parsed yet
+ *                 (read from disk or parsed on parser thread), see insertParsed()
+ */
+bool QTweetResponseCache::find(const QNetworkRequest &request, QByteArray *response, QJsonDocument *jsonDoc)
+{
+    Entry *cached = entry(QTweetRequestCoalescer::requestKey(request));
+
+    if (!cached) {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+
+    if (response)
+        *response = cached->response;
+
+    if (jsonDoc)
+        *jsonDoc = cached->jsonDoc;
+
+    return true;
+}
+
+/**
+ *  Stores response, responses without validators are not stored
+ *  @param jsonDoc parsed response, null if it isn't parsed
+ */
+void QTweetResponseCache::insert(const QNetworkRequest &request, const QByteArray &etag, const QByteArray &lastModified,
+                                 const QByteArray &response, const QJsonDocument &jsonDoc)
+{
+    if (etag.isEmpty() && lastModified.isEmpty())
+        return;
+
+    QByteArray key = QTweetRequestCoalescer::requestKey(request);
+
+    Entry *cached = new Entry;
+    cached->etag = etag;
+    cached->lastModified = lastModified;
+    cached->response = response;
+    cached->jsonDoc = jsonDoc;
+
+    if (!m_cacheDirectory.isEmpty())
+        writeEntry(key, *cached);
+
+    // parsed document is bigger than the response, count it twice
+    m_entries.insert(key, cached, response.size() * 2);
+}
+
+/**
+ *  Stores parsed document of cached response
+ *  @param response response which was parsed, document isn't stored when it's no longer cached
+ */
+void QTweetResponseCache::insertParsed(const QNetworkRequest &request, const QByteArray &response,
+                                       const QJsonDocument &jsonDoc)
+{
+    Entry *cached = m_entries.object(QTweetRequestCoalescer::requestKey(request));
+
+    if (cached && cached->jsonDoc.isNull() && cached->response == response)
+        cached->jsonDoc = jsonDoc;
+}
+
+/**
+ *  Removes cached response
+ */
+void QTweetResponseCache::remove(const QNetworkRequest &request)
+{
+    QByteArray key = QTweetRequestCoalescer::requestKey(request);
+
+    m_entries.remove(key);
+
+    if (m_cacheDirectory.isEmpty())
+        return;
+
+    QFileInfo info(fileName(key));
+
+    if (info.exists() && QFile::remove(info.filePath()) && m_diskSize >= 0)
+        m_diskSize -= info.size();
+}
+
+/**
+ *  Removes all cached responses, from memory and disk, and resets statistics
+ */
+void QTweetResponseCache::clear()
+{
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+
+    if (m_cacheDirectory.isEmpty())
+        return;
+
+    QDir dir(m_cacheDirectory);
+
+    foreach (const QString& file, dir.entryList(QStringList("*.cache"), QDir::Files))
+        dir.remove(file);
+
+    m_diskSize = 0;
+}
+
+/**
+ *  Gets number of 304 responses served from the cache
+ */
+qint64 QTweetResponseCache::hits() const
+{
+    return m_hits;
+}
+
+/**
+ *  Gets number of 304 responses without cached response
+ */
+qint64 QTweetResponseCache::misses() const
+{
+    return m_misses;
+}
+
+QTweetResponseCache::Entry* QTweetResponseCache::entry(const QByteArray &key)
+{
+    Entry *cached = m_entries.object(key);
+
+    if (cached || m_cacheDirectory.isEmpty())
+        return cached;
+
+    cached = readEntry(key);
+
+    if (!cached)
+        return 0;
+
+    m_entries.insert(key, cached, cached->response.size() * 2);
+
+    // entry bigger than memory budget is deleted by insert
+    return m_entries.object(key);
+}
+
+QString QTweetResponseCache::fileName(const QByteArray &key) const
+{
+    QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+
+    return m_cacheDirectory + '/' + QString::fromLatin1(hash) + ".cache";
+}
+
+QTweetResponseCache::Entry* QTweetResponseCache::readEntry(const QByteArray &key) const
+{
+    QFile file(fileName(key));
+
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    QDataStream stream(&file);
+
+    quint8 version;
+    QByteArray storedKey;
+
+    stream >> version >> storedKey;
+
+    if (version != cacheFileVersion || storedKey != key)
+        return 0;
+
+    Entry *cached = new Entry;
+    stream >> cached->etag >> cached->lastModified >> cached->response;
+
+    if (stream.status() != QDataStream::Ok) {
+        delete cached;
+        return 0;
+    }
+
+    return cached;
+}
+
+void QTweetResponseCache::writeEntry(const QByteArray &key, const Entry &entry)
+{
+    QFile file(fileName(key));
+    qint64 oldSize = file.size();
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    QDataStream stream(&file);
+    stream << cacheFileVersion << key << entry.etag << entry.lastModified << entry.response;
+    file.close();
+
+    // directory is scanned only when its size isn't known yet or budget is exceeded
+    if (m_diskSize >= 0)
+        m_diskSize += file.size() - oldSize;
+
+    if (m_diskSize < 0 || m_diskSize > m_maximumDiskSize)
+        trimDisk();
+}
+
+void QTweetResponseCache::trimDisk()
+{
+    if (m_cacheDirectory.isEmpty())
+        return;
+
+    // below the budget, so next writes don't scan the directory again
+    qint64 target = m_maximumDiskSize / 4 * 3;
+
+    QDir dir(m_cacheDirectory);
+    QFileInfoList files = dir.entryInfoList(QStringList("*.cache"), QDir::Files, QDir::Time | QDir::Reversed);
+
+    qint64 size = 0;
+
+    foreach (const QFileInfo& info, files)
+        size += info.size();
+
+    if (size <= m_maximumDiskSize)
+        target = size;
+
+    // oldest first
+    for (int i = 0; i < files.size() && size > target; ++i) {
+        size -= files.at(i).size();
+        dir.remove(files.at(i).fileName());
+    }
+
+    m_diskSize = size;
+}
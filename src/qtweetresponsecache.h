@@ -0,0 +1,83 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETRESPONSECACHE_H
+#define QTWEETRESPONSECACHE_H
+
+#include <QCache>
+#include <QByteArray>
+#include <QString>
+#include "qtweetlib_global.h"
+
+class QNetworkRequest;
+class QJsonDocument;
+
+/**
+ *  Cache of GET responses validated with conditional requests
+ *
+ *  Responses with ETag or Last-Modified are stored by canonical url
+ *  (Authorization header excluded), next identical GET sends If-None-Match
+ *  and If-Modified-Since. 304 Not Modified is served from the cache with
+ *  the already parsed response instead of being reported as error.
+ *  Kept in memory and optionally on disk, each with its own budget.
+ *  Enabled with OAuthTwitter::setResponseCache(). Not thread safe, used from
+ *  the thread of the network access manager.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetResponseCache
+{
+public:
+    QTweetResponseCache();
+    ~QTweetResponseCache();
+
+    void setMaximumMemorySize(int bytes);
+    int maximumMemorySize() const;
+    void setCacheDirectory(const QString& path);
+    QString cacheDirectory() const;
+    void setMaximumDiskSize(qint64 bytes);
+    qint64 maximumDiskSize() const;
+
+    void addValidators(QNetworkRequest *request);
+    bool find(const QNetworkRequest& request, QByteArray *response, QJsonDocument *jsonDoc);
+    void insert(const QNetworkRequest& request, const QByteArray& etag, const QByteArray& lastModified,
+                const QByteArray& response, const QJsonDocument& jsonDoc);
+    void insertParsed(const QNetworkRequest& request, const QByteArray& response, const QJsonDocument& jsonDoc);
+    void remove(const QNetworkRequest& request);
+    void clear();
+
+    qint64 hits() const;
+    qint64 misses() const;
+
+private:
+    Q_DISABLE_COPY(QTweetResponseCache)
+
+    struct Entry;
+
+    Entry* entry(const QByteArray& key);
+    QString fileName(const QByteArray& key) const;
+    Entry* readEntry(const QByteArray& key) const;
+    void writeEntry(const QByteArray& key, const Entry& entry);
+    void trimDisk();
+
+    QCache<QByteArray, Entry> m_entries;
+    QString m_cacheDirectory;
+    qint64 m_maximumDiskSize;
+    qint64 m_diskSize;  // -1 until directory is scanned
+    qint64 m_hits;
+    qint64 m_misses;
+};
+
+#endif // QTWEETRESPONSECACHE_H
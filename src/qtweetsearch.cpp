@@ -20,17 +20,20 @@
 #include <QNetworkReply>
 #include "qtweetsearch.h"
 #include "qtweetsearchpageresults.h"
+#include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonobject.h"
+#include "json/qjsonarray.h"
 
 QTweetSearch::QTweetSearch(QObject *parent) :
-    QTweetNetBase(parent)
+    QTweetNetBase(parent), m_statusResults(false)
 {
 }
 
 QTweetSearch::QTweetSearch(OAuthTwitter *oauthTwitter, QObject *parent) :
-    QTweetNetBase(oauthTwitter, parent)
+    QTweetNetBase(oauthTwitter, parent), m_statusResults(false)
 {
 }
 
@@ -49,7 +52,7 @@ void QTweetSearch::start(const QString &query,
                          int page,
                          qint64 sinceid)
 {
-    QUrl url("http://search.twitter.com/search.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::SearchApi, "search.json");
 
     url.addEncodedQueryItem("q", QUrl::toPercentEncoding(query));
 
@@ -75,13 +78,12 @@ void QTweetSearch::start(const QString &query,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetSearch::startWithCustomQuery(const QByteArray &encodedQuery)
 {
-    QUrl url("http://search.twitter.com/search.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::SearchApi, "search.json");
 
     //remove ?
     QByteArray query(encodedQuery);
@@ -92,15 +94,47 @@ void QTweetSearch::startWithCustomQuery(const QByteArray &encodedQuery)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
+}
+
+/**
+ *  Enables converting search results into statuses
+ *  @param enable true to emit parsedStatuses (or parsedStatusBatch when status batch is enabled)
+ *                instead of parsedPageResults
+ *  @remarks Page fields (max id, next page...) are not emitted, use QTweetSnowflake for paging
+ */
+void QTweetSearch::setStatusResultsEnabled(bool enable)
+{
+    m_statusResults = enable;
+}
+
+/**
+ *  Gets if search results are converted into statuses
+ */
+bool QTweetSearch::isStatusResultsEnabled() const
+{
+    return m_statusResults;
 }
 
 void QTweetSearch::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetSearchPageResults pageResults = QTweetConvert::jsonObjectToSearchPageResults(jsonDoc.object());
-
-        emit parsedPageResults(pageResults);
+        if (m_statusResults) {
+            QJsonArray resultArray = jsonDoc.object().value("results").toArray();
+            QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToSearchStatusList(resultArray, userPool(), convertOptions());
+
+            if (isStatusBatchEnabled()) {
+                QTweetStatusBatch batch;
+                batch.append(statuses);
+
+                emit parsedStatusBatch(batch);
+            } else {
+                emit parsedStatuses(statuses);
+            }
+        } else {
+            QTweetSearchPageResults pageResults = QTweetConvert::jsonObjectToSearchPageResults(jsonDoc.object());
+
+            emit parsedPageResults(pageResults);
+        }
     }
 }
@@ -26,6 +26,7 @@
 class QTWEETLIBSHARED_EXPORT QTweetSearch : public QTweetNetBase
 {
     Q_OBJECT
+    Q_PROPERTY(bool statusResults READ isStatusResultsEnabled WRITE setStatusResultsEnabled)
 public:
     QTweetSearch(QObject *parent = 0);
     QTweetSearch(OAuthTwitter *oauthTwitter, QObject *parent = 0);
@@ -40,12 +41,24 @@ public:
                );
     void startWithCustomQuery(const QByteArray& encodedQuery);
 
+    void setStatusResultsEnabled(bool enable);
+    bool isStatusResultsEnabled() const;
+
 signals:
     /** Emits page of search results */
     void parsedPageResults(const QTweetSearchPageResults& pageResults);
 
+    /**
+     *  Emits search results converted into statuses, instead of parsedPageResults
+     *  when status results are enabled
+     */
+    void parsedStatuses(const QList<QTweetStatus>& statuses);
+
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
+
+private:
+    bool m_statusResults;
 };
 
 #endif // QTWEETSEARCH_H
@@ -18,11 +18,14 @@
 #include "qtweetsearchresult.h"
 #include <QSharedData>
 #include <QDateTime>
+#include "qtweetconvert.h"
 //#include "qtweetuser.h"
 
 class QTweetSearchResultData : public QSharedData {
 public:
-    QDateTime createdAt;
+    QTweetSearchResultData() : createdAt(QTweetConvert::InvalidEpoch) {}
+
+    qint64 createdAt;   // seconds since epoch
     QString fromUser;
     //qint64 fromUserId;    // USELESS. It's not same as general twitter user id
     qint64 id;
@@ -55,9 +58,44 @@ QTweetSearchResult::~QTweetSearchResult()
 {
 }
 
+void QTweetSearchResult::swap(QTweetSearchResult &other)
+{
+    data.swap(other.data);
+}
+
+void QTweetSearchResult::moveFromUser(QString &screenName)
+{
+    data->fromUser.swap(screenName);
+}
+
+void QTweetSearchResult::moveLang(QString &lang)
+{
+    data->lang.swap(lang);
+}
+
+void QTweetSearchResult::moveProfileImageUrl(QString &url)
+{
+    data->profileImageUrl.swap(url);
+}
+
+void QTweetSearchResult::moveSource(QString &source)
+{
+    data->source.swap(source);
+}
+
+void QTweetSearchResult::moveText(QString &text)
+{
+    data->text.swap(text);
+}
+
+void QTweetSearchResult::moveToUser(QString &screenName)
+{
+    data->toUser.swap(screenName);
+}
+
 void QTweetSearchResult::setCreatedAt(const QDateTime &dateTime)
 {
-    data->createdAt = dateTime;
+    data->createdAt = QTweetConvert::dateTimeToEpoch(dateTime);
 }
 
 // Oh, not again. ANOTHER datetime format from twitter.
@@ -65,20 +103,20 @@ void QTweetSearchResult::setCreatedAt(const QDateTime &dateTime)
 
 void QTweetSearchResult::setCreatedAt(const QString &twitterDate)
 {
-    QString dateString = twitterDate.left(3) + ' ' + twitterDate.mid(8, 3) + ' ' +
-                         twitterDate.mid(5, 2) + ' ' + twitterDate.mid(12, 4);
-    QString timeString = twitterDate.mid(17, 8);
+    data->createdAt = QTweetConvert::searchDateToEpoch(twitterDate);
+}
 
-    QDate date = QDate::fromString(dateString);
-    QTime time = QTime::fromString(timeString);
+QDateTime QTweetSearchResult::createdAt() const
+{
+    return QTweetConvert::epochToDateTime(data->createdAt);
+}
 
-    if (date.isValid() && time.isValid())
-        data->createdAt = QDateTime(date, time, Qt::UTC);
-    else
-        data->createdAt = QDateTime();
+void QTweetSearchResult::setCreatedAtEpoch(qint64 secs)
+{
+    data->createdAt = secs;
 }
 
-QDateTime QTweetSearchResult::createdAt() const
+qint64 QTweetSearchResult::createdAtEpoch() const
 {
     return data->createdAt;
 }
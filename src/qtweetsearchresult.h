@@ -34,10 +34,13 @@ public:
     QTweetSearchResult(const QTweetSearchResult &);
     QTweetSearchResult &operator=(const QTweetSearchResult &);
     ~QTweetSearchResult();
+    void swap(QTweetSearchResult &other);
 
     void setCreatedAt(const QString& twitterDate);
     void setCreatedAt(const QDateTime& dateTime);
     QDateTime createdAt() const;
+    void setCreatedAtEpoch(qint64 secs);
+    qint64 createdAtEpoch() const;
     void setFromUser(const QString& screenName);
     QString fromUser() const;
     void setId(qint64 id);
@@ -53,7 +56,26 @@ public:
     void setToUser(const QString& screenName);
     QString toUser() const;
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetSearchResult &operator=(QTweetSearchResult &&other) { swap(other); return *this; }
+    void setFromUser(QString&& screenName) { moveFromUser(screenName); }
+    void setLang(QString&& lang) { moveLang(lang); }
+    void setProfileImageUrl(QString&& url) { moveProfileImageUrl(url); }
+    void setSource(QString&& source) { moveSource(source); }
+    void setText(QString&& text) { moveText(text); }
+    void setToUser(QString&& screenName) { moveToUser(screenName); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveFromUser(QString& screenName);
+    void moveLang(QString& lang);
+    void moveProfileImageUrl(QString& url);
+    void moveSource(QString& source);
+    void moveText(QString& text);
+    void moveToUser(QString& screenName);
+
     QSharedDataPointer<QTweetSearchResultData> data;
 };
 
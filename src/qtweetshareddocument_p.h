@@ -0,0 +1,63 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSHAREDDOCUMENT_P_H
+#define QTWEETSHAREDDOCUMENT_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by QTweetRequestCoalescer
+//  and QTweetNetBase and may change without notice.
+//
+
+#include <QSharedData>
+#include <QMutex>
+#include <QByteArray>
+#include "json/qjsondocument.h"
+
+// Response of coalesced request shared by its endpoints. Parsed once, by the
+// first endpoint converting it, on its thread or on parser thread
+class QTweetSharedDocument : public QSharedData
+{
+public:
+    explicit QTweetSharedDocument(const QByteArray& response) :
+        m_response(response), m_parsed(false)
+    {
+    }
+
+    // Gets parsed response, parses it when it isn't yet, thread safe
+    QJsonDocument document()
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (!m_parsed) {
+            m_document = QJsonDocument::fromJson(m_response);
+            m_parsed = true;
+        }
+
+        return m_document;
+    }
+
+private:
+    Q_DISABLE_COPY(QTweetSharedDocument)
+
+    QMutex m_mutex;
+    QByteArray m_response;
+    QJsonDocument m_document;
+    bool m_parsed;
+};
+
+#endif // QTWEETSHAREDDOCUMENT_P_H
@@ -0,0 +1,97 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QDateTime>
+#include "qtweetsnowflake.h"
+
+const qint64 QTweetSnowflake::NoOlderIds;
+
+/**
+ *  Gets creation time of the id in milliseconds since Unix epoch (UTC)
+ */
+qint64 QTweetSnowflake::toMSecsSinceEpoch(qint64 id)
+{
+    return (id >> TimestampShift) + Epoch;
+}
+
+/**
+ *  Gets creation time of the id (UTC)
+ */
+QDateTime QTweetSnowflake::toDateTime(qint64 id)
+{
+    return QDateTime::fromMSecsSinceEpoch(toMSecsSinceEpoch(id)).toUTC();
+}
+
+/**
+ *  Gets smallest id which can be created at given time
+ *  @param msecs milliseconds since Unix epoch (UTC)
+ *  @return 0 for time before twitter epoch
+ */
+qint64 QTweetSnowflake::fromMSecsSinceEpoch(qint64 msecs)
+{
+    if (msecs <= Epoch)
+        return 0;
+
+    return (msecs - Epoch) << TimestampShift;
+}
+
+/**
+ *  Gets smallest id which can be created at given time
+ */
+qint64 QTweetSnowflake::fromDateTime(const QDateTime &dateTime)
+{
+    return fromMSecsSinceEpoch(dateTime.toMSecsSinceEpoch());
+}
+
+/**
+ *  Gets since id and max id arguments selecting statuses created in [from, to)
+ *  @param from start of the window, inclusive
+ *  @param to end of the window, exclusive
+ *  @param sinceId filled with since id (ids greater than it are returned)
+ *  @param maxId filled with max id (ids less than or equal to it are returned),
+ *               NoOlderIds when window ends before twitter epoch
+ */
+void QTweetSnowflake::idRange(const QDateTime &from, const QDateTime &to, qint64 *sinceId, qint64 *maxId)
+{
+    if (sinceId)
+        *sinceId = sinceIdFor(from);
+
+    if (maxId)
+        *maxId = maxIdFor(to);
+}
+
+/**
+ *  Gets since id selecting statuses created at or after from
+ *  @return 0 (no limit) for time before twitter epoch
+ */
+qint64 QTweetSnowflake::sinceIdFor(const QDateTime &from)
+{
+    qint64 id = fromDateTime(from);
+
+    return id ? id - 1 : 0;
+}
+
+/**
+ *  Gets max id selecting statuses created before to
+ *  @return NoOlderIds for time before twitter epoch
+ */
+qint64 QTweetSnowflake::maxIdFor(const QDateTime &to)
+{
+    qint64 id = fromDateTime(to);
+
+    return id ? id - 1 : NoOlderIds;
+}
@@ -0,0 +1,152 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSNOWFLAKE_H
+#define QTWEETSNOWFLAKE_H
+
+#include <QList>
+#include <QtAlgorithms>
+#include "qtweetlib_global.h"
+
+class QDateTime;
+
+/**
+ *  Utilities for time ordered (snowflake) ids of statuses and direct messages
+ *
+ *  Snowflake id keeps milliseconds since twitter epoch in bits above 22,
+ *  so ids can be converted to time and back, and sorting by id is sorting
+ *  by creation time without parsing dates.
+ *  @remarks Ids created before November 2010 are sequential, not snowflakes
+ */
+class QTWEETLIBSHARED_EXPORT QTweetSnowflake
+{
+public:
+    /** Twitter epoch in milliseconds since Unix epoch */
+    static const qint64 Epoch = Q_INT64_C(1288834974657);
+    /** Bits below the timestamp (worker, sequence) */
+    static const int TimestampShift = 22;
+    /**
+     *  Max id meaning there can't be older ids, nothing to fetch.
+     *  Max id 0 would mean no limit to timelines.
+     */
+    static const qint64 NoOlderIds = -1;
+
+    static qint64 toMSecsSinceEpoch(qint64 id);
+    static QDateTime toDateTime(qint64 id);
+    static qint64 fromMSecsSinceEpoch(qint64 msecs);
+    static qint64 fromDateTime(const QDateTime& dateTime);
+
+    static void idRange(const QDateTime& from, const QDateTime& to, qint64 *sinceId, qint64 *maxId);
+    static qint64 sinceIdFor(const QDateTime& from);
+    static qint64 maxIdFor(const QDateTime& to);
+
+    /**
+     *  Compares ids, newest first (order of timelines)
+     *  @remarks Works with anything with id(): statuses, direct messages, search results
+     */
+    template <typename T>
+    static bool newerThan(const T& left, const T& right)
+    {
+        return left.id() > right.id();
+    }
+
+    /** Compares ids, oldest first */
+    template <typename T>
+    static bool olderThan(const T& left, const T& right)
+    {
+        return left.id() < right.id();
+    }
+
+    /** Sorts newest first, stable for equal ids */
+    template <typename T>
+    static void sortNewestFirst(QList<T>& list)
+    {
+        qStableSort(list.begin(), list.end(), newerThan<T>);
+    }
+
+    /**
+     *  Merges two lists sorted newest first, element with the same id is kept once
+     *  @remarks For joining pages or refreshes of the same timeline
+     */
+    template <typename T>
+    static QList<T> merge(const QList<T>& left, const QList<T>& right)
+    {
+        QList<T> merged;
+        merged.reserve(left.size() + right.size());
+
+        int i = 0;
+        int j = 0;
+
+        while (i < left.size() && j < right.size()) {
+            qint64 leftId = left.at(i).id();
+            qint64 rightId = right.at(j).id();
+
+            if (leftId > rightId) {
+                merged.append(left.at(i++));
+            } else if (rightId > leftId) {
+                merged.append(right.at(j++));
+            } else {
+                merged.append(left.at(i++));
+                ++j;
+            }
+        }
+
+        while (i < left.size())
+            merged.append(left.at(i++));
+
+        while (j < right.size())
+            merged.append(right.at(j++));
+
+        return merged;
+    }
+
+    /**
+     *  Gets since id for fetching statuses newer than the list
+     *  @return biggest id in the list, 0 for empty list
+     */
+    template <typename T>
+    static qint64 nextSinceId(const QList<T>& list)
+    {
+        qint64 sinceId = 0;
+
+        for (int i = 0; i < list.size(); ++i)
+            sinceId = qMax(sinceId, list.at(i).id());
+
+        return sinceId;
+    }
+
+    /**
+     *  Gets max id for fetching statuses older than the list
+     *  @return smallest id in the list minus one, 0 (no limit) for empty list,
+     *          NoOlderIds when the list reaches the smallest id
+     */
+    template <typename T>
+    static qint64 nextMaxId(const QList<T>& list)
+    {
+        if (list.isEmpty())
+            return 0;
+
+        qint64 maxId = list.at(0).id();
+
+        for (int i = 1; i < list.size(); ++i)
+            maxId = qMin(maxId, list.at(i).id());
+
+        return maxId > 1 ? maxId - 1 : NoOlderIds;
+    }
+};
+
+#endif // QTWEETSNOWFLAKE_H
@@ -15,77 +15,171 @@
  * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
  */
 
-#include <QSharedData>
 #include <QDateTime>
-#include "qtweetstatus.h"
-#include "qtweetuser.h"
-#include "qtweetplace.h"
+#include <QSize>
+#include <string.h>
+#include "qtweetstatus_p.h"
 #include "qtweetentityurl.h"
 #include "qtweetentityhashtag.h"
 #include "qtweetentityusermentions.h"
 #include "qtweetentitymedia.h"
+#include "qtweetconvert.h"
 
-class QTweetStatusData : public QSharedData
-{
-public:
-    QTweetStatusData() : id(0), inReplyToStatusId(0), retweetedStatus(0) {}
-
-    QTweetStatusData(const QTweetStatusData& other) : QSharedData(other)
-    {
-        id = other.id;
-        text = other.text;
-        createdAt = other.createdAt;
-        inReplyToUserId = other.inReplyToUserId;
-        inReplyToScreenName = other.inReplyToScreenName;
-        inReplyToStatusId = other.inReplyToStatusId;
-        favorited = other.favorited;
-        source = other.source;
-        user = other.user;
-        place = other.place;
-
-        if (other.retweetedStatus) {
-            retweetedStatus = new QTweetStatus(*other.retweetedStatus);
-        } else {
-            retweetedStatus = 0;
-        }
+// Twitter indices count code points, QString counts UTF-16 units
+static int codePointToUtf16(const QString& text, int index)
+{
+    int pos = 0;
+
+    for (int i = 0; i < index && pos < text.size(); ++i) {
+        if (text.at(pos).isHighSurrogate() && pos + 1 < text.size() && text.at(pos + 1).isLowSurrogate())
+            pos += 2;
+        else
+            pos += 1;
+    }
+
+    return pos;
+}
+
+QTweetStatusData::QTweetStatusData() :
+    favorited(false),
+    id(0),
+    createdAt(QTweetConvert::InvalidEpoch),
+    inReplyToUserId(0),
+    inReplyToStatusId(0)
+{
+}
+
+QTweetEntityRecord QTweetStatusData::newEntity(QTweetStatus::EntityType type, int lowerIndex, int higherIndex)
+{
+    QTweetEntityRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.lowerIndex = lowerIndex;
+    record.higherIndex = higherIndex;
+    record.textPosition = -1;
+    return record;
+}
+
+/**
+ *  Position of the string in the text, -1 if it isn't there
+ */
+int QTweetStatusData::findInText(const QTweetEntityRecord& record, const QString& string) const
+{
+    if (string.isEmpty())
+        return -1;
+
+    // skip # and @
+    int skip = (record.type == QTweetStatus::HashtagEntity ||
+                record.type == QTweetStatus::UserMentionsEntity) ? 1 : 0;
+
+    int pos = record.lowerIndex + skip;
+
+    if (text.midRef(pos, string.size()) == string)
+        return pos;
+
+    pos = codePointToUtf16(text, record.lowerIndex) + skip;
+
+    if (text.midRef(pos, string.size()) == string)
+        return pos;
+
+    return -1;
+}
+
+/**
+ *  Appends entity, strings are in the order of the record string slots
+ */
+void QTweetStatusData::appendEntity(QTweetEntityRecord record, const QString *strings, int count)
+{
+    int textSlot = QTweetEntityRecord::textSlot(record.type);
+
+    if (textSlot < count)
+        record.textPosition = findInText(record, strings[textSlot]);
+
+    record.stringOffset = entityStrings.size();
+    richText.clear();
+
+    for (int i = 0; i < count; ++i) {
+        int length = qMin(strings[i].size(), 0xffff);
+        record.stringLength[i] = length;
+
+        if (!record.isInText(i))
+            entityStrings.append(QStringRef(&strings[i], 0, length));
     }
 
-    ~QTweetStatusData()
-    {
-        delete retweetedStatus;
+    entities.append(record);
+}
+
+QStringRef QTweetStatusData::entityStringRef(const QTweetEntityRecord& record, int slot) const
+{
+    if (record.isInText(slot))
+        return QStringRef(&text, record.textPosition, record.stringLength[slot]);
+
+    int offset = record.stringOffset;
+
+    for (int i = 0; i < slot; ++i) {
+        if (!record.isInText(i))
+            offset += record.stringLength[i];
     }
 
-    qint64 id;
-    QString text;
-    QDateTime createdAt;
-    qint64 inReplyToUserId;
-    QString inReplyToScreenName;
-    qint64 inReplyToStatusId;
-    bool favorited;
-    QString source;
-    QTweetUser user;
-    QTweetStatus *retweetedStatus;
-    QTweetPlace place;
-    QList<QTweetEntityUrl> urlEntities;
-    QList<QTweetEntityHashtag> hashtagEntities;
-    QList<QTweetEntityUserMentions> userMentionEntities;
-    QList<QTweetEntityMedia> mediaEntities;
-};
+    return QStringRef(&entityStrings, offset, record.stringLength[slot]);
+}
+
+QString QTweetStatusData::entityString(const QTweetEntityRecord& record, int slot) const
+{
+    return entityStringRef(record, slot).toString();
+}
+
+/**
+ *  Moves strings which are ranges of the text to entityStrings, called before text is changed
+ */
+void QTweetStatusData::detachEntitiesFromText()
+{
+    bool inText = false;
+
+    foreach (const QTweetEntityRecord& record, entities)
+        inText |= record.textPosition >= 0;
+
+    if (!inText)
+        return;
+
+    QString strings;
+
+    for (int i = 0; i < entities.size(); ++i) {
+        QTweetEntityRecord& record = entities[i];
+        int stringOffset = strings.size();
+
+        for (int slot = 0; slot < QTweetEntityRecord::MaxStrings; ++slot)
+            strings.append(entityStringRef(record, slot));
+
+        record.stringOffset = stringOffset;
+        record.textPosition = -1;
+    }
+
+    entityStrings = strings;
+}
 
 QTweetStatus::QTweetStatus() :
         d(new QTweetStatusData)
 {
 }
 
+QTweetStatus::QTweetStatus(const QSharedDataPointer<QTweetStatusData> &data) :
+        d(data)
+{
+}
+
 QTweetStatus::QTweetStatus(const QTweetStatus &other) :
         d(other.d)
 {
+    QTWEET_COUNT_REF();
 }
 
 QTweetStatus& QTweetStatus::operator=(const QTweetStatus &rhs)
 {
-    if (this != &rhs)
+    if (this != &rhs) {
+        QTWEET_COUNT_REF();
         d.operator=(rhs.d);
+    }
     return *this;
 }
 
@@ -93,6 +187,38 @@ QTweetStatus::~QTweetStatus()
 {
 }
 
+void QTweetStatus::swap(QTweetStatus &other)
+{
+    d.swap(other.d);
+}
+
+void QTweetStatus::moveText(QString &text)
+{
+    d->detachEntitiesFromText();
+    d->text.swap(text);
+    d->richText.clear();
+}
+
+void QTweetStatus::moveInReplyToScreenName(QString &screenName)
+{
+    d->inReplyToScreenName.swap(screenName);
+}
+
+void QTweetStatus::moveSource(QString &source)
+{
+    d->source.swap(source);
+}
+
+void QTweetStatus::moveUser(QTweetUser &user)
+{
+    d->user.swap(user);
+}
+
+void QTweetStatus::movePlace(QTweetPlace &place)
+{
+    d->place.swap(place);
+}
+
 void QTweetStatus::setId(qint64 id)
 {
     d->id = id;
@@ -105,7 +231,9 @@ qint64 QTweetStatus::id() const
 
 void QTweetStatus::setText(const QString &text)
 {
+    d->detachEntitiesFromText();
     d->text = text;
+    d->richText.clear();
 }
 
 QString QTweetStatus::text() const
@@ -115,15 +243,33 @@ QString QTweetStatus::text() const
 
 void QTweetStatus::setCreatedAt(const QString &twitterDate)
 {
-    d->createdAt = QTweetUser::twitterDateToQDateTime(twitterDate);
+    d->createdAt = QTweetConvert::twitterDateToEpoch(twitterDate);
 }
 
 void QTweetStatus::setCreatedAt(const QDateTime &dateTime)
 {
-    d->createdAt = dateTime;
+    d->createdAt = QTweetConvert::dateTimeToEpoch(dateTime);
 }
 
 QDateTime QTweetStatus::createdAt() const
+{
+    return QTweetConvert::epochToDateTime(d->createdAt);
+}
+
+/**
+ *  Sets creation time in seconds since epoch (UTC)
+ */
+void QTweetStatus::setCreatedAtEpoch(qint64 secs)
+{
+    d->createdAt = secs;
+}
+
+/**
+ *  Gets creation time in seconds since epoch (UTC)
+ *  @return QTweetConvert::InvalidEpoch if it's not set
+ *  @remarks Cheaper than createdAt()
+ */
+qint64 QTweetStatus::createdAtEpoch() const
 {
     return d->createdAt;
 }
@@ -193,20 +339,34 @@ qint64 QTweetStatus::userid() const
     return d->user.id();
 }
 
+/**
+ *  Sets retweeted status, status data is shared, not copied.
+ *  Ignored when status is this status or (indirectly) retweets it
+ */
 void QTweetStatus::setRetweetedStatus(const QTweetStatus &status)
 {
-    if (!d->retweetedStatus)
-        d->retweetedStatus = new QTweetStatus;
+    // shared data pointing back to this data would be a ref count cycle and never freed
+    const QTweetStatusData *retweeted = status.d.constData();
+
+    while (retweeted) {
+        if (retweeted == d.constData())
+            return;
+
+        retweeted = retweeted->retweetedStatus.constData();
+    }
 
-    *d->retweetedStatus = status;
+    d->retweetedStatus = status.d;
 }
 
+/**
+ *  Gets retweeted status, shares data with the retweet (changing returned status detaches it)
+ */
 QTweetStatus QTweetStatus::retweetedStatus() const
 {
     if (!d->retweetedStatus)
         return QTweetStatus();
 
-    return *d->retweetedStatus;
+    return QTweetStatus(d->retweetedStatus);
 }
 
 void QTweetStatus::setPlace(const QTweetPlace &place)
@@ -229,40 +389,240 @@ bool QTweetStatus::isRetweet() const
 
 QList<QTweetEntityUrl> QTweetStatus::urlEntities() const
 {
-    return d->urlEntities;
+    QList<QTweetEntityUrl> urlEntities;
+
+    foreach (const QTweetEntityRecord& record, d->entities) {
+        if (record.type != UrlEntity)
+            continue;
+
+        QTweetEntityUrl urlEntity;
+        urlEntity.setUrl(d->entityString(record, QTweetEntityRecord::UrlUrl));
+        urlEntity.setDisplayUrl(d->entityString(record, QTweetEntityRecord::UrlDisplayUrl));
+        urlEntity.setExpandedUrl(d->entityString(record, QTweetEntityRecord::UrlExpandedUrl));
+        urlEntity.setLowerIndex(record.lowerIndex);
+        urlEntity.setHigherIndex(record.higherIndex);
+
+        urlEntities.append(urlEntity);
+    }
+
+    return urlEntities;
 }
 
 QList<QTweetEntityHashtag> QTweetStatus::hashtagEntities() const
 {
-    return d->hashtagEntities;
+    QList<QTweetEntityHashtag> hashtagEntities;
+
+    foreach (const QTweetEntityRecord& record, d->entities) {
+        if (record.type != HashtagEntity)
+            continue;
+
+        QTweetEntityHashtag hashtagEntity;
+        hashtagEntity.setText(d->entityString(record, QTweetEntityRecord::HashtagText));
+        hashtagEntity.setLowerIndex(record.lowerIndex);
+        hashtagEntity.setHigherIndex(record.higherIndex);
+
+        hashtagEntities.append(hashtagEntity);
+    }
+
+    return hashtagEntities;
 }
 
 QList<QTweetEntityUserMentions> QTweetStatus::userMentionsEntities() const
 {
-    return d->userMentionEntities;
+    QList<QTweetEntityUserMentions> userMentionsEntities;
+
+    foreach (const QTweetEntityRecord& record, d->entities) {
+        if (record.type != UserMentionsEntity)
+            continue;
+
+        QTweetEntityUserMentions userMentionsEntity;
+        userMentionsEntity.setScreenName(d->entityString(record, QTweetEntityRecord::MentionScreenName));
+        userMentionsEntity.setName(d->entityString(record, QTweetEntityRecord::MentionName));
+        userMentionsEntity.setUserid(record.userid);
+        userMentionsEntity.setLowerIndex(record.lowerIndex);
+        userMentionsEntity.setHigherIndex(record.higherIndex);
+
+        userMentionsEntities.append(userMentionsEntity);
+    }
+
+    return userMentionsEntities;
 }
 
 QList<QTweetEntityMedia> QTweetStatus::mediaEntities() const
 {
-    return d->mediaEntities;
+    QList<QTweetEntityMedia> mediaEntities;
+
+    foreach (const QTweetEntityRecord& record, d->entities) {
+        if (record.type != MediaEntity)
+            continue;
+
+        QTweetEntityMedia mediaEntity;
+        mediaEntity.setID(d->entityString(record, QTweetEntityRecord::MediaId));
+        mediaEntity.setMediaUrl(d->entityString(record, QTweetEntityRecord::MediaMediaUrl));
+        mediaEntity.setMediaUrlHttps(d->entityString(record, QTweetEntityRecord::MediaMediaUrlHttps));
+        mediaEntity.setUrl(d->entityString(record, QTweetEntityRecord::MediaUrl));
+        mediaEntity.setDisplayUrl(d->entityString(record, QTweetEntityRecord::MediaDisplayUrl));
+        mediaEntity.setExpandedUrl(d->entityString(record, QTweetEntityRecord::MediaExpandedUrl));
+
+        for (int i = QTweetEntityMedia::LARGE; i <= QTweetEntityMedia::THUMB; ++i)
+            mediaEntity.setSize(QSize(record.mediaSizes[i][0], record.mediaSizes[i][1]),
+                                static_cast<QTweetEntityMedia::MediaSize>(i));
+
+        mediaEntity.setLowerIndex(record.lowerIndex);
+        mediaEntity.setHigherIndex(record.higherIndex);
+
+        mediaEntities.append(mediaEntity);
+    }
+
+    return mediaEntities;
 }
 
 void QTweetStatus::addUrlEntity(const QTweetEntityUrl &urlEntity)
 {
-    d->urlEntities.append(urlEntity);
+    QTweetEntityRecord record = QTweetStatusData::newEntity(UrlEntity,
+                                                            urlEntity.lowerIndex(), urlEntity.higherIndex());
+    QString strings[] = { urlEntity.url(), urlEntity.displayUrl(), urlEntity.expandedUrl() };
+
+    d->appendEntity(record, strings, 3);
 }
 
 void QTweetStatus::addHashtagEntity(const QTweetEntityHashtag &hashtagEntity)
 {
-    d->hashtagEntities.append(hashtagEntity);
+    QTweetEntityRecord record = QTweetStatusData::newEntity(HashtagEntity,
+                                                            hashtagEntity.lowerIndex(), hashtagEntity.higherIndex());
+    QString strings[] = { hashtagEntity.text() };
+
+    d->appendEntity(record, strings, 1);
 }
 
 void QTweetStatus::addUserMentionsEntity(const QTweetEntityUserMentions &userMentionsEntity)
 {
-    d->userMentionEntities.append(userMentionsEntity);
+    QTweetEntityRecord record = QTweetStatusData::newEntity(UserMentionsEntity,
+                                                            userMentionsEntity.lowerIndex(), userMentionsEntity.higherIndex());
+    record.userid = userMentionsEntity.userid();
+    QString strings[] = { userMentionsEntity.screenName(), userMentionsEntity.name() };
+
+    d->appendEntity(record, strings, 2);
 }
 
 void QTweetStatus::addMediaEntity(const QTweetEntityMedia &mediaEntity)
 {
-    d->mediaEntities.append(mediaEntity);
+    QTweetEntityRecord record = QTweetStatusData::newEntity(MediaEntity,
+                                                            mediaEntity.lowerIndex(), mediaEntity.higherIndex());
+
+    for (int i = QTweetEntityMedia::LARGE; i <= QTweetEntityMedia::THUMB; ++i) {
+        QSize size = mediaEntity.size(static_cast<QTweetEntityMedia::MediaSize>(i));
+        record.mediaSizes[i][0] = qBound(0, size.width(), 0xffff);
+        record.mediaSizes[i][1] = qBound(0, size.height(), 0xffff);
+    }
+
+    QString strings[] = { mediaEntity.id(), mediaEntity.mediaUrl(), mediaEntity.mediaUrlHttps(),
+                          mediaEntity.url(), mediaEntity.displayUrl(), mediaEntity.expandedUrl() };
+
+    d->appendEntity(record, strings, 6);
+}
+
+/**
+ *  Gets number of entities (all types) of the status
+ */
+int QTweetStatus::entityCount() const
+{
+    return d->entities.size();
+}
+
+/**
+ *  Gets type of the i-th entity
+ */
+QTweetStatus::EntityType QTweetStatus::entityType(int i) const
+{
+    return static_cast<EntityType>(d->entities.at(i).type);
+}
+
+/**
+ *  Gets lower index of the i-th entity in the text (as sent by twitter)
+ */
+int QTweetStatus::entityLowerIndex(int i) const
+{
+    return d->entities.at(i).lowerIndex;
+}
+
+/**
+ *  Gets higher index of the i-th entity in the text (as sent by twitter)
+ */
+int QTweetStatus::entityHigherIndex(int i) const
+{
+    return d->entities.at(i).higherIndex;
+}
+
+/**
+ *  Gets text of the i-th entity: url for url and media entities,
+ *  hashtag text for hashtags, screen name for user mentions
+ *  @remarks Doesn't allocate. Valid while the status is alive and not modified.
+ */
+QStringRef QTweetStatus::entityTextRef(int i) const
+{
+    const QTweetEntityRecord& record = d->entities.at(i);
+    return d->entityStringRef(record, QTweetEntityRecord::textSlot(record.type));
+}
+
+/**
+ *  Gets display url of the i-th url or media entity, empty for other entities
+ *  @remarks Doesn't allocate. Valid while the status is alive and not modified.
+ */
+QStringRef QTweetStatus::entityDisplayUrlRef(int i) const
+{
+    const QTweetEntityRecord& record = d->entities.at(i);
+
+    if (record.type == UrlEntity)
+        return d->entityStringRef(record, QTweetEntityRecord::UrlDisplayUrl);
+    if (record.type == MediaEntity)
+        return d->entityStringRef(record, QTweetEntityRecord::MediaDisplayUrl);
+
+    return QStringRef();
+}
+
+/**
+ *  Gets expanded url of the i-th url or media entity, empty for other entities
+ *  @remarks Doesn't allocate. Valid while the status is alive and not modified.
+ */
+QStringRef QTweetStatus::entityExpandedUrlRef(int i) const
+{
+    const QTweetEntityRecord& record = d->entities.at(i);
+
+    if (record.type == UrlEntity)
+        return d->entityStringRef(record, QTweetEntityRecord::UrlExpandedUrl);
+    if (record.type == MediaEntity)
+        return d->entityStringRef(record, QTweetEntityRecord::MediaExpandedUrl);
+
+    return QStringRef();
+}
+
+/**
+ *  Gets user id of the i-th user mentions entity, 0 for other entities
+ */
+qint64 QTweetStatus::entityUserId(int i) const
+{
+    const QTweetEntityRecord& record = d->entities.at(i);
+
+    if (record.type == UserMentionsEntity)
+        return record.userid;
+
+    return 0;
+}
+
+/**
+ *  Sets cached rich text (HTML) form of the status text
+ *  @remarks Cleared when text or entities change. See QTweetTextRenderer.
+ */
+void QTweetStatus::setRichText(const QString &richText)
+{
+    d->richText = richText;
+}
+
+/**
+ *  Gets cached rich text (HTML) form of the status text, empty if it isn't rendered
+ */
+QString QTweetStatus::richText() const
+{
+    return d->richText;
 }
@@ -19,9 +19,11 @@
 #define QTWEETSTATUS_H
 
 #include <QVariant>
+#include <QString>
 #include <QSharedDataPointer>
 #include "qtweetlib_global.h"
 
+class QDataStream;
 class QDateTime;
 class QTweetUser;
 class QTweetStatusData;
@@ -37,10 +39,13 @@ class QTweetEntityMedia;
 class QTWEETLIBSHARED_EXPORT QTweetStatus
 {
 public:
+    enum EntityType { UrlEntity, HashtagEntity, UserMentionsEntity, MediaEntity };
+
     QTweetStatus();
     QTweetStatus(const QTweetStatus &other);
     QTweetStatus &operator=(const QTweetStatus &other);
     ~QTweetStatus();
+    void swap(QTweetStatus &other);
 
     void setId(qint64 id);
     qint64 id() const;
@@ -49,6 +54,8 @@ public:
     void setCreatedAt(const QString& twitterDate);
     void setCreatedAt(const QDateTime& dateTime);
     QDateTime createdAt() const;
+    void setCreatedAtEpoch(qint64 secs);
+    qint64 createdAtEpoch() const;
     void setInReplyToUserId(qint64 id);
     qint64 inReplyToUserId() const;
     void setInReplyToScreenName(const QString& screenName);
@@ -75,11 +82,45 @@ public:
     void addHashtagEntity(const QTweetEntityHashtag& hashtagEntity);
     void addUserMentionsEntity(const QTweetEntityUserMentions& userMentionsEntity);
     void addMediaEntity(const QTweetEntityMedia& mediaEntity);
+    int entityCount() const;
+    EntityType entityType(int i) const;
+    int entityLowerIndex(int i) const;
+    int entityHigherIndex(int i) const;
+    QStringRef entityTextRef(int i) const;
+    QStringRef entityDisplayUrlRef(int i) const;
+    QStringRef entityExpandedUrlRef(int i) const;
+    qint64 entityUserId(int i) const;
+    void setRichText(const QString& richText);
+    QString richText() const;
+
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetStatus &operator=(QTweetStatus &&other) { swap(other); return *this; }
+    void setText(QString&& text) { moveText(text); }
+    void setInReplyToScreenName(QString&& screenName) { moveInReplyToScreenName(screenName); }
+    void setSource(QString&& source) { moveSource(source); }
+    void setUser(QTweetUser&& user) { moveUser(user); }
+    void setPlace(QTweetPlace&& place) { movePlace(place); }
+#endif
 
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveText(QString& text);
+    void moveInReplyToScreenName(QString& screenName);
+    void moveSource(QString& source);
+    void moveUser(QTweetUser& user);
+    void movePlace(QTweetPlace& place);
+
+    friend class QTweetConvert;   // fills data in place
+
+    explicit QTweetStatus(const QSharedDataPointer<QTweetStatusData>& data);
+
     QSharedDataPointer<QTweetStatusData> d;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetStatus& status);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetStatus& status);
+
 Q_DECLARE_METATYPE(QTweetStatus)
 
 #endif // QTWEETSTATUS_H
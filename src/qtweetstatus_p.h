@@ -0,0 +1,109 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSTATUS_P_H
+#define QTWEETSTATUS_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by the converters
+//  to fill data in place and may change without notice.
+//
+
+#include <QSharedData>
+#include <QVector>
+#include <QString>
+#include "qtweetstatus.h"
+#include "qtweetuser.h"
+#include "qtweetplace.h"
+#include "qtweetdatastatistics_p.h"
+
+// Entity stored inline in the status instead of separately allocated entity object.
+// Strings of the entity are kept back to back in QTweetStatusData::entityStrings,
+// except the one which is already in the status text (url, hashtag, screen name),
+// that one is only range of the text.
+struct QTweetEntityRecord
+{
+    // string slots
+    enum {
+        UrlUrl = 0, UrlDisplayUrl, UrlExpandedUrl,
+        HashtagText = 0,
+        MentionScreenName = 0, MentionName,
+        MediaId = 0, MediaMediaUrl, MediaMediaUrlHttps, MediaUrl, MediaDisplayUrl, MediaExpandedUrl,
+        MaxStrings
+    };
+
+    union {
+        qint64 userid;              // user mentions
+        quint16 mediaSizes[4][2];   // media, width and height for each QTweetEntityMedia::MediaSize
+    };
+    int lowerIndex;
+    int higherIndex;
+    int stringOffset;
+    int textPosition;               // UTF-16 position of the text slot in status text, -1 if not in text
+    quint16 stringLength[MaxStrings];
+    quint8 type;                    // QTweetStatus::EntityType
+
+    static int textSlot(int type)
+    {
+        return type == QTweetStatus::MediaEntity ? int(MediaUrl) : 0;
+    }
+
+    bool isInText(int slot) const
+    {
+        return textPosition >= 0 && slot == textSlot(type);
+    }
+};
+
+Q_DECLARE_TYPEINFO(QTweetEntityRecord, Q_PRIMITIVE_TYPE);
+
+class QTweetStatusData : public QSharedData
+{
+public:
+    QTweetStatusData();
+
+    static QTweetEntityRecord newEntity(QTweetStatus::EntityType type, int lowerIndex, int higherIndex);
+    int findInText(const QTweetEntityRecord& record, const QString& string) const;
+    void appendEntity(QTweetEntityRecord record, const QString *strings, int count);
+    QStringRef entityStringRef(const QTweetEntityRecord& record, int slot) const;
+    QString entityString(const QTweetEntityRecord& record, int slot) const;
+    void detachEntitiesFromText();
+
+    // fills padding after QSharedData ref count
+    uint favorited : 1;
+
+    qint64 id;
+    qint64 createdAt;   // seconds since epoch
+    qint64 inReplyToUserId;
+    qint64 inReplyToStatusId;
+    // never changed through this pointer, shared by all copies of the retweet
+    // and with the retweeted status itself, null if not a retweet
+    QSharedDataPointer<QTweetStatusData> retweetedStatus;
+    QString text;
+    QString inReplyToScreenName;
+    QString source;
+    QTweetUser user;
+    QTweetPlace place;
+    QVector<QTweetEntityRecord> entities;
+    QString entityStrings;
+    // cached QTweetTextRenderer output, cleared when text or entities change
+    QString richText;
+#ifdef QTWEETLIB_DATA_STATISTICS
+    QTweetDataCounter counter;
+#endif
+};
+
+#endif // QTWEETSTATUS_P_H
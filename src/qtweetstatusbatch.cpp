@@ -0,0 +1,483 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QtAlgorithms>
+#include "qtweetstatusbatch_p.h"
+#include "qtweetstatus.h"
+
+void QTweetStatusBatchData::reserve(int size)
+{
+    ids.reserve(size);
+    createdAt.reserve(size);
+    userIds.reserve(size);
+    inReplyToStatusIds.reserve(size);
+    inReplyToUserIds.reserve(size);
+    retweetedStatusIds.reserve(size);
+    flags.reserve(size);
+    userIndexes.reserve(size);
+    texts.reserve(size);
+    sources.reserve(size);
+    inReplyToScreenNames.reserve(size);
+}
+
+QTweetBatchString QTweetStatusBatchData::appendString(const QString &string)
+{
+    QTweetBatchString range;
+    range.offset = strings.size();
+    range.length = string.size();
+
+    strings.append(string);
+
+    return range;
+}
+
+/**
+ *  Row of the user in the user table, trimmed user is replaced by full one
+ */
+int QTweetStatusBatchData::userIndex(const QTweetUser &user)
+{
+    QHash<qint64, int>::const_iterator it = userIndexById.constFind(user.id());
+
+    if (it != userIndexById.constEnd()) {
+        if (users.at(it.value()).screenName().isEmpty() && !user.screenName().isEmpty())
+            users[it.value()] = user;
+
+        return it.value();
+    }
+
+    users.append(user);
+    userIndexById.insert(user.id(), users.size() - 1);
+
+    return users.size() - 1;
+}
+
+// Orders rows by column value, ties by row, so sorting is deterministic
+class ColumnLessThan
+{
+public:
+    ColumnLessThan(const qint64 *column, Qt::SortOrder order) : m_column(column), m_order(order) {}
+
+    bool operator()(int left, int right) const
+    {
+        if (m_column[left] != m_column[right])
+            return (m_order == Qt::AscendingOrder) == (m_column[left] < m_column[right]);
+
+        return left < right;
+    }
+
+private:
+    const qint64 *m_column;
+    Qt::SortOrder m_order;
+};
+
+static QVector<int> sortedIndexes(const QVector<qint64>& column, Qt::SortOrder order)
+{
+    QVector<int> indexes(column.size());
+
+    for (int i = 0; i < indexes.size(); ++i)
+        indexes[i] = i;
+
+    qSort(indexes.begin(), indexes.end(), ColumnLessThan(column.constData(), order));
+
+    return indexes;
+}
+
+template <typename T>
+static QVector<T> gather(const QVector<T>& column, const QVector<int>& indexes)
+{
+    QVector<T> result(indexes.size());
+    const T *source = column.constData();
+    T *target = result.data();
+
+    for (int i = 0; i < indexes.size(); ++i)
+        target[i] = source[indexes.at(i)];
+
+    return result;
+}
+
+QTweetStatusBatch::QTweetStatusBatch() :
+        d(new QTweetStatusBatchData)
+{
+}
+
+QTweetStatusBatch::QTweetStatusBatch(const QTweetStatusBatch &other) :
+        d(other.d)
+{
+}
+
+QTweetStatusBatch& QTweetStatusBatch::operator=(const QTweetStatusBatch &other)
+{
+    if (this != &other)
+        d.operator =(other.d);
+    return *this;
+}
+
+QTweetStatusBatch::~QTweetStatusBatch()
+{
+}
+
+void QTweetStatusBatch::swap(QTweetStatusBatch &other)
+{
+    d.swap(other.d);
+}
+
+/**
+ *  Gets number of statuses
+ */
+int QTweetStatusBatch::size() const
+{
+    return d->ids.size();
+}
+
+bool QTweetStatusBatch::isEmpty() const
+{
+    return d->ids.isEmpty();
+}
+
+/**
+ *  Reserves space in all columns for size statuses
+ */
+void QTweetStatusBatch::reserve(int size)
+{
+    d->reserve(size);
+}
+
+void QTweetStatusBatch::clear()
+{
+    *this = QTweetStatusBatch();
+}
+
+/**
+ *  Appends status, entities and place of the status aren't kept
+ */
+void QTweetStatusBatch::append(const QTweetStatus &status)
+{
+    QTweetStatusBatchData *data = d.data();
+
+    quint8 flags = 0;
+
+    if (status.favorited())
+        flags |= Favorited;
+    if (status.isRetweet())
+        flags |= Retweet;
+    if (status.inReplyToStatusId())
+        flags |= Reply;
+
+    QTweetUser user = status.user();
+
+    data->ids.append(status.id());
+    data->createdAt.append(status.createdAtEpoch());
+    data->userIds.append(user.id());
+    data->inReplyToStatusIds.append(status.inReplyToStatusId());
+    data->inReplyToUserIds.append(status.inReplyToUserId());
+    data->retweetedStatusIds.append(status.isRetweet() ? status.retweetedStatus().id() : 0);
+    data->flags.append(flags);
+    data->userIndexes.append(data->userIndex(user));
+    data->texts.append(data->appendString(status.text()));
+    data->sources.append(data->appendString(status.source()));
+    data->inReplyToScreenNames.append(data->appendString(status.inReplyToScreenName()));
+}
+
+void QTweetStatusBatch::append(const QList<QTweetStatus> &statuses)
+{
+    QTweetStatusBatchData *data = d.data();
+    int count = data->ids.size() + statuses.size();
+
+    // exact reserve would reallocate all columns on every page, grow geometrically
+    if (count > data->ids.capacity())
+        data->reserve(qMax(count, data->ids.capacity() * 2));
+
+    foreach (const QTweetStatus& status, statuses)
+        append(status);
+}
+
+/**
+ *  Column of status ids, valid until batch is changed
+ */
+const qint64* QTweetStatusBatch::ids() const
+{
+    return d->ids.constData();
+}
+
+/**
+ *  Column of created at dates in seconds since epoch
+ */
+const qint64* QTweetStatusBatch::createdAtEpochs() const
+{
+    return d->createdAt.constData();
+}
+
+const qint64* QTweetStatusBatch::userIds() const
+{
+    return d->userIds.constData();
+}
+
+const qint64* QTweetStatusBatch::inReplyToStatusIds() const
+{
+    return d->inReplyToStatusIds.constData();
+}
+
+const qint64* QTweetStatusBatch::inReplyToUserIds() const
+{
+    return d->inReplyToUserIds.constData();
+}
+
+/**
+ *  Column of retweeted status ids, 0 when status isn't retweet
+ */
+const qint64* QTweetStatusBatch::retweetedStatusIds() const
+{
+    return d->retweetedStatusIds.constData();
+}
+
+/**
+ *  Column of flags (QTweetStatusBatch::Flag)
+ */
+const quint8* QTweetStatusBatch::flags() const
+{
+    return d->flags.constData();
+}
+
+qint64 QTweetStatusBatch::id(int i) const
+{
+    return d->ids.at(i);
+}
+
+qint64 QTweetStatusBatch::createdAtEpoch(int i) const
+{
+    return d->createdAt.at(i);
+}
+
+qint64 QTweetStatusBatch::userId(int i) const
+{
+    return d->userIds.at(i);
+}
+
+qint64 QTweetStatusBatch::inReplyToStatusId(int i) const
+{
+    return d->inReplyToStatusIds.at(i);
+}
+
+qint64 QTweetStatusBatch::inReplyToUserId(int i) const
+{
+    return d->inReplyToUserIds.at(i);
+}
+
+qint64 QTweetStatusBatch::retweetedStatusId(int i) const
+{
+    return d->retweetedStatusIds.at(i);
+}
+
+quint8 QTweetStatusBatch::flags(int i) const
+{
+    return d->flags.at(i);
+}
+
+/**
+ *  Gets text of i-th status, reference is valid until batch is changed or destroyed
+ */
+QStringRef QTweetStatusBatch::textRef(int i) const
+{
+    const QTweetBatchString& range = d->texts.at(i);
+    return QStringRef(&d->strings, range.offset, range.length);
+}
+
+QStringRef QTweetStatusBatch::sourceRef(int i) const
+{
+    const QTweetBatchString& range = d->sources.at(i);
+    return QStringRef(&d->strings, range.offset, range.length);
+}
+
+QStringRef QTweetStatusBatch::inReplyToScreenNameRef(int i) const
+{
+    const QTweetBatchString& range = d->inReplyToScreenNames.at(i);
+    return QStringRef(&d->strings, range.offset, range.length);
+}
+
+QTweetUser QTweetStatusBatch::user(int i) const
+{
+    return d->users.at(d->userIndexes.at(i));
+}
+
+/**
+ *  Builds status from i-th row
+ *  @remarks Retweeted status of the returned status has only id
+ */
+QTweetStatus QTweetStatusBatch::status(int i) const
+{
+    QTweetStatus status;
+    status.setId(id(i));
+    status.setCreatedAtEpoch(createdAtEpoch(i));
+    status.setText(textRef(i).toString());
+    status.setSource(sourceRef(i).toString());
+    status.setInReplyToStatusId(inReplyToStatusId(i));
+    status.setInReplyToUserId(inReplyToUserId(i));
+    status.setInReplyToScreenName(inReplyToScreenNameRef(i).toString());
+    status.setFavorited(flags(i) & Favorited);
+    status.setUser(user(i));
+
+    if (flags(i) & Retweet) {
+        QTweetStatus retweetedStatus;
+        retweetedStatus.setId(retweetedStatusId(i));
+        status.setRetweetedStatus(retweetedStatus);
+    }
+
+    return status;
+}
+
+QList<QTweetStatus> QTweetStatusBatch::toList() const
+{
+    QList<QTweetStatus> statuses;
+    statuses.reserve(size());
+
+    for (int i = 0; i < size(); ++i)
+        statuses.append(status(i));
+
+    return statuses;
+}
+
+// Filters below are branchless (index is always stored, count advances
+// when row matches), so the compiler can vectorize the comparisons.
+
+/**
+ *  Gets rows with id in [minId, maxId]
+ */
+QVector<int> QTweetStatusBatch::indexesInIdRange(qint64 minId, qint64 maxId) const
+{
+    const qint64 *column = d->ids.constData();
+    int size = d->ids.size();
+
+    QVector<int> indexes(size);
+    int *out = indexes.data();
+    int count = 0;
+
+    for (int i = 0; i < size; ++i) {
+        out[count] = i;
+        count += (column[i] >= minId) & (column[i] <= maxId);
+    }
+
+    indexes.resize(count);
+    return indexes;
+}
+
+/**
+ *  Gets rows created in [fromEpoch, toEpoch] (seconds since epoch)
+ */
+QVector<int> QTweetStatusBatch::indexesInTimeRange(qint64 fromEpoch, qint64 toEpoch) const
+{
+    const qint64 *column = d->createdAt.constData();
+    int size = d->createdAt.size();
+
+    QVector<int> indexes(size);
+    int *out = indexes.data();
+    int count = 0;
+
+    for (int i = 0; i < size; ++i) {
+        out[count] = i;
+        count += (column[i] >= fromEpoch) & (column[i] <= toEpoch);
+    }
+
+    indexes.resize(count);
+    return indexes;
+}
+
+/**
+ *  Gets rows which have all given flags set
+ */
+QVector<int> QTweetStatusBatch::indexesWithFlags(quint8 flags) const
+{
+    const quint8 *column = d->flags.constData();
+    int size = d->flags.size();
+
+    QVector<int> indexes(size);
+    int *out = indexes.data();
+    int count = 0;
+
+    for (int i = 0; i < size; ++i) {
+        out[count] = i;
+        count += (column[i] & flags) == flags;
+    }
+
+    indexes.resize(count);
+    return indexes;
+}
+
+/**
+ *  Gets rows of the statuses posted by the user
+ */
+QVector<int> QTweetStatusBatch::indexesOfUser(qint64 userid) const
+{
+    const qint64 *column = d->userIds.constData();
+    int size = d->userIds.size();
+
+    QVector<int> indexes(size);
+    int *out = indexes.data();
+    int count = 0;
+
+    for (int i = 0; i < size; ++i) {
+        out[count] = i;
+        count += column[i] == userid;
+    }
+
+    indexes.resize(count);
+    return indexes;
+}
+
+QVector<int> QTweetStatusBatch::sortedIndexesById(Qt::SortOrder order) const
+{
+    return sortedIndexes(d->ids, order);
+}
+
+QVector<int> QTweetStatusBatch::sortedIndexesByCreatedAt(Qt::SortOrder order) const
+{
+    return sortedIndexes(d->createdAt, order);
+}
+
+/**
+ *  Creates batch from given rows, in the order of indexes.
+ *  String pool and user table are shared with this batch.
+ */
+QTweetStatusBatch QTweetStatusBatch::select(const QVector<int> &indexes) const
+{
+    QTweetStatusBatch batch;
+    QTweetStatusBatchData *data = batch.d.data();
+
+    data->ids = gather(d->ids, indexes);
+    data->createdAt = gather(d->createdAt, indexes);
+    data->userIds = gather(d->userIds, indexes);
+    data->inReplyToStatusIds = gather(d->inReplyToStatusIds, indexes);
+    data->inReplyToUserIds = gather(d->inReplyToUserIds, indexes);
+    data->retweetedStatusIds = gather(d->retweetedStatusIds, indexes);
+    data->flags = gather(d->flags, indexes);
+    data->userIndexes = gather(d->userIndexes, indexes);
+    data->texts = gather(d->texts, indexes);
+    data->sources = gather(d->sources, indexes);
+    data->inReplyToScreenNames = gather(d->inReplyToScreenNames, indexes);
+    data->strings = d->strings;
+    data->users = d->users;
+    data->userIndexById = d->userIndexById;
+
+    return batch;
+}
+
+/**
+ *  Sorts rows by status id, descending order is newest first
+ */
+void QTweetStatusBatch::sortById(Qt::SortOrder order)
+{
+    *this = select(sortedIndexesById(order));
+}
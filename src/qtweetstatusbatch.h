@@ -0,0 +1,100 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSTATUSBATCH_H
+#define QTWEETSTATUSBATCH_H
+
+#include <QVariant>
+#include <QVector>
+#include <QString>
+#include <QSharedDataPointer>
+#include "qtweetlib_global.h"
+
+class QTweetStatus;
+class QTweetUser;
+class QTweetStatusBatchData;
+
+/**
+ *  Column oriented container of statuses for bulk processing
+ *
+ *  Ids, dates, user ids, reply ids and flags are kept in contiguous arrays,
+ *  strings in one shared string pool and users in a table of unique users.
+ *  Entities and places are not kept, status() returns status without them.
+ *  Implicitly shared, selecting rows shares the string pool and user table.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetStatusBatch
+{
+public:
+    enum Flag {
+        Favorited = 0x1,
+        Retweet = 0x2,
+        Reply = 0x4
+    };
+
+    QTweetStatusBatch();
+    QTweetStatusBatch(const QTweetStatusBatch& other);
+    QTweetStatusBatch& operator=(const QTweetStatusBatch& other);
+    ~QTweetStatusBatch();
+    void swap(QTweetStatusBatch& other);
+
+    int size() const;
+    bool isEmpty() const;
+    void reserve(int size);
+    void clear();
+    void append(const QTweetStatus& status);
+    void append(const QList<QTweetStatus>& statuses);
+
+    const qint64 *ids() const;
+    const qint64 *createdAtEpochs() const;
+    const qint64 *userIds() const;
+    const qint64 *inReplyToStatusIds() const;
+    const qint64 *inReplyToUserIds() const;
+    const qint64 *retweetedStatusIds() const;
+    const quint8 *flags() const;
+
+    qint64 id(int i) const;
+    qint64 createdAtEpoch(int i) const;
+    qint64 userId(int i) const;
+    qint64 inReplyToStatusId(int i) const;
+    qint64 inReplyToUserId(int i) const;
+    qint64 retweetedStatusId(int i) const;
+    quint8 flags(int i) const;
+    QStringRef textRef(int i) const;
+    QStringRef sourceRef(int i) const;
+    QStringRef inReplyToScreenNameRef(int i) const;
+    QTweetUser user(int i) const;
+    QTweetStatus status(int i) const;
+    QList<QTweetStatus> toList() const;
+
+    QVector<int> indexesInIdRange(qint64 minId, qint64 maxId) const;
+    QVector<int> indexesInTimeRange(qint64 fromEpoch, qint64 toEpoch) const;
+    QVector<int> indexesWithFlags(quint8 flags) const;
+    QVector<int> indexesOfUser(qint64 userid) const;
+    QVector<int> sortedIndexesById(Qt::SortOrder order = Qt::DescendingOrder) const;
+    QVector<int> sortedIndexesByCreatedAt(Qt::SortOrder order = Qt::DescendingOrder) const;
+    QTweetStatusBatch select(const QVector<int>& indexes) const;
+    void sortById(Qt::SortOrder order = Qt::DescendingOrder);
+
+private:
+    friend class QTweetConvert;   // fills data in place
+
+    QSharedDataPointer<QTweetStatusBatchData> d;
+};
+
+Q_DECLARE_METATYPE(QTweetStatusBatch)
+
+#endif // QTWEETSTATUSBATCH_H
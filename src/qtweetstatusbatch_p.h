@@ -0,0 +1,66 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSTATUSBATCH_P_H
+#define QTWEETSTATUSBATCH_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by the converters
+//  to fill data in place and may change without notice.
+//
+
+#include <QSharedData>
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include "qtweetstatusbatch.h"
+#include "qtweetuser.h"
+
+// Range of the string pool
+struct QTweetBatchString
+{
+    int offset;
+    int length;
+};
+
+Q_DECLARE_TYPEINFO(QTweetBatchString, Q_PRIMITIVE_TYPE);
+
+class QTweetStatusBatchData : public QSharedData
+{
+public:
+    void reserve(int size);
+    QTweetBatchString appendString(const QString& string);
+    int userIndex(const QTweetUser& user);
+
+    QVector<qint64> ids;
+    QVector<qint64> createdAt;      // seconds since epoch
+    QVector<qint64> userIds;
+    QVector<qint64> inReplyToStatusIds;
+    QVector<qint64> inReplyToUserIds;
+    QVector<qint64> retweetedStatusIds;
+    QVector<quint8> flags;
+    QVector<int> userIndexes;       // rows of users
+    QVector<QTweetBatchString> texts;
+    QVector<QTweetBatchString> sources;
+    QVector<QTweetBatchString> inReplyToScreenNames;
+
+    QString strings;
+    QVector<QTweetUser> users;
+    QHash<qint64, int> userIndexById;
+};
+
+#endif // QTWEETSTATUSBATCH_P_H
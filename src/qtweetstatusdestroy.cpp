@@ -48,7 +48,7 @@ void QTweetStatusDestroy::destroy(qint64 id,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/statuses/destroy.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/destroy.json");
 
     QUrl urlQuery(url);
 
@@ -66,14 +66,13 @@ void QTweetStatusDestroy::destroy(qint64 id,
     QByteArray postBody = urlQuery.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemovePath);
     postBody.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, postBody);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, postBody);
 }
 
 void QTweetStatusDestroy::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit deletedStatus(status);
     }
@@ -44,7 +44,7 @@ void QTweetStatusRetweet::retweet(qint64 id,
                                   bool trimUser,
                                   bool includeEntities)
 {
-    QUrl url(QString("https://api.twitter.com/1.1/statuses/retweet/%1.json").arg(id));
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, QString("statuses/retweet/%1.json").arg(id));
 
     if (trimUser)
         url.addQueryItem("trim_user", "true");
@@ -60,8 +60,7 @@ void QTweetStatusRetweet::retweet(qint64 id,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, QByteArray());
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, QByteArray());
 }
 
 void QTweetStatusRetweet::retweet()
@@ -72,7 +71,7 @@ void QTweetStatusRetweet::retweet()
 void QTweetStatusRetweet::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit postedRetweet(status);
     }
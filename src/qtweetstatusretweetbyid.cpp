@@ -46,8 +46,8 @@ void QTweetStatusRetweetByID::fetch(qint64 tweetid, int count, int page)
         return;
     }
 
-    QString urlString = QString("https://api.twitter.com/1/statuses/%1/retweeted_by/ids.json").arg(tweetid);
-    QUrl url(urlString);
+    QString urlString = QString("statuses/%1/retweeted_by/ids.json").arg(tweetid);
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, urlString);
 
     if (count != 0)
         url.addQueryItem("count", QString::number(count));
@@ -60,8 +60,7 @@ void QTweetStatusRetweetByID::fetch(qint64 tweetid, int count, int page)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetStatusRetweetByID::get()
@@ -47,8 +47,8 @@ void QTweetStatusRetweetedBy::fetch(qint64 tweetid, int count, int page)
         return;
     }
 
-    QString urlString = QString("http://api.twitter.com/1/statuses/%1/retweeted_by.json").arg(tweetid);
-    QUrl url(urlString);
+    QString urlString = QString("statuses/%1/retweeted_by.json").arg(tweetid);
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, urlString);
 
     if (count != 0)
         url.addQueryItem("count", QString::number(count));
@@ -61,8 +61,7 @@ void QTweetStatusRetweetedBy::fetch(qint64 tweetid, int count, int page)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetStatusRetweetedBy::get()
@@ -73,7 +72,7 @@ void QTweetStatusRetweetedBy::get()
 void QTweetStatusRetweetedBy::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetUser> users = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array());
+        QList<QTweetUser> users = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedUsers(users);
     }
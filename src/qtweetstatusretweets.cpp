@@ -21,6 +21,7 @@
 #include "json/qjsonarray.h"
 #include "qtweetstatusretweets.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 
 QTweetStatusRetweets::QTweetStatusRetweets(QObject *parent) :
@@ -46,8 +47,8 @@ QTweetStatusRetweets::QTweetStatusRetweets(OAuthTwitter *oauthTwitter, QObject *
  */
 void QTweetStatusRetweets::fetch(qint64 id, int count, bool trimUser)
 {
-    QString urlString = QString("https://api.twitter.com/1.1/statuses/retweets/%1.json").arg(id);
-    QUrl url(urlString);
+    QString urlString = QString("statuses/retweets/%1.json").arg(id);
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, urlString);
 
     if (count != 0)
         url.addQueryItem("count", QString::number(count));
@@ -60,8 +61,7 @@ void QTweetStatusRetweets::fetch(qint64 id, int count, bool trimUser)
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetStatusRetweets::get()
@@ -72,7 +72,12 @@ void QTweetStatusRetweets::get()
 void QTweetStatusRetweets::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array());
+        if (isStatusBatchEnabled()) {
+            emit parsedStatusBatch(QTweetConvert::jsonArrayToStatusBatch(jsonDoc.array(), userPool(), convertOptions()));
+            return;
+        }
+
+        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedStatuses(statuses);
     }
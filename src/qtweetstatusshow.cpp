@@ -48,7 +48,7 @@ QTweetStatusShow::QTweetStatusShow(OAuthTwitter *oauthTwitter, QObject *parent)
  */
 void QTweetStatusShow::fetch(qint64 id, bool trimUser, bool includeMyRetweet, bool includeEntities)
 {
-    QUrl url("https://api.twitter.com/1.1/statuses/show.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/show.json");
 
     url.addQueryItem("id", QString::number(id));
 
@@ -68,8 +68,7 @@ void QTweetStatusShow::fetch(qint64 id, bool trimUser, bool includeMyRetweet, bo
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetStatusShow::get()
@@ -80,7 +79,7 @@ void QTweetStatusShow::get()
 void QTweetStatusShow::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedStatus(status);
     }
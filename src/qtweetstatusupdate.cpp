@@ -56,9 +56,9 @@ void QTweetStatusUpdate::post(const QString &status,
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/statuses/update.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/update.json");
 
-    QUrl urlQuery("https://api.twitter.com/1.1/statuses/update.json");
+    QUrl urlQuery = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/update.json");
 
     urlQuery.addEncodedQueryItem("status", QUrl::toPercentEncoding(status));
 
@@ -93,14 +93,13 @@ void QTweetStatusUpdate::post(const QString &status,
     //remove '?'
     statusPost.remove(0, 1);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, statusPost);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, statusPost);
 }
 
 void QTweetStatusUpdate::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit postedStatus(status);
     }
@@ -45,7 +45,7 @@ void QTweetStatusUpdateWithMedia::post()
         return;
     }
 
-    QUrl url("https://api.twitter.com/1.1/statuses/update_with_media.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/update_with_media.json");
 
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::POST);
 
@@ -109,17 +109,14 @@ void QTweetStatusUpdateWithMedia::post()
     QNetworkRequest req(url);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->post(req, multiPart);
-    multiPart->setParent(reply);
-
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startPost(req, multiPart);
 }
 
 
 void QTweetStatusUpdateWithMedia::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+        QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), userPool(), convertOptions());
 
         emit postedUpdate(status);
     }
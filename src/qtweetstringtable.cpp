@@ -0,0 +1,252 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QMutexLocker>
+#include "qtweetstringtable.h"
+
+Q_GLOBAL_STATIC(QTweetStringTable, globalStringTable)
+
+// lookups served by the thread cache are added to table statistics in batches
+static const int StatisticsFlushInterval = 256;
+
+// Strings one thread got from the table, valid while generation matches table generation
+struct QTweetStringTableCache
+{
+    int generation;
+    QSet<QString> strings;
+    int lookups;
+    int hits;
+    qint64 bytesSaved;
+};
+
+/**
+ *  Constructor
+ */
+QTweetStringTable::QTweetStringTable() :
+    m_fields(DefaultFields), m_generation(0), m_maxCount(10000), m_lookups(0), m_hits(0), m_bytesSaved(0)
+{
+}
+
+/**
+ *  Destructor
+ */
+QTweetStringTable::~QTweetStringTable()
+{
+}
+
+/**
+ *  Gets global table used by the converters
+ */
+QTweetStringTable* QTweetStringTable::instance()
+{
+    return globalStringTable();
+}
+
+/**
+ *  Sets which fields converters intern, 0 disables interning.
+ *  By default only low cardinality fields (DefaultFields). Location and profile
+ *  image url are mostly unique per user, they would fill the table without hits.
+ */
+void QTweetStringTable::setFields(Fields fields)
+{
+    m_fields.fetchAndStoreRelaxed(int(fields));
+}
+
+QTweetStringTable::Fields QTweetStringTable::fields() const
+{
+    return Fields(QFlag(const_cast<QAtomicInt&>(m_fields).fetchAndAddRelaxed(0)));
+}
+
+/**
+ *  Sets maximum number of strings in the table, 10000 by default.
+ *  When table is full new values are returned as they are.
+ */
+void QTweetStringTable::setMaxCount(int count)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxCount = count;
+}
+
+int QTweetStringTable::maxCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxCount;
+}
+
+/**
+ *  Gets interned string equal to string, string is added if it isn't in the table
+ */
+QString QTweetStringTable::intern(const QString &string)
+{
+    if (string.isEmpty())
+        return string;
+
+    QTweetStringTableCache *cache = localCache();
+
+    ++cache->lookups;
+
+    QSet<QString>::const_iterator it = cache->strings.constFind(string);
+
+    if (it != cache->strings.constEnd()) {
+        if (!isSameString(*it, string)) {
+            ++cache->hits;
+            cache->bytesSaved += string.size() * sizeof(QChar);
+        }
+
+        QString interned = *it;
+
+        if (cache->lookups >= StatisticsFlushInterval) {
+            QMutexLocker locker(&m_mutex);
+            flushStatistics(cache);
+        }
+
+        return interned;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    flushStatistics(cache);
+
+    QSet<QString>::const_iterator tableIt = m_strings.constFind(string);
+
+    if (tableIt != m_strings.constEnd()) {
+        if (!isSameString(*tableIt, string)) {
+            ++m_hits;
+            m_bytesSaved += string.size() * sizeof(QChar);
+        }
+
+        cache->strings.insert(*tableIt);
+
+        return *tableIt;
+    }
+
+    if (m_strings.size() < m_maxCount) {
+        m_strings.insert(string);
+        cache->strings.insert(string);
+    }
+
+    return string;
+}
+
+/**
+ *  Interns string if field is one of the interned fields
+ */
+QString QTweetStringTable::intern(Field field, const QString &string)
+{
+    if (!fields().testFlag(field))
+        return string;
+
+    return intern(string);
+}
+
+/**
+ *  Removes all strings and resets statistics, strings already handed out stay valid.
+ *  Thread caches are dropped on their next lookup.
+ */
+void QTweetStringTable::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_strings.clear();
+    m_generation.fetchAndAddRelaxed(1);
+    m_lookups = 0;
+    m_hits = 0;
+    m_bytesSaved = 0;
+}
+
+/**
+ *  Gets number of strings in the table
+ */
+int QTweetStringTable::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_strings.size();
+}
+
+/**
+ *  Gets number of intern() calls with non empty string
+ *  @remarks Lookups served by thread caches are added in batches, so statistics lag a bit
+ */
+qint64 QTweetStringTable::lookups() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lookups;
+}
+
+/**
+ *  Gets number of lookups which returned already interned string instead of new copy
+ */
+qint64 QTweetStringTable::hits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+/**
+ *  Gets size in bytes of character data of the copies released thanks to hits
+ */
+qint64 QTweetStringTable::bytesSaved() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bytesSaved;
+}
+
+// Gets cache of the calling thread, emptied if the table was cleared meanwhile
+QTweetStringTableCache *QTweetStringTable::localCache()
+{
+    int generation = m_generation.fetchAndAddRelaxed(0);
+    QTweetStringTableCache *cache = m_caches.localData();
+
+    if (!cache) {
+        cache = new QTweetStringTableCache;
+        cache->generation = generation;
+        cache->lookups = 0;
+        cache->hits = 0;
+        cache->bytesSaved = 0;
+        m_caches.setLocalData(cache);
+    } else if (cache->generation != generation) {
+        cache->strings.clear();
+        cache->generation = generation;
+        cache->lookups = 0;
+        cache->hits = 0;
+        cache->bytesSaved = 0;
+    }
+
+    return cache;
+}
+
+// Adds statistics of the cache to the table, mutex must be locked
+void QTweetStringTable::flushStatistics(QTweetStringTableCache *cache)
+{
+    if (cache->generation == m_generation.fetchAndAddRelaxed(0)) {
+        m_lookups += cache->lookups;
+        m_hits += cache->hits;
+        m_bytesSaved += cache->bytesSaved;
+    }
+
+    cache->lookups = 0;
+    cache->hits = 0;
+    cache->bytesSaved = 0;
+}
+
+/**
+ *  Checks if strings share data, true for equal interned strings.
+ *  Cheaper than comparing characters.
+ */
+bool QTweetStringTable::isSameString(const QString &left, const QString &right)
+{
+    return left.constData() == right.constData() && left.size() == right.size();
+}
@@ -0,0 +1,95 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETSTRINGTABLE_H
+#define QTWEETSTRINGTABLE_H
+
+#include <QSet>
+#include <QString>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QThreadStorage>
+#include "qtweetlib_global.h"
+
+struct QTweetStringTableCache;
+
+/**
+ *  Table of interned strings shared by all converters
+ *
+ *  Values of selected low cardinality fields (source, lang, time zone...)
+ *  are looked up in the table, so every occurrence of the same value shares
+ *  one QString. Interned strings can be compared with isSameString().
+ *  Thread safe. Every thread keeps a cache of strings it got from the table,
+ *  so repeated values don't take the table lock.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetStringTable
+{
+public:
+    enum Field {
+        Source = 0x1,
+        Lang = 0x2,
+        TimeZone = 0x4,
+        Location = 0x8,
+        Country = 0x10,
+        CountryCode = 0x20,
+        ProfileImageUrl = 0x40,
+        DefaultFields = Source | Lang | TimeZone | Country | CountryCode,
+        AllFields = 0x7f
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    QTweetStringTable();
+    ~QTweetStringTable();
+
+    static QTweetStringTable* instance();
+
+    void setFields(Fields fields);
+    Fields fields() const;
+    void setMaxCount(int count);
+    int maxCount() const;
+
+    QString intern(const QString& string);
+    QString intern(Field field, const QString& string);
+    void clear();
+
+    int count() const;
+    qint64 lookups() const;
+    qint64 hits() const;
+    qint64 bytesSaved() const;
+
+    static bool isSameString(const QString& left, const QString& right);
+
+private:
+    Q_DISABLE_COPY(QTweetStringTable)
+
+    QTweetStringTableCache *localCache();
+    void flushStatistics(QTweetStringTableCache *cache);
+
+    mutable QMutex m_mutex;
+    QSet<QString> m_strings;
+    QThreadStorage<QTweetStringTableCache *> m_caches;
+    QAtomicInt m_fields;
+    QAtomicInt m_generation;
+    int m_maxCount;
+    qint64 m_lookups;
+    qint64 m_hits;
+    qint64 m_bytesSaved;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(QTweetStringTable::Fields)
+
+#endif // QTWEETSTRINGTABLE_H
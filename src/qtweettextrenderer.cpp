@@ -0,0 +1,241 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QVarLengthArray>
+#include <QtAlgorithms>
+#include <QUrl>
+#include "qtweettextrenderer.h"
+#include "qtweetstatus.h"
+
+namespace {
+
+class EntityLessThan
+{
+public:
+    EntityLessThan(const QTweetStatus& status) : m_status(status) {}
+
+    bool operator()(int left, int right) const
+    {
+        return m_status.entityLowerIndex(left) < m_status.entityLowerIndex(right);
+    }
+
+private:
+    const QTweetStatus& m_status;
+};
+
+// Walks the text by code points, twitter indices count code points
+class TextCursor
+{
+public:
+    TextCursor(const QString& text) : m_text(text), m_pos(0), m_codePoint(0) {}
+
+    bool atEnd() const { return m_pos >= m_text.size(); }
+    int pos() const { return m_pos; }
+    int codePoint() const { return m_codePoint; }
+
+    int next()
+    {
+        int begin = m_pos;
+
+        if (m_text.at(m_pos).isHighSurrogate() && m_pos + 1 < m_text.size() && m_text.at(m_pos + 1).isLowSurrogate())
+            m_pos += 2;
+        else
+            m_pos += 1;
+
+        ++m_codePoint;
+
+        return begin;
+    }
+
+private:
+    const QString& m_text;
+    int m_pos;
+    int m_codePoint;
+};
+
+} // namespace
+
+// Checks if & at pos starts a character reference (&amp; &#39; &#x27;),
+// twitter sends text with <, > and & already escaped
+static bool isCharacterReference(const QChar *data, int pos, int size)
+{
+    // longest named reference we keep is &thetasym;
+    int end = qMin(size, pos + 10);
+    int i = pos + 1;
+
+    if (i < end && data[i] == QLatin1Char('#'))
+        ++i;
+
+    int begin = i;
+
+    while (i < end && data[i].unicode() < 128 && data[i].isLetterOrNumber())
+        ++i;
+
+    return i > begin && i < end && data[i] == QLatin1Char(';');
+}
+
+static void appendEscaped(QString& html, const QChar *data, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        switch (data[i].unicode()) {
+        case '<':
+            html += QLatin1String("&lt;");
+            break;
+        case '>':
+            html += QLatin1String("&gt;");
+            break;
+        case '&':
+            if (isCharacterReference(data, i, size))
+                html += data[i];
+            else
+                html += QLatin1String("&amp;");
+            break;
+        case '"':
+            html += QLatin1String("&quot;");
+            break;
+        case '\n':
+            html += QLatin1String("<br/>");
+            break;
+        default:
+            html += data[i];
+        }
+    }
+}
+
+static void appendEscaped(QString& html, const QStringRef& string)
+{
+    appendEscaped(html, string.unicode(), string.size());
+}
+
+static void appendLink(QString& html, const QString& prefix, const QStringRef& target, const QStringRef& label)
+{
+    html += QLatin1String("<a href=\"");
+    html += prefix;
+    appendEscaped(html, target);
+    html += QLatin1String("\">");
+    appendEscaped(html, label);
+    html += QLatin1String("</a>");
+}
+
+static void appendEntity(QString& html, const QTweetStatus& status, int i, const QStringRef& original,
+                         QTweetTextRenderer::Options options)
+{
+    switch (status.entityType(i)) {
+    case QTweetStatus::UrlEntity:
+    case QTweetStatus::MediaEntity:
+        if (options & QTweetTextRenderer::LinkUrls) {
+            QStringRef target = status.entityExpandedUrlRef(i);
+            QStringRef label = status.entityDisplayUrlRef(i);
+
+            if (target.isEmpty())
+                target = status.entityTextRef(i);
+
+            if (!(options & QTweetTextRenderer::ExpandUrls) || label.isEmpty())
+                label = original;
+
+            appendLink(html, QString(), target, label);
+            return;
+        }
+        break;
+    case QTweetStatus::HashtagEntity:
+        if (options & QTweetTextRenderer::LinkHashtags) {
+            QString tag = QString::fromLatin1(QUrl::toPercentEncoding(status.entityTextRef(i).toString()));
+
+            appendLink(html, QLatin1String("https://twitter.com/search?q=%23"), QStringRef(&tag), original);
+            return;
+        }
+        break;
+    case QTweetStatus::UserMentionsEntity:
+        if (options & QTweetTextRenderer::LinkMentions) {
+            appendLink(html, QLatin1String("https://twitter.com/"), status.entityTextRef(i), original);
+            return;
+        }
+        break;
+    }
+
+    appendEscaped(html, original);
+}
+
+/**
+ *  Renders text of the status with entities as links
+ *  @param options what is linked, everything by default
+ *  @remarks Overlapping entities and entities out of the text are rendered as plain text
+ */
+QString QTweetTextRenderer::toHtml(const QTweetStatus &status, Options options)
+{
+    const QString text = status.text();
+    int count = status.entityCount();
+
+    QVarLengthArray<int, 16> order(count);
+
+    for (int i = 0; i < count; ++i)
+        order[i] = i;
+
+    qSort(order.data(), order.data() + count, EntityLessThan(status));
+
+    QString html;
+    html.reserve(text.size() + count * 64);
+
+    TextCursor cursor(text);
+    int plainBegin = 0;
+
+    for (int i = 0; i < count; ++i) {
+        int lowerIndex = status.entityLowerIndex(order[i]);
+        int higherIndex = status.entityHigherIndex(order[i]);
+
+        if (lowerIndex < cursor.codePoint() || higherIndex <= lowerIndex)
+            continue;
+
+        while (cursor.codePoint() < lowerIndex && !cursor.atEnd())
+            cursor.next();
+
+        int entityBegin = cursor.pos();
+
+        while (cursor.codePoint() < higherIndex && !cursor.atEnd())
+            cursor.next();
+
+        // entity is out of the text, rest is plain text
+        if (cursor.codePoint() < higherIndex)
+            break;
+
+        appendEscaped(html, text.constData() + plainBegin, entityBegin - plainBegin);
+        appendEntity(html, status, order[i], text.midRef(entityBegin, cursor.pos() - entityBegin), options);
+
+        plainBegin = cursor.pos();
+    }
+
+    appendEscaped(html, text.constData() + plainBegin, text.size() - plainBegin);
+
+    return html;
+}
+
+/**
+ *  Renders status and caches result on it, see QTweetStatus::richText()
+ */
+void QTweetTextRenderer::render(QTweetStatus *status, Options options)
+{
+    status->setRichText(toHtml(*status, options));
+}
+
+/**
+ *  Renders statuses and caches results on them
+ */
+void QTweetTextRenderer::render(QList<QTweetStatus> &statuses, Options options)
+{
+    for (int i = 0; i < statuses.size(); ++i)
+        render(&statuses[i], options);
+}
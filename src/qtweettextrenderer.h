@@ -0,0 +1,56 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETTEXTRENDERER_H
+#define QTWEETTEXTRENDERER_H
+
+#include <QString>
+#include <QList>
+#include "qtweetlib_global.h"
+
+class QTweetStatus;
+
+/**
+ *  Renders status text with its entities as rich text (HTML)
+ *
+ *  Urls, hashtags and user mentions become links, rest of the text is escaped.
+ *  Character references in the text (twitter escapes &lt; &gt; &amp;) are kept as they are.
+ *  Rendering is one pass over the text with entities sorted by index,
+ *  result can be cached on the status with render(). Reentrant, can run on
+ *  worker threads.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetTextRenderer
+{
+public:
+    enum Option {
+        NoOptions = 0,
+        LinkUrls = 0x1,
+        ExpandUrls = 0x2,       // shows display url instead of t.co url
+        LinkHashtags = 0x4,
+        LinkMentions = 0x8,
+        DefaultOptions = LinkUrls | ExpandUrls | LinkHashtags | LinkMentions
+    };
+    Q_DECLARE_FLAGS(Options, Option)
+
+    static QString toHtml(const QTweetStatus& status, Options options = DefaultOptions);
+    static void render(QTweetStatus *status, Options options = DefaultOptions);
+    static void render(QList<QTweetStatus>& statuses, Options options = DefaultOptions);
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(QTweetTextRenderer::Options)
+
+#endif // QTWEETTEXTRENDERER_H
@@ -15,60 +15,10 @@
  * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
  */
 
-#include <QSharedData>
 #include <QDateTime>
-#include "qtweetuser.h"
+#include "qtweetuser_p.h"
 #include "qtweetstatus.h"
-
-class QTweetUserData : public QSharedData
-{
-public:
-    QTweetUserData() : id(0) {}
-
-    bool contributorsEnabled;
-    QDateTime createdAt;
-    QString description;
-    int favoritesCount;
-    bool followRequestSent;
-    int followersCount;
-    int friendsCount;
-    bool geoEnabled;
-    qint64 id;
-    QString lang;
-    int listedCount;
-    QString location;
-    QString name;
-    //QString profileBackgroundColor;
-    //QString profileBackgroundImageUrl;
-    //bool profileBackgroundTile;
-    QString profileImageUrl;
-    //QString profileLinkColor;
-    //QString profileSidebarBorderColor;
-    //QString profileSidebarFillColor;
-    //QString profileTextColor;
-    //bool profileUseBackgroundImage;
-    bool accountProtected;
-    QString screenName;
-    //bool showAllInlineMedia;
-    int statusesCount;
-    QString timeZone;
-    QString url;
-    int utcOffset;
-    bool verified;
-    //avoid recursion with QTweetStatus
-    qint64 statusId;
-    QString statusText;
-    QDateTime statusCreatedAt;
-    qint64 statusInReplyToUserId;
-    QString statusInReplyToScreenName;
-    qint64 statusInReplyToStatusId;
-    bool statusFavorited;
-    QString statusSource;
-    //QTweetUser user
-    //QTweetStatus retweetedStatus; //check if there is retweeted status in user response
-    //bool containsRetweetStatus;
-    //QTweetStatus status;    //should be pointer?
-};
+#include "qtweetconvert.h"
 
 QTweetUser::QTweetUser() :
         d(new QTweetUserData)
@@ -78,12 +28,15 @@ QTweetUser::QTweetUser() :
 QTweetUser::QTweetUser(const QTweetUser &other) :
         d(other.d)
 {
+    QTWEET_COUNT_REF();
 }
 
 QTweetUser& QTweetUser::operator =(const QTweetUser& other)
 {
-    if (this != &other)
+    if (this != &other) {
+        QTWEET_COUNT_REF();
         d.operator =(other.d);
+    }
     return *this;
 }
 
@@ -91,6 +44,51 @@ QTweetUser::~QTweetUser()
 {
 }
 
+void QTweetUser::swap(QTweetUser &other)
+{
+    d.swap(other.d);
+}
+
+void QTweetUser::moveLang(QString &lang)
+{
+    d->lang.swap(lang);
+}
+
+void QTweetUser::moveName(QString &name)
+{
+    d->name.swap(name);
+}
+
+void QTweetUser::moveScreenName(QString &screenName)
+{
+    d->screenName.swap(screenName);
+}
+
+void QTweetUser::moveLocation(QString &location)
+{
+    d->location.swap(location);
+}
+
+void QTweetUser::moveDescription(QString &desc)
+{
+    d->description.swap(desc);
+}
+
+void QTweetUser::moveProfileImageUrl(QString &url)
+{
+    d->profileImageUrl.swap(url);
+}
+
+void QTweetUser::moveUrl(QString &url)
+{
+    d->url.swap(url);
+}
+
+void QTweetUser::moveTimezone(QString &timezone)
+{
+    d->timeZone.swap(timezone);
+}
+
 void QTweetUser::setContributorsEnabled(bool enabled)
 {
     d->contributorsEnabled = enabled;
@@ -235,15 +233,32 @@ int QTweetUser::friendsCount() const
 
 void QTweetUser::setCreatedAt(const QString &twitterDate)
 {
-    d->createdAt = twitterDateToQDateTime(twitterDate);
+    d->createdAt = QTweetConvert::twitterDateToEpoch(twitterDate);
 }
 
 void QTweetUser::setCreatedAt(const QDateTime &datetime)
 {
-    d->createdAt = datetime;
+    d->createdAt = QTweetConvert::dateTimeToEpoch(datetime);
 }
 
 QDateTime QTweetUser::createdAt() const
+{
+    return QTweetConvert::epochToDateTime(d->createdAt);
+}
+
+/**
+ *  Sets creation time in seconds since epoch (UTC)
+ */
+void QTweetUser::setCreatedAtEpoch(qint64 secs)
+{
+    d->createdAt = secs;
+}
+
+/**
+ *  Gets creation time in seconds since epoch (UTC)
+ *  @return QTweetConvert::InvalidEpoch if it's not set
+ */
+qint64 QTweetUser::createdAtEpoch() const
 {
     return d->createdAt;
 }
@@ -313,7 +328,7 @@ void QTweetUser::setStatus(const QTweetStatus &lastStatus)
     //d->status = lastStatus;
     d->statusId = lastStatus.id();
     d->statusText = lastStatus.text();
-    d->statusCreatedAt = lastStatus.createdAt();
+    d->statusCreatedAt = lastStatus.createdAtEpoch();
     d->statusInReplyToScreenName = lastStatus.inReplyToScreenName();
     d->statusInReplyToStatusId = lastStatus.inReplyToStatusId();
     d->statusInReplyToUserId = lastStatus.inReplyToUserId();
@@ -326,7 +341,7 @@ QTweetStatus QTweetUser::status() const
     QTweetStatus lastStatus;
     lastStatus.setId(d->statusId);
     lastStatus.setText(d->statusText);
-    //lastStatus.setCreatedAt();    // ### TODO FIX IT!
+    lastStatus.setCreatedAtEpoch(d->statusCreatedAt);
     lastStatus.setInReplyToScreenName(d->statusInReplyToScreenName);
     lastStatus.setInReplyToStatusId(d->statusInReplyToStatusId);
     lastStatus.setInReplyToUserId(d->statusInReplyToUserId);
@@ -336,17 +351,17 @@ QTweetStatus QTweetUser::status() const
     return lastStatus;
 }
 
+/**
+ *  Checks if both users share same data
+ *  @remarks Users converted with same QTweetUserPool are shared
+ */
+bool QTweetUser::isSharedWith(const QTweetUser &other) const
+{
+    return d.constData() == other.d.constData();
+}
+
 QDateTime QTweetUser::twitterDateToQDateTime(const QString &twitterDate)
 {
     //Twitter Date Format: 'Wed Sep 01 11:27:25 +0000 2010'  UTC
-    QString dateString = twitterDate.left(11) + twitterDate.right(4);
-    QString timeString = twitterDate.mid(11, 8);
-
-    QDate date = QDate::fromString(dateString);
-    QTime time = QTime::fromString(timeString);
-
-    if (date.isValid() && time.isValid())
-        return QDateTime(date, time, Qt::UTC);
-    else
-        return QDateTime();
+    return QTweetConvert::epochToDateTime(QTweetConvert::twitterDateToEpoch(twitterDate));
 }
@@ -22,6 +22,7 @@
 #include <QSharedDataPointer>
 #include "qtweetlib_global.h"
 
+class QDataStream;
 class QTweetStatus;
 class QTweetUserData;
 
@@ -35,6 +36,7 @@ public:
     QTweetUser(const QTweetUser& other);
     QTweetUser& operator=(const QTweetUser& other);
     ~QTweetUser();
+    void swap(QTweetUser& other);
 
     void setContributorsEnabled(bool enabled);
     bool isContributorsEnabled() const;
@@ -65,6 +67,8 @@ public:
     void setCreatedAt(const QString& twitterDate);
     void setCreatedAt(const QDateTime& datetime);
     QDateTime createdAt() const;
+    void setCreatedAtEpoch(qint64 secs);
+    qint64 createdAtEpoch() const;
     void setFavouritesCount(int count);
     int favouritesCount() const;
     void setUtcOffset(int sec);
@@ -79,13 +83,42 @@ public:
     int statusesCount() const;
     void setStatus(const QTweetStatus& lastStatus);
     QTweetStatus status() const;
+    bool isSharedWith(const QTweetUser& other) const;
 
     static QDateTime twitterDateToQDateTime(const QString& twitterDate);
 
+#ifdef Q_COMPILER_RVALUE_REFS
+    // inline, so the library ABI doesn't depend on compiler flags of the application
+    QTweetUser &operator=(QTweetUser &&other) { swap(other); return *this; }
+    void setLang(QString&& lang) { moveLang(lang); }
+    void setName(QString&& name) { moveName(name); }
+    void setScreenName(QString&& screenName) { moveScreenName(screenName); }
+    void setLocation(QString&& location) { moveLocation(location); }
+    void setDescription(QString&& desc) { moveDescription(desc); }
+    void setprofileImageUrl(QString&& url) { moveProfileImageUrl(url); }
+    void setUrl(QString&& url) { moveUrl(url); }
+    void setTimezone(QString&& timezone) { moveTimezone(timezone); }
+#endif
+
 private:
+    // used by the inline rvalue setters, argument gets the old value
+    void moveLang(QString& lang);
+    void moveName(QString& name);
+    void moveScreenName(QString& screenName);
+    void moveLocation(QString& location);
+    void moveDescription(QString& desc);
+    void moveProfileImageUrl(QString& url);
+    void moveUrl(QString& url);
+    void moveTimezone(QString& timezone);
+
+    friend class QTweetConvert;   // fills data in place
+
     QSharedDataPointer<QTweetUserData> d;
 };
 
+QTWEETLIBSHARED_EXPORT QDataStream& operator<<(QDataStream& stream, const QTweetUser& user);
+QTWEETLIBSHARED_EXPORT QDataStream& operator>>(QDataStream& stream, QTweetUser& user);
+
 Q_DECLARE_METATYPE(QTweetUser)
 
 #endif // QTWEETUSER_H
@@ -0,0 +1,108 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETUSER_P_H
+#define QTWEETUSER_P_H
+
+//
+//  This file is not part of the QTweetLib API. It's used by the converters
+//  to fill data in place and may change without notice.
+//
+
+#include <QSharedData>
+#include <QString>
+#include "qtweetconvert.h"
+#include "qtweetdatastatistics_p.h"
+
+class QTweetUserData : public QSharedData
+{
+public:
+    QTweetUserData() :
+        contributorsEnabled(false),
+        followRequestSent(false),
+        geoEnabled(false),
+        accountProtected(false),
+        verified(false),
+        statusFavorited(false),
+        favoritesCount(0),
+        followersCount(0),
+        friendsCount(0),
+        listedCount(0),
+        statusesCount(0),
+        utcOffset(0),
+        id(0),
+        createdAt(QTweetConvert::InvalidEpoch),
+        statusId(0),
+        statusCreatedAt(QTweetConvert::InvalidEpoch),
+        statusInReplyToUserId(0),
+        statusInReplyToStatusId(0)
+    {
+    }
+
+    // flags fill padding after QSharedData ref count
+    uint contributorsEnabled : 1;
+    uint followRequestSent : 1;
+    uint geoEnabled : 1;
+    uint accountProtected : 1;
+    uint verified : 1;
+    uint statusFavorited : 1;
+    //bool profileBackgroundTile;
+    //bool profileUseBackgroundImage;
+    //bool showAllInlineMedia;
+
+    int favoritesCount;
+    int followersCount;
+    int friendsCount;
+    int listedCount;
+    int statusesCount;
+    int utcOffset;
+
+    qint64 id;
+    qint64 createdAt;   // seconds since epoch
+    //avoid recursion with QTweetStatus
+    qint64 statusId;
+    qint64 statusCreatedAt;
+    qint64 statusInReplyToUserId;
+    qint64 statusInReplyToStatusId;
+
+    QString description;
+    QString lang;
+    QString location;
+    QString name;
+    QString profileImageUrl;
+    //QString profileBackgroundColor;
+    //QString profileBackgroundImageUrl;
+    //QString profileLinkColor;
+    //QString profileSidebarBorderColor;
+    //QString profileSidebarFillColor;
+    //QString profileTextColor;
+    QString screenName;
+    QString timeZone;
+    QString url;
+    QString statusText;
+    QString statusInReplyToScreenName;
+    QString statusSource;
+    //QTweetUser user
+    //QTweetStatus retweetedStatus; //check if there is retweeted status in user response
+    //bool containsRetweetStatus;
+    //QTweetStatus status;    //should be pointer?
+#ifdef QTWEETLIB_DATA_STATISTICS
+    QTweetDataCounter counter;
+#endif
+};
+
+#endif // QTWEETUSER_P_H
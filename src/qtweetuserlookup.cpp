@@ -18,19 +18,33 @@
 #include <QtDebug>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QTimerEvent>
 #include "qtweetuserlookup.h"
 #include "qtweetuser.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonarray.h"
 
+// id of fetchAll() chunk in its request
+static const QNetworkRequest::Attribute ChunkAttribute = QNetworkRequest::User;
+
+// rate limited chunk is sent again this many times before it fails
+static const int MaxRateLimitRetries = 5;
+
+// pause after rate limited chunk when server doesn't say how long to wait
+static const int DefaultRateLimitWait = 60000;
+
 QTweetUserLookup::QTweetUserLookup(QObject *parent) :
-    QTweetNetBase(parent)
+    QTweetNetBase(parent),
+    m_maxConcurrentRequests(4), m_concurrentRequests(4), m_resumeTimer(0), m_batchSize(ChunkSize),
+    m_doneChunks(0), m_totalChunks(0), m_userCount(0), m_nextChunkId(0)
 {
 }
 
 QTweetUserLookup::QTweetUserLookup(OAuthTwitter *oauthTwitter, QObject *parent) :
-        QTweetNetBase(oauthTwitter, parent)
+        QTweetNetBase(oauthTwitter, parent),
+        m_maxConcurrentRequests(4), m_concurrentRequests(4), m_resumeTimer(0), m_batchSize(ChunkSize),
+        m_doneChunks(0), m_totalChunks(0), m_userCount(0), m_nextChunkId(0)
 {
 }
 
@@ -38,6 +52,7 @@ QTweetUserLookup::QTweetUserLookup(OAuthTwitter *oauthTwitter, QObject *parent)
  *   Starts fetching
  *   @param useridList list of user IDs
  *   @param screenNameList list of screen names
+ *   @remarks Up to 100 users, use fetchAll() for more
  */
 void QTweetUserLookup::fetch(const QList<qint64> &useridList,
                              const QStringList &screenNameList)
@@ -47,7 +62,348 @@ void QTweetUserLookup::fetch(const QList<qint64> &useridList,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/users/lookup.json");
+    startGet(lookupRequest(useridList, screenNameList));
+}
+
+/**
+ *   Starts fetching any number of users
+ *   @param useridList list of user IDs, duplicates are fetched once
+ *   @param screenNameList list of screen names, duplicates (case insensitive) are fetched once
+ *   @remarks Users are fetched in chunks of 100, up to maxConcurrentRequests() at once,
+ *            and emitted with parsedUserInfoList in batches. User is emitted once even when
+ *            requested both by id and screen name. Failed chunks don't stop the others.
+ *            Rate limited chunk is sent again after the server's reset time, with fewer
+ *            chunks at once. Ends with fetchAllFinished.
+ */
+void QTweetUserLookup::fetchAll(const QList<qint64> &useridList,
+                                const QStringList &screenNameList)
+{
+    if (!isAuthenticationEnabled()) {
+        qCritical("Needs authentication to be enabled");
+        return;
+    }
+
+    if (isFetchingAll()) {
+        qWarning("QTweetUserLookup: fetchAll() is already running");
+        return;
+    }
+
+    m_users.clear();
+    m_emittedUserIds.clear();
+    m_failedUserIds.clear();
+    m_failedScreenNames.clear();
+    m_doneChunks = 0;
+    m_userCount = 0;
+    m_concurrentRequests = m_maxConcurrentRequests;
+
+    QSet<qint64> useridSet;
+    Chunk chunk;
+
+    foreach (qint64 id, useridList) {
+        if (useridSet.contains(id))
+            continue;
+
+        useridSet.insert(id);
+        chunk.userids.append(id);
+
+        if (chunk.userids.size() == ChunkSize) {
+            m_pendingChunks.enqueue(chunk);
+            chunk.userids.clear();
+        }
+    }
+
+    QSet<QString> screenNameSet;
+
+    foreach (const QString& screenName, screenNameList) {
+        QString key = screenName.toLower();
+
+        if (screenNameSet.contains(key))
+            continue;
+
+        screenNameSet.insert(key);
+        chunk.screenNames.append(screenName);
+
+        if (chunk.userids.size() + chunk.screenNames.size() == ChunkSize) {
+            m_pendingChunks.enqueue(chunk);
+            chunk.userids.clear();
+            chunk.screenNames.clear();
+        }
+    }
+
+    if (!chunk.userids.isEmpty() || !chunk.screenNames.isEmpty())
+        m_pendingChunks.enqueue(chunk);
+
+    m_totalChunks = m_pendingChunks.size();
+
+    if (!m_totalChunks) {
+        emit fetchAllFinished(0, 0);
+        return;
+    }
+
+    startChunks();
+}
+
+/**
+ *   Stops fetchAll(), running requests are aborted and not reported as failed
+ */
+void QTweetUserLookup::abortAll()
+{
+    m_pendingChunks.clear();
+
+    m_runningChunks.clear();
+
+    if (m_resumeTimer) {
+        killTimer(m_resumeTimer);
+        m_resumeTimer = 0;
+    }
+
+    // chunks still waiting in request scheduler or for retry are aborted when they're sent,
+    // aborted replies finish their requests and reply() drops them
+    QHash<int, QPointer<QNetworkReply> > chunkReplies = m_chunkReplies;
+    m_chunkReplies.clear();
+
+    foreach (QNetworkReply *reply, chunkReplies) {
+        if (reply)
+            reply->abort();
+    }
+
+    m_users.clear();
+}
+
+/**
+ *   Checks if fetchAll() is running
+ */
+bool QTweetUserLookup::isFetchingAll() const
+{
+    return !m_pendingChunks.isEmpty() || !m_runningChunks.isEmpty();
+}
+
+/**
+ *   Sets maximum number of chunk requests running at once, 4 by default
+ *   @remarks Fewer run at once after chunk is rate limited, one more after every chunk
+ *            which isn't, up to this maximum
+ */
+void QTweetUserLookup::setMaxConcurrentRequests(int count)
+{
+    m_maxConcurrentRequests = qMax(1, count);
+    m_concurrentRequests = qMin(m_concurrentRequests, m_maxConcurrentRequests);
+}
+
+int QTweetUserLookup::maxConcurrentRequests() const
+{
+    return m_maxConcurrentRequests;
+}
+
+/**
+ *   Sets number of users in batches emitted by fetchAll(), 100 by default
+ */
+void QTweetUserLookup::setBatchSize(int size)
+{
+    m_batchSize = qMax(1, size);
+}
+
+int QTweetUserLookup::batchSize() const
+{
+    return m_batchSize;
+}
+
+/**
+ *   Gets user ids of failed chunks of the last fetchAll()
+ */
+QList<qint64> QTweetUserLookup::failedUserIds() const
+{
+    return m_failedUserIds;
+}
+
+/**
+ *   Gets screen names of failed chunks of the last fetchAll()
+ */
+QStringList QTweetUserLookup::failedScreenNames() const
+{
+    return m_failedScreenNames;
+}
+
+void QTweetUserLookup::parseJsonFinished(const QJsonDocument &jsonDoc)
+{
+    QList<QTweetUser> userInfoList;
+
+    if (jsonDoc.isArray())
+        userInfoList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array(), userPool(), convertOptions());
+
+    QVariant chunkId = parsedRequest().attribute(ChunkAttribute);
+
+    if (chunkId.isValid()) {
+        chunkParsed(chunkId.toInt(), userInfoList);
+        return;
+    }
+
+    if (jsonDoc.isArray())
+        emit parsedUserInfoList(userInfoList);
+}
+
+/**
+ *   Handles replies of fetchAll() chunks, others are handled by QTweetNetBase
+ */
+void QTweetUserLookup::reply()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    QVariant chunkId = reply ? reply->request().attribute(ChunkAttribute) : QVariant();
+
+    if (!chunkId.isValid()) {
+        QTweetNetBase::reply();
+        return;
+    }
+
+    // aborted by abortAll()
+    if (!m_runningChunks.contains(chunkId.toInt())) {
+        reply->deleteLater();
+        return;
+    }
+
+    m_chunkReplies.remove(chunkId.toInt());
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (httpStatus == EnhanceYourCalm || httpStatus == 429) {
+        Chunk chunk = m_runningChunks.take(chunkId.toInt());
+
+        // fewer chunks at once, none until rate limit resets
+        m_concurrentRequests = qMax(1, m_concurrentRequests / 2);
+
+        int wait = rateLimitWait(reply);
+        pauseChunks(wait >= 0 ? wait : DefaultRateLimitWait);
+
+        reply->deleteLater();
+
+        if (++chunk.rateLimitRetries <= MaxRateLimitRetries) {
+            m_pendingChunks.prepend(chunk);
+            return;
+        }
+
+        setLastErrorMessage("User lookup chunk failed: rate limited");
+
+        m_failedUserIds += chunk.userids;
+        m_failedScreenNames += chunk.screenNames;
+
+        finishChunk();
+        return;
+    }
+
+    if (reply->error() == QNetworkReply::NoError) {
+        if (m_concurrentRequests < m_maxConcurrentRequests)
+            ++m_concurrentRequests;
+
+        // last request of the rate limit window
+        if (reply->rawHeader("X-Rate-Limit-Remaining").trimmed() == "0") {
+            int wait = rateLimitWait(reply);
+
+            if (wait > 0)
+                pauseChunks(wait);
+        }
+
+        // chunk stays running until it's converted, see chunkParsed()
+        if (isJsonParsingEnabled()) {
+            convertReply(reply);
+            reply->deleteLater();
+            return;
+        }
+
+        m_runningChunks.remove(chunkId.toInt());
+    } else {
+        Chunk chunk = m_runningChunks.take(chunkId.toInt());
+
+        // 404 means none of the users in the chunk exists, not a failure
+        if (httpStatus != NotFound) {
+            setLastErrorMessage("User lookup chunk failed: " + reply->errorString());
+
+            m_failedUserIds += chunk.userids;
+            m_failedScreenNames += chunk.screenNames;
+        }
+    }
+
+    reply->deleteLater();
+
+    finishChunk();
+}
+
+/**
+ *  Collects users of converted fetchAll() chunk
+ */
+void QTweetUserLookup::chunkParsed(int chunkId, const QList<QTweetUser> &users)
+{
+    // aborted by abortAll() while it was converted
+    if (!m_runningChunks.remove(chunkId))
+        return;
+
+    appendUsers(users);
+    finishChunk();
+}
+
+/**
+ *  Sends chunks waiting for rate limit reset
+ */
+void QTweetUserLookup::timerEvent(QTimerEvent *e)
+{
+    if (e->timerId() != m_resumeTimer) {
+        QTweetNetBase::timerEvent(e);
+        return;
+    }
+
+    killTimer(m_resumeTimer);
+    m_resumeTimer = 0;
+
+    startChunks();
+}
+
+/**
+ *  Fails fetchAll() chunk which missed the deadline, others are handled by QTweetNetBase
+ */
+void QTweetUserLookup::requestTimedOut(const QNetworkRequest &request)
+{
+    QVariant chunkId = request.attribute(ChunkAttribute);
+
+    if (!chunkId.isValid()) {
+        QTweetNetBase::requestTimedOut(request);
+        return;
+    }
+
+    if (!m_runningChunks.contains(chunkId.toInt()))
+        return;
+
+    setLastErrorMessage("User lookup chunk failed: deadline exceeded");
+
+    m_chunkReplies.remove(chunkId.toInt());
+    Chunk chunk = m_runningChunks.take(chunkId.toInt());
+
+    m_failedUserIds += chunk.userids;
+    m_failedScreenNames += chunk.screenNames;
+
+    finishChunk();
+}
+
+/**
+ *  Keeps reply of fetchAll() chunk, so abortAll() can abort it
+ *  @remarks Retried chunk is sent with new reply
+ */
+void QTweetUserLookup::requestSent(QNetworkReply *reply)
+{
+    QVariant chunkId = reply->request().attribute(ChunkAttribute);
+
+    if (!chunkId.isValid())
+        return;
+
+    if (m_runningChunks.contains(chunkId.toInt())) {
+        m_chunkReplies.insert(chunkId.toInt(), reply);
+        return;
+    }
+
+    // chunk was waiting in request scheduler or for retry when abortAll() was called,
+    // reply() drops it
+    reply->abort();
+}
+
+QNetworkRequest QTweetUserLookup::lookupRequest(const QList<qint64> &useridList, const QStringList &screenNameList) const
+{
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "users/lookup.json");
 
     if (!useridList.isEmpty()) {
         QString idString;
@@ -78,15 +434,73 @@ void QTweetUserLookup::fetch(const QList<qint64> &useridList,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    return req;
 }
 
-void QTweetUserLookup::parseJsonFinished(const QJsonDocument &jsonDoc)
+void QTweetUserLookup::startChunks()
 {
-    if (jsonDoc.isArray()) {
-        QList<QTweetUser> userInfoList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array());
+    // waiting for rate limit reset
+    if (m_resumeTimer)
+        return;
 
-        emit parsedUserInfoList(userInfoList);
+    while (!m_pendingChunks.isEmpty() && m_runningChunks.size() < m_concurrentRequests) {
+        Chunk chunk = m_pendingChunks.dequeue();
+        int chunkId = m_nextChunkId++;
+
+        QNetworkRequest req = lookupRequest(chunk.userids, chunk.screenNames);
+        req.setAttribute(ChunkAttribute, chunkId);
+
+        // before start, request scheduler can send it right away
+        m_runningChunks.insert(chunkId, chunk);
+        startPlainGet(req);
     }
 }
+
+void QTweetUserLookup::pauseChunks(int msecs)
+{
+    // latest reset time from the server wins
+    if (m_resumeTimer)
+        killTimer(m_resumeTimer);
+
+    m_resumeTimer = startTimer(msecs);
+}
+
+void QTweetUserLookup::finishChunk()
+{
+    ++m_doneChunks;
+    emit fetchAllProgress(m_doneChunks, m_totalChunks);
+
+    startChunks();
+
+    if (!isFetchingAll()) {
+        flushUsers();
+        emit fetchAllFinished(m_userCount, m_failedUserIds.size() + m_failedScreenNames.size());
+    }
+}
+
+void QTweetUserLookup::appendUsers(const QList<QTweetUser> &users)
+{
+    foreach (const QTweetUser& user, users) {
+        if (m_emittedUserIds.contains(user.id()))
+            continue;
+
+        m_emittedUserIds.insert(user.id());
+        m_users.append(user);
+
+        if (m_users.size() >= m_batchSize)
+            flushUsers();
+    }
+}
+
+void QTweetUserLookup::flushUsers()
+{
+    if (m_users.isEmpty())
+        return;
+
+    m_userCount += m_users.size();
+
+    QList<QTweetUser> users;
+    users.swap(m_users);
+
+    emit parsedUserInfoList(users);
+}
@@ -19,28 +19,106 @@
 #define QTWEETUSERLOOKUP_H
 
 #include <QStringList>
+#include <QQueue>
+#include <QHash>
+#include <QSet>
+#include <QPointer>
 #include "qtweetnetbase.h"
 
 class QTweetUser;
+class QNetworkReply;
+class QNetworkRequest;
 
 /**
  *   Class for fetching up to 100 users and theirs most recent status
+ *
+ *   fetchAll() looks up any number of users, in chunks of 100 run concurrently
  */
 class QTWEETLIBSHARED_EXPORT QTweetUserLookup : public QTweetNetBase
 {
     Q_OBJECT
 public:
+    /** Maximum number of users in one request */
+    enum { ChunkSize = 100 };
+
     QTweetUserLookup(QObject *parent = 0);
     QTweetUserLookup(OAuthTwitter *oauthTwitter, QObject *parent = 0);
     void fetch(const QList<qint64>& useridList = QList<qint64>(),
                const QStringList& screenNameList = QStringList());
 
+    void fetchAll(const QList<qint64>& useridList,
+                  const QStringList& screenNameList = QStringList());
+    void abortAll();
+    bool isFetchingAll() const;
+
+    void setMaxConcurrentRequests(int count);
+    int maxConcurrentRequests() const;
+    void setBatchSize(int size);
+    int batchSize() const;
+
+    QList<qint64> failedUserIds() const;
+    QStringList failedScreenNames() const;
+
 signals:
-    /** Emits list of users */
+    /** Emits list of users, in batches of batchSize() users when fetching all */
     void parsedUserInfoList(const QList<QTweetUser>& userInfoList);
 
+    /**
+     *  Emitted when chunk of fetchAll() is done
+     *  @param done number of done chunks
+     *  @param total number of chunks
+     */
+    void fetchAllProgress(int done, int total);
+
+    /**
+     *  Emitted when all chunks of fetchAll() are done, after the last batch
+     *  @param userCount number of users emitted
+     *  @param failedCount number of ids and screen names of failed chunks,
+     *                     see failedUserIds() and failedScreenNames()
+     */
+    void fetchAllFinished(int userCount, int failedCount);
+
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
+    void reply();
+
+protected:
+    void timerEvent(QTimerEvent *e);
+    void requestSent(QNetworkReply *reply);
+    void requestTimedOut(const QNetworkRequest& request);
+
+private:
+    struct Chunk {
+        Chunk() : rateLimitRetries(0) {}
+
+        QList<qint64> userids;
+        QStringList screenNames;
+        int rateLimitRetries;
+    };
+
+    QNetworkRequest lookupRequest(const QList<qint64>& useridList, const QStringList& screenNameList) const;
+    void startChunks();
+    void pauseChunks(int msecs);
+    void chunkParsed(int chunkId, const QList<QTweetUser>& users);
+    void finishChunk();
+    void appendUsers(const QList<QTweetUser>& users);
+    void flushUsers();
+
+    QQueue<Chunk> m_pendingChunks;
+    QHash<int, Chunk> m_runningChunks;
+    QHash<int, QPointer<QNetworkReply> > m_chunkReplies;
+    QList<QTweetUser> m_users;
+    QSet<qint64> m_emittedUserIds;
+    QList<qint64> m_failedUserIds;
+    QStringList m_failedScreenNames;
+    int m_maxConcurrentRequests;
+    int m_concurrentRequests;
+    int m_resumeTimer;
+    int m_batchSize;
+    int m_doneChunks;
+    int m_totalChunks;
+    int m_userCount;
+    int m_nextChunkId;
 };
 
 #endif // QTWEETUSERLOOKUP_H
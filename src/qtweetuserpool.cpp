@@ -0,0 +1,321 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#include <QMutexLocker>
+#include <QVector>
+#include <QtAlgorithms>
+#include "qtweetuserpool.h"
+
+/**
+ *  Constructor
+ */
+QTweetUserPool::QTweetUserPool() :
+    m_maxAge(0), m_maxCount(DefaultMaxCount), m_tick(0), m_hits(0), m_misses(0)
+{
+    m_clock.start();
+}
+
+/**
+ *  Destructor
+ */
+QTweetUserPool::~QTweetUserPool()
+{
+}
+
+/**
+ *  Sets how long pooled user is handed out before it is converted again
+ *  @param msecs lifetime in milliseconds, 0 (default) pooled users never expire
+ *  @remarks Use clear() to limit pool to one conversion pass
+ */
+void QTweetUserPool::setMaxAge(int msecs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxAge = msecs;
+}
+
+/**
+ *  Gets lifetime of pooled users in milliseconds
+ */
+int QTweetUserPool::maxAge() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxAge;
+}
+
+/**
+ *  Sets maximum number of pooled users, 100000 by default, 0 means no limit
+ *  @remarks When it's exceeded, least recently used eighth of the users is evicted
+ */
+void QTweetUserPool::setMaxCount(int count)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxCount = qMax(0, count);
+
+    trim();
+}
+
+/**
+ *  Gets maximum number of pooled users
+ */
+int QTweetUserPool::maxCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxCount;
+}
+
+/**
+ *  Finds pooled user which is not older than payload
+ *  @param userid user id
+ *  @param version version of the payload (id of the status or direct message carrying the user),
+ *                 0 if unknown
+ *  @param user filled with pooled user when found
+ *  @return true if pooled user can be used instead of converting the payload
+ */
+bool QTweetUserPool::find(qint64 userid, qint64 version, QTweetUser *user)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QHash<qint64, Entry>::iterator it = m_users.find(userid);
+
+    if (it != m_users.end() && isExpired(it.value())) {
+        m_users.erase(it);
+        it = m_users.end();
+    }
+
+    if (it == m_users.end() || it.value().version < version) {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+    it.value().used = ++m_tick;
+
+    if (user)
+        *user = it.value().user;
+
+    return true;
+}
+
+/**
+ *  Inserts or refreshes pooled user
+ *  @param user converted user
+ *  @param version version of the payload
+ *  @return pooled user, older or same payload doesn't replace pooled user,
+ *          so threads which missed find() for the same payload get the same user
+ */
+QTweetUser QTweetUserPool::insert(const QTweetUser &user, qint64 version)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QHash<qint64, Entry>::iterator it = m_users.find(user.id());
+
+    if (it != m_users.end() && !isExpired(it.value()) && it.value().version >= version) {
+        it.value().used = ++m_tick;
+        return it.value().user;
+    }
+
+    Entry entry;
+    entry.user = user;
+    entry.version = version;
+    entry.timestamp = m_clock.elapsed();
+    entry.used = ++m_tick;
+
+    m_users.insert(user.id(), entry);
+    trim();
+
+    return user;
+}
+
+/**
+ *  Replaces pooled user with user from authoritative payload (users/show, users/lookup...)
+ *  @param user converted user
+ *  @param version version of the payload, 0 if unknown
+ *  @return user
+ *  @remarks Pooled user keeps its version when it's newer, so older statuses
+ *           are still served the replaced user
+ */
+QTweetUser QTweetUserPool::replace(const QTweetUser &user, qint64 version)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QHash<qint64, Entry>::const_iterator it = m_users.constFind(user.id());
+
+    Entry entry;
+    entry.user = user;
+    entry.version = version;
+    entry.timestamp = m_clock.elapsed();
+    entry.used = ++m_tick;
+
+    if (it != m_users.constEnd() && !isExpired(it.value()))
+        entry.version = qMax(version, it.value().version);
+
+    m_users.insert(user.id(), entry);
+    trim();
+
+    return user;
+}
+
+/**
+ *  Gets pooled user with the same id as user, user itself if there isn't one.
+ *  Doesn't count as hit or miss.
+ *  @remarks Used after parallel conversion, when threads inserted different
+ *           versions of the same user
+ */
+QTweetUser QTweetUserPool::pooled(const QTweetUser &user) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QHash<qint64, Entry>::const_iterator it = m_users.constFind(user.id());
+
+    if (it == m_users.constEnd() || isExpired(it.value()))
+        return user;
+
+    return it.value().user;
+}
+
+/**
+ *  Gets pooled user, default constructed if there isn't one
+ */
+QTweetUser QTweetUserPool::user(qint64 userid) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_users.value(userid).user;
+}
+
+/**
+ *  Checks if user is pooled
+ */
+bool QTweetUserPool::contains(qint64 userid) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_users.contains(userid);
+}
+
+/**
+ *  Removes user from the pool
+ */
+void QTweetUserPool::remove(qint64 userid)
+{
+    QMutexLocker locker(&m_mutex);
+    m_users.remove(userid);
+}
+
+/**
+ *  Removes users older than maxAge
+ *  @remarks Expired users are also dropped when they're looked up or when the pool is full
+ */
+void QTweetUserPool::expire()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_maxAge)
+        return;
+
+    QHash<qint64, Entry>::iterator it = m_users.begin();
+
+    while (it != m_users.end()) {
+        if (isExpired(it.value()))
+            it = m_users.erase(it);
+        else
+            ++it;
+    }
+}
+
+/**
+ *  Removes all users from the pool and resets statistics
+ */
+void QTweetUserPool::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_users.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+/**
+ *  Gets number of pooled users
+ */
+int QTweetUserPool::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_users.count();
+}
+
+/**
+ *  Gets number of conversions served by the pool
+ */
+int QTweetUserPool::hits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+/**
+ *  Gets number of conversions not served by the pool
+ */
+int QTweetUserPool::misses() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_misses;
+}
+
+bool QTweetUserPool::isExpired(const Entry &entry) const
+{
+    return m_maxAge && m_clock.elapsed() - entry.timestamp > m_maxAge;
+}
+
+// called under the lock
+void QTweetUserPool::trim()
+{
+    if (!m_maxCount || m_users.count() <= m_maxCount)
+        return;
+
+    // in batches, so the pool isn't scanned on every insert
+    int keep = m_maxCount - m_maxCount / 8;
+
+    QVector<qint64> used;
+    used.reserve(m_users.count());
+
+    QHash<qint64, Entry>::iterator it = m_users.begin();
+
+    while (it != m_users.end()) {
+        if (isExpired(it.value())) {
+            it = m_users.erase(it);
+        } else {
+            used.append(it.value().used);
+            ++it;
+        }
+    }
+
+    int evict = used.size() - keep;
+
+    if (evict <= 0)
+        return;
+
+    // ticks are unique, users used at or before the threshold are evicted
+    qSort(used);
+    qint64 threshold = used.at(evict - 1);
+
+    it = m_users.begin();
+
+    while (it != m_users.end()) {
+        if (it.value().used <= threshold)
+            it = m_users.erase(it);
+        else
+            ++it;
+    }
+}
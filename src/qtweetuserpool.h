@@ -0,0 +1,88 @@
+/* Copyright 2010 Antonie Jovanoski
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Contact e-mail: Antonie Jovanoski <minimoog77_at_gmail.com>
+ */
+
+#ifndef QTWEETUSERPOOL_H
+#define QTWEETUSERPOOL_H
+
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include "qtweetuser.h"
+#include "qtweetlib_global.h"
+
+/**
+ *  Pool of converted users keyed by user id
+ *
+ *  Converters hand out the pooled QTweetUser when the same user occurs again
+ *  so users in one or more conversion passes are shared (and pointer equal).
+ *  Pooled user is refreshed only when payload is newer than pooled one,
+ *  or when it's a top level user payload (users/show, users/lookup...).
+ *  Bounded by maxCount(), least recently used users are evicted first.
+ *  Thread safe.
+ */
+class QTWEETLIBSHARED_EXPORT QTweetUserPool
+{
+public:
+    QTweetUserPool();
+    ~QTweetUserPool();
+
+    /** Default maximum number of pooled users */
+    enum { DefaultMaxCount = 100000 };
+
+    void setMaxAge(int msecs);
+    int maxAge() const;
+    void setMaxCount(int count);
+    int maxCount() const;
+
+    bool find(qint64 userid, qint64 version, QTweetUser *user);
+    QTweetUser insert(const QTweetUser& user, qint64 version);
+    QTweetUser replace(const QTweetUser& user, qint64 version);
+    QTweetUser pooled(const QTweetUser& user) const;
+    QTweetUser user(qint64 userid) const;
+    bool contains(qint64 userid) const;
+    void remove(qint64 userid);
+    void expire();
+    void clear();
+
+    int count() const;
+    int hits() const;
+    int misses() const;
+
+private:
+    Q_DISABLE_COPY(QTweetUserPool)
+
+    struct Entry {
+        QTweetUser user;
+        qint64 version;
+        qint64 timestamp;
+        qint64 used;    // tick of the last lookup or insert
+    };
+
+    bool isExpired(const Entry& entry) const;
+    void trim();
+
+    mutable QMutex m_mutex;
+    QHash<qint64, Entry> m_users;
+    QElapsedTimer m_clock;
+    int m_maxAge;
+    int m_maxCount;
+    qint64 m_tick;
+    int m_hits;
+    int m_misses;
+};
+
+#endif // QTWEETUSERPOOL_H
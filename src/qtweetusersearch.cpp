@@ -51,7 +51,7 @@ void QTweetUserSearch::search(const QString &query,
         return;
     }
 
-    QUrl url("http://api.twitter.com/1/users/search.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "users/search.json");
 
     url.addQueryItem("q", query);
 
@@ -69,14 +69,13 @@ void QTweetUserSearch::search(const QString &query,
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(url, OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetUserSearch::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetUser> userInfoList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array());
+        QList<QTweetUser> userInfoList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedUserInfoList(userInfoList);
     }
@@ -41,7 +41,7 @@ QTweetUserShow::QTweetUserShow(OAuthTwitter *oauthTwitter, QObject *parent) :
  */
 void QTweetUserShow::fetch(qint64 userid, bool includeEntities)
 {
-    QUrl url("http://api.twitter.com/1/users/show.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "users/show.json");
 
     url.addQueryItem("user_id", QString::number(userid));
 
@@ -55,8 +55,7 @@ void QTweetUserShow::fetch(qint64 userid, bool includeEntities)
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 /**
@@ -66,7 +65,7 @@ void QTweetUserShow::fetch(qint64 userid, bool includeEntities)
  */
 void QTweetUserShow::fetch(const QString &screenName, bool includeEntities)
 {
-    QUrl url("http://api.twitter.com/1/users/show.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "users/show.json");
 
     url.addQueryItem("screen_name", screenName);
 
@@ -80,14 +79,13 @@ void QTweetUserShow::fetch(const QString &screenName, bool includeEntities)
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetUserShow::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isObject()) {
-        QTweetUser userInfo = QTweetConvert::jsonObjectToUser(jsonDoc.object());
+        QTweetUser userInfo = QTweetConvert::jsonObjectToUser(jsonDoc.object(), userPool(), convertOptions());
 
         emit parsedUserInfo(userInfo);
     }
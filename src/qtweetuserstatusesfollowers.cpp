@@ -46,7 +46,7 @@ void QTweetUserStatusesFollowers::fetch(qint64 userid,
                                       const QString &cursor,
                                       bool includeEntities)
 {
-    QUrl url("http://api.twitter.com/1/statuses/followers.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "statuses/followers.json");
 
     if (userid != 0)
         url.addQueryItem("user_id", QString::number(userid));
@@ -66,8 +66,7 @@ void QTweetUserStatusesFollowers::fetch(qint64 userid,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 /**
@@ -81,7 +80,7 @@ void QTweetUserStatusesFollowers::fetch(const QString &screenName,
                                         const QString &cursor,
                                         bool includeEntities)
 {
-    QUrl url("http://api.twitter.com/1/statuses/followers.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi1, "statuses/followers.json");
 
     if (!screenName.isEmpty())
         url.addQueryItem("screen_name", screenName);
@@ -101,8 +100,7 @@ void QTweetUserStatusesFollowers::fetch(const QString &screenName,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetUserStatusesFollowers::parseJsonFinished(const QJsonDocument &jsonDoc)
@@ -113,16 +111,52 @@ void QTweetUserStatusesFollowers::parseJsonFinished(const QJsonDocument &jsonDoc
 
             QJsonArray userListJsonArray = respJsonObject["users"].toArray();
 
-            QList<QTweetUser> userList = QTweetConvert::jsonArrayToUserInfoList(userListJsonArray);
+            QList<QTweetUser> userList = QTweetConvert::jsonArrayToUserInfoList(userListJsonArray, userPool(), convertOptions());
 
             QString nextCursor = respJsonObject["next_cursor_str"].toString();
             QString prevCursor = respJsonObject["previous_cursor_str"].toString();
 
             emit parsedFollowersList(userList, nextCursor, prevCursor);
         } else {
-            QList<QTweetUser> userList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array());
+            QList<QTweetUser> userList = QTweetConvert::jsonArrayToUserInfoList(jsonDoc.array(), userPool(), convertOptions());
 
             emit parsedFollowersList(userList);
         }
     }
 }
+
+bool QTweetUserStatusesFollowers::isProgressiveParsingSupported() const
+{
+    return true;
+}
+
+QString QTweetUserStatusesFollowers::progressiveArrayKey() const
+{
+    return m_usesCursoring ? QString("users") : QString();
+}
+
+QTweetUserStatusesFollowers::JsonElementType QTweetUserStatusesFollowers::jsonElementType() const
+{
+    return UserElements;
+}
+
+void QTweetUserStatusesFollowers::parseJsonElements(const QJsonArray &elements)
+{
+    appendJsonUsers(elements);
+}
+
+void QTweetUserStatusesFollowers::endJsonElements(const QJsonDocument &skeleton)
+{
+    QList<QTweetUser> users = takeJsonUsers();
+
+    if (m_usesCursoring) {
+        QJsonObject respJsonObject = skeleton.object();
+
+        QString nextCursor = respJsonObject["next_cursor_str"].toString();
+        QString prevCursor = respJsonObject["previous_cursor_str"].toString();
+
+        emit parsedFollowersList(users, nextCursor, prevCursor);
+    } else {
+        emit parsedFollowersList(users);
+    }
+}
@@ -19,6 +19,7 @@
 #define QTWEETUSERSTATUSESFOLLOWERS_H
 
 #include "qtweetnetbase.h"
+#include "qtweetuser.h"
 
 /**
  *  Fetches the authenticating user's followers, each with current status inline.
@@ -52,6 +53,13 @@ signals:
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
 
+protected:
+    bool isProgressiveParsingSupported() const;
+    QString progressiveArrayKey() const;
+    JsonElementType jsonElementType() const;
+    void parseJsonElements(const QJsonArray &elements);
+    void endJsonElements(const QJsonDocument &skeleton);
+
 private:
     bool m_usesCursoring;
 };
@@ -29,8 +29,7 @@
 #include "qtweetdmstatus.h"
 #include "qtweetuser.h"
 #include "qtweetconvert.h"
-
-#define TWITTER_USERSTREAM_URL "https://userstream.twitter.com/2/user.json"
+#include "qtweetgzipinflater_p.h"
 
 // ### TODO User Agent or X-User-Agent
 
@@ -38,10 +37,13 @@
  *  Constructor
  */
 QTweetUserStream::QTweetUserStream(QObject *parent) :
-    QObject(parent), m_oauthTwitter(0), m_reply(0),
+    QObject(parent), m_oauthTwitter(0), m_userPool(0), m_convertOptions(QTweetConvert::NoOptions), m_reply(0),
     m_backofftimer(new QTimer(this)),
     m_timeoutTimer(new QTimer(this)),
-    m_streamTryingReconnect(false)
+    m_streamTryingReconnect(false),
+    m_compression(false),
+    m_compressedReply(false),
+    m_inflater(new QTweetGzipInflater)
 {
     m_backofftimer->setInterval(20000);
     m_backofftimer->setSingleShot(true);
@@ -56,6 +58,14 @@ QTweetUserStream::QTweetUserStream(QObject *parent) :
 #endif
 }
 
+/**
+ *  Destructor
+ */
+QTweetUserStream::~QTweetUserStream()
+{
+    delete m_inflater;
+}
+
 /**
  *  Sets oauth twitter object
  */
@@ -72,6 +82,91 @@ OAuthTwitter* QTweetUserStream::oauthTwitter() const
     return m_oauthTwitter;
 }
 
+/**
+ *  Sets user pool used when converting stream elements
+ *  @param userPool user pool, not owned. 0 (default) disables pooling
+ */
+void QTweetUserStream::setUserPool(QTweetUserPool *userPool)
+{
+    m_userPool = userPool;
+}
+
+/**
+ *  Gets user pool used when converting stream elements
+ */
+QTweetUserPool* QTweetUserStream::userPool() const
+{
+    return m_userPool;
+}
+
+/**
+ *  Sets parts of stream elements skipped when converting
+ *  @param options conversion options, NoOptions (default) converts everything
+ */
+void QTweetUserStream::setConvertOptions(QTweetConvert::Options options)
+{
+    m_convertOptions = options;
+}
+
+/**
+ *  Gets parts of stream elements skipped when converting
+ */
+QTweetConvert::Options QTweetUserStream::convertOptions() const
+{
+    return m_convertOptions;
+}
+
+/**
+ *  Enables gzip compressed stream, disabled by default
+ *  @remarks Takes effect on next (re)connect. Saves bandwidth at the cost of inflating,
+ *           see compressionRatio() and inflateTime(). Stream is uncompressed when
+ *           inflater can't be initialized
+ */
+void QTweetUserStream::setCompressionEnabled(bool enable)
+{
+    m_compression = enable;
+}
+
+bool QTweetUserStream::isCompressionEnabled() const
+{
+    return m_compression;
+}
+
+/**
+ *  Gets number of compressed bytes received
+ */
+qint64 QTweetUserStream::compressedBytes() const
+{
+    return m_inflater->compressedBytes();
+}
+
+/**
+ *  Gets number of bytes inflated from compressed bytes
+ */
+qint64 QTweetUserStream::inflatedBytes() const
+{
+    return m_inflater->inflatedBytes();
+}
+
+/**
+ *  Gets inflated to compressed size ratio, 0 if nothing compressed is received
+ */
+double QTweetUserStream::compressionRatio() const
+{
+    if (!m_inflater->compressedBytes())
+        return 0;
+
+    return double(m_inflater->inflatedBytes()) / m_inflater->compressedBytes();
+}
+
+/**
+ *  Gets time spent inflating in microseconds
+ */
+qint64 QTweetUserStream::inflateTime() const
+{
+    return m_inflater->inflateNSecs() / 1000;
+}
+
 /**
  *   Starts fetching user stream
  */
@@ -84,12 +179,23 @@ void QTweetUserStream::startFetching()
     }
 
     QNetworkRequest req;
-    req.setUrl(QUrl(TWITTER_USERSTREAM_URL));
+    req.setUrl(oauthTwitter()->apiUrl(OAuthTwitter::UserStreamApi, "user.json"));
 
     QByteArray oauthHeader = oauthTwitter()->generateAuthorizationHeader(req.url(), OAuth::GET);
     req.setRawHeader(AUTH_HEADER, oauthHeader);
 
+    m_inflater->reset();
+
+    // set explicitly, so network access manager leaves decompression to us,
+    // uncompressed stream when zlib couldn't be initialized
+    if (m_compression && m_inflater->isValid())
+        req.setRawHeader("Accept-Encoding", "gzip");
+
+    m_compressedReply = false;
+    m_cachedResponse.clear();
+
     m_reply = m_oauthTwitter->networkAccessManager()->get(req);
+    connect(m_reply, SIGNAL(metaDataChanged()), this, SLOT(replyMetaDataChanged()));
     connect(m_reply, SIGNAL(finished()), this, SLOT(replyFinished()));
     connect(m_reply, SIGNAL(readyRead()), this, SLOT(replyReadyRead()));
     connect(m_reply, SIGNAL(sslErrors(QList<QSslError>)), this, SLOT(sslErrors(QList<QSslError>)));
@@ -153,9 +259,25 @@ void QTweetUserStream::replyFinished()
     }
 }
 
+void QTweetUserStream::replyMetaDataChanged()
+{
+    m_compressedReply = m_reply->rawHeader("Content-Encoding").toLower() == "gzip";
+}
+
 void QTweetUserStream::replyReadyRead()
 {
-    QByteArray response = m_reply->readAll();
+    QByteArray response;
+
+    if (m_compressedReply) {
+        if (!m_inflater->inflate(m_reply->readAll(), &response)) {
+            qDebug() << "Corrupted compressed stream, reconnect";
+
+            m_reply->abort();
+            return;
+        }
+    } else {
+        response = m_reply->readAll();
+    }
 
 #ifdef STREAM_LOGGER
     m_streamLog.write(response);
@@ -216,7 +338,7 @@ void QTweetUserStream::parseStream(const QByteArray& data)
         else if (jsonDoc.object().contains("direct_message"))
             parseDirectMessage(jsonDoc.object());
         else if (jsonDoc.object().contains("text")) {
-            QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object());
+            QTweetStatus status = QTweetConvert::jsonObjectToStatus(jsonDoc.object(), m_userPool, m_convertOptions);
             emit statusesStream(status);
         } else if (jsonDoc.object().contains("delete")) {
             parseDeleteStatus(jsonDoc.object());
@@ -245,7 +367,7 @@ void QTweetUserStream::parseDirectMessage(const QJsonObject& json)
 {
     QJsonObject directMessageJson = json["direct_message"].toObject();
 
-    QTweetDMStatus directMessage = QTweetConvert::jsonObjectToDirectMessage(directMessageJson);
+    QTweetDMStatus directMessage = QTweetConvert::jsonObjectToDirectMessage(directMessageJson, m_userPool, m_convertOptions);
 
     emit directMessageStream(directMessage);
 }
@@ -21,6 +21,7 @@
 #include <QObject>
 #include <QNetworkReply>
 #include "qtweetlib_global.h"
+#include "qtweetconvert.h"
 
 #ifdef STREAM_LOGGER
     #include <QFile>
@@ -31,8 +32,10 @@ class QNetworkReply;
 class OAuthTwitter;
 class QAuthenticator;
 class QTimer;
+class QTweetGzipInflater;
 class QTweetStatus;
 class QTweetDMStatus;
+class QTweetUserPool;
 class QJsonObject;
 
 /**
@@ -43,8 +46,19 @@ class QTWEETLIBSHARED_EXPORT QTweetUserStream : public QObject
     Q_OBJECT
 public:
     QTweetUserStream(QObject *parent = 0);
+    ~QTweetUserStream();
     void setOAuthTwitter(OAuthTwitter* oauthTwitter);
     OAuthTwitter* oauthTwitter() const;
+    void setUserPool(QTweetUserPool *userPool);
+    QTweetUserPool* userPool() const;
+    void setConvertOptions(QTweetConvert::Options options);
+    QTweetConvert::Options convertOptions() const;
+    void setCompressionEnabled(bool enable);
+    bool isCompressionEnabled() const;
+    qint64 compressedBytes() const;
+    qint64 inflatedBytes() const;
+    double compressionRatio() const;
+    qint64 inflateTime() const;
 
 signals:
     /**
@@ -86,6 +100,7 @@ public slots:
 
 private slots:
     void replyFinished();
+    void replyMetaDataChanged();
     void replyReadyRead();
     void replyTimeout();
     void sslErrors(const QList<QSslError>& errors);
@@ -98,10 +113,15 @@ private:
 
     QByteArray m_cachedResponse;
     OAuthTwitter *m_oauthTwitter;
+    QTweetUserPool *m_userPool;
+    QTweetConvert::Options m_convertOptions;
     QNetworkReply *m_reply;
     QTimer *m_backofftimer;
     QTimer *m_timeoutTimer;
     bool m_streamTryingReconnect;
+    bool m_compression;
+    bool m_compressedReply;
+    QTweetGzipInflater *m_inflater;
 
 #ifdef STREAM_LOGGER
     QFile m_streamLog;
@@ -20,6 +20,7 @@
 #include <QNetworkReply>
 #include "qtweetusertimeline.h"
 #include "qtweetstatus.h"
+#include "qtweetstatusbatch.h"
 #include "qtweetconvert.h"
 #include "json/qjsondocument.h"
 #include "json/qjsonarray.h"
@@ -80,7 +81,7 @@ void QTweetUserTimeline::fetch(qint64 userid,
                                bool excludeReplies,
                                bool contributorDetails)
 {
-    QUrl url("https://api.twitter.com/1.1/statuses/user_timeline.json");
+    QUrl url = oauthTwitter()->apiUrl(OAuthTwitter::RestApi11, "statuses/user_timeline.json");
 
     if (userid != 0)
         url.addQueryItem("user_id", QString::number(userid));
@@ -122,8 +123,7 @@ void QTweetUserTimeline::fetch(qint64 userid,
         req.setRawHeader(AUTH_HEADER, oauthHeader);
     }
 
-    QNetworkReply *reply = oauthTwitter()->networkAccessManager()->get(req);
-    connect(reply, SIGNAL(finished()), this, SLOT(reply()));
+    startGet(req);
 }
 
 void QTweetUserTimeline::get()
@@ -144,8 +144,40 @@ void QTweetUserTimeline::get()
 void QTweetUserTimeline::parseJsonFinished(const QJsonDocument &jsonDoc)
 {
     if (jsonDoc.isArray()) {
-        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array());
+        if (isStatusBatchEnabled()) {
+            emit parsedStatusBatch(QTweetConvert::jsonArrayToStatusBatch(jsonDoc.array(), userPool(), convertOptions()));
+            return;
+        }
+
+        QList<QTweetStatus> statuses = QTweetConvert::jsonArrayToStatusList(jsonDoc.array(), userPool(), convertOptions());
 
         emit parsedStatuses(statuses);
     }
 }
+
+bool QTweetUserTimeline::isProgressiveParsingSupported() const
+{
+    return !isStatusBatchEnabled();
+}
+
+QString QTweetUserTimeline::progressiveArrayKey() const
+{
+    return QString();
+}
+
+QTweetUserTimeline::JsonElementType QTweetUserTimeline::jsonElementType() const
+{
+    return StatusElements;
+}
+
+void QTweetUserTimeline::parseJsonElements(const QJsonArray &elements)
+{
+    appendJsonStatuses(elements);
+}
+
+void QTweetUserTimeline::endJsonElements(const QJsonDocument &skeleton)
+{
+    Q_UNUSED(skeleton)
+
+    emit parsedStatuses(takeJsonStatuses());
+}
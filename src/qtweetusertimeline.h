@@ -19,8 +19,7 @@
 #define QTWEETUSERTIMELINE_H
 
 #include "qtweetnetbase.h"
-
-class QTweetStatus;
+#include "qtweetstatus.h"
 
 /**
  *   Class for fetching tweets posted by user or other users
@@ -96,6 +95,13 @@ signals:
 protected slots:
     void parseJsonFinished(const QJsonDocument &jsonDoc);
 
+protected:
+    bool isProgressiveParsingSupported() const;
+    QString progressiveArrayKey() const;
+    JsonElementType jsonElementType() const;
+    void parseJsonElements(const QJsonArray &elements);
+    void endJsonElements(const QJsonDocument &skeleton);
+
 private:
     // ### TODO: Use pimpl
     qint64 m_userid;
@@ -6,6 +6,7 @@ TARGET = qtweetlib
 DESTDIR = ../lib
 CONFIG += create_prl
 INCLUDEPATH += ..
+LIBS += -lz
 
 windows: {
 	DEFINES += QTWEETLIB_MAKEDLL
@@ -84,7 +85,28 @@ HEADERS += \
     json/qjson_p.h \
     qtweetentitymedia.h \
     qtweetstatusupdatewithmedia.h \
-    qtweetdirectmessagesshow.h
+    qtweetdirectmessagesshow.h \
+    qtweetuserpool.h \
+    qtweetbinary.h \
+    qtweetstatusbatch.h \
+    qtweetstatusbatch_p.h \
+    qtweetstringtable.h \
+    qtweetplacegraph.h \
+    qtweetsnowflake.h \
+    qtweettextrenderer.h \
+    qtweetrequestcoalescer.h \
+    qtweetresponsecache.h \
+    qtweetgzipinflater_p.h \
+    qtweetfuture.h \
+    qtweetdatastatistics.h \
+    qtweetdatastatistics_p.h \
+    qtweetclient.h \
+    qtweetjsonarraystreamer_p.h \
+    qtweetshareddocument_p.h \
+    qtweetrequestscheduler.h \
+    qtweetstatus_p.h \
+    qtweetuser_p.h \
+    qtweetdmstatus_p.h
 
 SOURCES += \
     oauth.cpp \
@@ -157,7 +179,24 @@ SOURCES += \
     json/qjson.cpp \
     qtweetentitymedia.cpp \
     qtweetstatusupdatewithmedia.cpp \
-    qtweetdirectmessagesshow.cpp
+    qtweetdirectmessagesshow.cpp \
+    qtweetuserpool.cpp \
+    qtweetbinary.cpp \
+    qtweetstatusbatch.cpp \
+    qtweetstringtable.cpp \
+    qtweetplacegraph.cpp \
+    qtweetsnowflake.cpp \
+    qtweettextrenderer.cpp \
+    qtweetrequestcoalescer.cpp \
+    qtweetresponsecache.cpp \
+    qtweetgzipinflater.cpp \
+    qtweetclient.cpp \
+    qtweetjsonarraystreamer.cpp \
+    qtweetrequestscheduler.cpp \
+    qtweetdatastatistics.cpp
+
+# counters of data objects, see QTweetDataStatistics
+data_statistics: DEFINES += QTWEETLIB_DATA_STATISTICS
 
 OTHER_FILES +=
 